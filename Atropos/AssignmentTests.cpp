@@ -75,5 +75,53 @@ namespace Atropos {
 				}
 				Assert::IsTrue(count == 85);
 			}
+
+			TEST_METHOD(Assignment_WordBoundaryIterate) {
+				const size_t num = 300;
+				Assignment assign{ num };
+
+				int expected[]{ 0, 63, 64, 65, 127, 128, 256, 299 };
+				for (int i : expected) {
+					assign.setTrue(i);
+				}
+
+				int idx = 0;
+				for (auto iter = assign.trueBegin(); iter != assign.trueEnd(); ++iter) {
+					Assert::IsTrue(*iter == expected[idx++]);
+				}
+				Assert::IsTrue(idx == 8);
+
+				int falseCount = 0;
+				for (auto iter = assign.falseBegin(); iter != assign.falseEnd(); ++iter) {
+					++falseCount;
+					Assert::IsTrue(*iter < static_cast<int>(num));
+				}
+				Assert::IsTrue(falseCount == num - 8);
+			}
+
+			TEST_METHOD(Assignment_WordCombine) {
+				const size_t num = 150;
+				Assignment lhs{ num };
+				Assignment rhs{ num };
+
+				lhs.setTrue(3);
+				lhs.setTrue(70);
+				lhs.setTrue(149);
+				rhs.setTrue(70);
+				rhs.setTrue(100);
+				Assert::IsTrue(lhs.wordCount() == 3);
+				Assert::IsTrue(lhs.countTrue() == 3);
+
+				Assignment both{ lhs };
+				both &= rhs;
+				Assert::IsTrue(both.countTrue() == 1);
+				Assert::IsTrue(both.getAssignedValue(70));
+
+				Assignment either{ lhs };
+				either |= rhs;
+				Assert::IsTrue(either.countTrue() == 4);
+				Assert::IsTrue(either.getAssignedValue(3) && either.getAssignedValue(100) && either.getAssignedValue(149));
+				Assert::IsTrue(either.getWord(1) == ((Assignment::word_t{ 1 } << 6) | (Assignment::word_t{ 1 } << 36)));
+			}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/BitSet.h"									// for BitSet
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Atropos {
+	TEST_CLASS(BitSetTester) {
+		public:
+			TEST_METHOD(BitSet_Construct) {
+				const size_t num = 130;
+				BitSet clear{ num };
+				BitSet full{ num, true };
+
+				Assert::IsTrue(clear.size() == num);
+				Assert::IsTrue(clear.wordCount() == 3);
+				Assert::IsTrue(clear.none());
+				Assert::IsTrue(full.count() == num);
+				Assert::IsTrue(full.getWord(2) == 3);
+			}
+
+			TEST_METHOD(BitSet_SetAndScan) {
+				const size_t num = 200;
+				BitSet bits{ num };
+
+				bits.set(5);
+				bits.set(64);
+				bits.set(199);
+				bits.set(120);
+				bits.reset(120);
+
+				Assert::IsTrue(bits.test(5) && bits.test(64) && bits.test(199));
+				Assert::IsTrue(!bits.test(120));
+				Assert::IsTrue(bits.count() == 3);
+				Assert::IsTrue(bits.findNext(0) == 5);
+				Assert::IsTrue(bits.findNext(6) == 64);
+				Assert::IsTrue(bits.findNext(65) == 199);
+				Assert::IsTrue(bits.findNext(200) == num);
+			}
+
+			TEST_METHOD(BitSet_Flip) {
+				const size_t num = 70;
+				BitSet bits{ num };
+				bits.set(3);
+				bits.flip();
+
+				Assert::IsTrue(bits.count() == num - 1);
+				Assert::IsTrue(!bits.test(3));
+
+				bits.flip();
+				Assert::IsTrue(bits.count() == 1);
+			}
+
+			TEST_METHOD(BitSet_Combine) {
+				const size_t num = 4;
+				BitSet lhs{ num };
+				BitSet rhs{ num };
+				lhs.set(2);
+				lhs.set(3);
+				rhs.set(1);
+				rhs.set(3);
+
+				BitSet bitsAnd{ lhs };
+				bitsAnd &= rhs;
+				BitSet bitsOr{ lhs };
+				bitsOr |= rhs;
+				BitSet bitsXor{ lhs };
+				bitsXor ^= rhs;
+				BitSet bitsImplies{ lhs };
+				bitsImplies.implies(rhs);
+				BitSet bitsIff{ lhs };
+				bitsIff.iff(rhs);
+				BitSet bitsAndNot{ lhs };
+				bitsAndNot.andNot(rhs);
+
+				Assert::IsTrue(bitsAnd.getWord(0) == 0b1000);
+				Assert::IsTrue(bitsOr.getWord(0) == 0b1110);
+				Assert::IsTrue(bitsXor.getWord(0) == 0b0110);
+				Assert::IsTrue(bitsImplies.getWord(0) == 0b1011);
+				Assert::IsTrue(bitsIff.getWord(0) == 0b1001);
+				Assert::IsTrue(bitsAndNot.getWord(0) == 0b0100);
+				Assert::IsTrue(BitSet::countAnd(lhs, rhs) == 1);
+			}
+
+			TEST_METHOD(BitSet_Equality) {
+				BitSet lhs{ 100 };
+				BitSet rhs{ 100 };
+				lhs.set(99);
+
+				Assert::IsTrue(lhs != rhs);
+				rhs.set(99);
+				Assert::IsTrue(lhs == rhs);
+				Assert::IsTrue(lhs != BitSet{ 99 });
+			}
+	};
+}
\ No newline at end of file
@@ -1,20 +1,23 @@
 #include "stdafx.h"												// for UnitTesting framework
 #include "CppUnitTest.h"										// for UnitTesting framework
 #include "../Eunomia/Assignment.h"								// for Assignment
+#include "../Eunomia/BitSet.h"									// for BitSet
 #include "../Eunomia/Clause.h"									// for Clause
 #include "../Eunomia/Expression.h"								// for Expression
 #include "../Eunomia/Literal.h"									// for Literal
-#include "../Eunomia/Utility.h"									// for Operator_e, constant char symbols
+#include "../Eunomia/Utility.h"									// for Operator_e, VarStatus_e, constant char symbols
 #include <memory>												// for unique_ptr, make_unique
 #include <sstream>												// for stringstream
 #include <string>												// for string
 #include <utility>												// for move
+#include <vector>												// for vector
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using std::string;
 using std::stringstream;
 using std::unique_ptr; using std::make_unique;
 using std::move;
+using std::vector;
 
 
 namespace Atropos {
@@ -1145,6 +1148,148 @@ namespace Atropos {
 				Assert::IsTrue(clauseWhole.evaluate(assign));
 			}
 
+			TEST_METHOD(Clause_DeepNestEvaluateColumns) {
+				unique_ptr<Expression> literalA = make_unique<Literal>(0, str1, true);
+				unique_ptr<Expression> literalB = make_unique<Literal>(1, str2);
+				unique_ptr<Expression> literalC = make_unique<Literal>(2, str3);
+				unique_ptr<Expression> literalD = make_unique<Literal>(3, str4);
+				unique_ptr<Expression> literalE = make_unique<Literal>(4, str5);
+				unique_ptr<Expression> literalF = make_unique<Literal>(5, str6, true);
+
+				unique_ptr<Expression> clauseBorC = make_unique<Clause>(move(literalB), move(literalC), Operator_e::Or);
+				unique_ptr<Expression> clauseDimpE = make_unique<Clause>(move(literalD), move(literalE), Operator_e::Implies);
+				unique_ptr<Expression> clauseXor = make_unique<Clause>(move(clauseBorC), move(clauseDimpE), Operator_e::Xor);
+				unique_ptr<Expression> clauseIff = make_unique<Clause>(move(clauseXor), move(literalF), Operator_e::Iff);
+				Clause clauseWhole{ move(literalA), move(clauseIff), Operator_e::And };
+
+				const size_t numAssigns = 64;									// every assignment of the six variables
+				vector<BitSet> columns(6, BitSet{ numAssigns });
+				vector<Assignment> assigns(numAssigns, Assignment{ 6 });
+				for (size_t a = 0; a < numAssigns; ++a) {
+					for (int v = 0; v < 6; ++v) {
+						if (a & (size_t{ 1 } << v)) {
+							columns[v].set(a);
+							assigns[a].setTrue(v);
+						}
+					}
+				}
+
+				BitSet result = clauseWhole.evaluate(columns);
+				for (size_t a = 0; a < numAssigns; ++a) {
+					Assert::IsTrue(result.test(a) == clauseWhole.evaluate(assigns[a]));
+				}
+
+				clauseWhole.negate();
+				result = clauseWhole.evaluate(columns);
+				for (size_t a = 0; a < numAssigns; ++a) {
+					Assert::IsTrue(result.test(a) == clauseWhole.evaluate(assigns[a]));
+				}
+			}
+
+			TEST_METHOD(Clause_DeepNestCloneAndCollect) {
+				unique_ptr<Expression> literalA = make_unique<Literal>(0, str1, true);
+				unique_ptr<Expression> literalB = make_unique<Literal>(4, str2);
+				unique_ptr<Expression> literalC = make_unique<Literal>(2, str3);
+				unique_ptr<Expression> literalD = make_unique<Literal>(4, str4);
+
+				unique_ptr<Expression> clauseAorB = make_unique<Clause>(move(literalA), move(literalB), Operator_e::Or);
+				unique_ptr<Expression> clauseCxorD = make_unique<Clause>(move(literalC), move(literalD), Operator_e::Xor);
+				Clause clauseWhole{ move(clauseAorB), move(clauseCxorD), Operator_e::Implies, true };
+				unique_ptr<Expression> copy = clauseWhole.clone();
+
+				stringstream original{};
+				stringstream copied{};
+				original << clauseWhole;
+				copied << *copy;
+				Assert::IsTrue(original.str() == copied.str());
+
+				Assignment assign{ 5 };
+				for (int a = 0; a < 32; ++a) {
+					for (int v = 0; v < 5; ++v) {
+						if (a & (1 << v)) {
+							assign.setTrue(v);
+						}
+						else {
+							assign.setFalse(v);
+						}
+					}
+					Assert::IsTrue(copy->evaluate(assign) == clauseWhole.evaluate(assign));
+				}
+
+				copy->negate();
+				Assert::IsTrue(copy->evaluate(assign) != clauseWhole.evaluate(assign));
+
+				vector<int> vars;
+				copy->collectVariables(vars);
+				Assert::IsTrue((vars == vector<int>{ 0, 4, 2, 4 }));
+			}
+
+			TEST_METHOD(Clause_EvaluatePartial) {
+				// every status of two variables, each checked against every completion of the unknown ones
+				const vector<VarStatus_e> kinds{ VarStatus_e::False, VarStatus_e::True, VarStatus_e::Unknown };
+				const vector<Operator_e> ops{ Operator_e::And, Operator_e::Or, Operator_e::Implies, Operator_e::Xor, Operator_e::Iff };
+
+				for (auto op : ops) {
+					for (int negations = 0; negations < 8; ++negations) {
+						unique_ptr<Expression> literal1 = make_unique<Literal>(0, str1, (negations & 1) != 0);
+						unique_ptr<Expression> literal2 = make_unique<Literal>(1, str2, (negations & 2) != 0);
+						Clause clause{ move(literal1), move(literal2), op, (negations & 4) != 0 };
+
+						for (auto left : kinds) {
+							for (auto right : kinds) {
+								bool anyTrue = false;
+								bool anyFalse = false;
+								Assignment assign{ 2 };
+								for (int a = 0; a < 4; ++a) {
+									bool leftValue = (a & 1) != 0;
+									bool rightValue = (a & 2) != 0;
+									if ((left != VarStatus_e::Unknown && leftValue != (left == VarStatus_e::True)) ||
+										(right != VarStatus_e::Unknown && rightValue != (right == VarStatus_e::True))) {
+										continue;
+									}
+									leftValue ? assign.setTrue(0) : assign.setFalse(0);
+									rightValue ? assign.setTrue(1) : assign.setFalse(1);
+									(clause.evaluate(assign) ? anyTrue : anyFalse) = true;
+								}
+
+								VarStatus_e expected = (anyTrue && anyFalse ? VarStatus_e::Unknown
+									: (anyTrue ? VarStatus_e::True : VarStatus_e::False));
+								Assert::IsTrue(clause.evaluate(vector<VarStatus_e>{ left, right }) == expected);
+							}
+						}
+					}
+				}
+			}
+
+			TEST_METHOD(Clause_DeepNestEvaluatePartial) {
+				unique_ptr<Expression> literalA = make_unique<Literal>(0, str1, true);
+				unique_ptr<Expression> literalB = make_unique<Literal>(4, str2);
+				unique_ptr<Expression> literalC = make_unique<Literal>(2, str3);
+				unique_ptr<Expression> literalD = make_unique<Literal>(3, str4);
+
+				unique_ptr<Expression> clauseAorB = make_unique<Clause>(move(literalA), move(literalB), Operator_e::Or);
+				unique_ptr<Expression> clauseCxorD = make_unique<Clause>(move(literalC), move(literalD), Operator_e::Xor);
+				Clause clauseWhole{ move(clauseAorB), move(clauseCxorD), Operator_e::Implies, true };
+
+				// ~A or B is TRUE, C xor D is unknown
+				vector<VarStatus_e> statuses(5, VarStatus_e::Unknown);
+				statuses[0] = VarStatus_e::False;
+				Assert::IsTrue(clauseWhole.evaluate(statuses) == VarStatus_e::Unknown);
+
+				// C xor D is FALSE, so the implication fails and its negation holds
+				statuses[2] = VarStatus_e::True;
+				statuses[3] = VarStatus_e::True;
+				Assert::IsTrue(clauseWhole.evaluate(statuses) == VarStatus_e::True);
+
+				// ~A or B is unknown, but C xor D is TRUE, so the implication holds
+				statuses[0] = VarStatus_e::Unknown;
+				statuses[3] = VarStatus_e::False;
+				Assert::IsTrue(clauseWhole.evaluate(statuses) == VarStatus_e::False);
+
+				clauseWhole.negate();
+				Assert::IsTrue(clauseWhole.evaluate(statuses) == VarStatus_e::True);
+			}
+
 		private:
 			string str1{ "A" };
 			string str2{ "B" };
@@ -0,0 +1,221 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/AssignmentStore.h"							// for variableIndex()
+#include "../Eunomia/Clause.h"									// for Clause
+#include "../Eunomia/DomainEngine.h"							// for DomainEngine
+#include "../Eunomia/Expression.h"								// for Expression
+#include "../Eunomia/Literal.h"									// for Literal
+#include "../Eunomia/LogicEngine.h"								// for LogicEngine
+#include "../Eunomia/Utility.h"									// for Operator_e, VarStatus_e, StatusReport, variablesNeeded(), kUncounted
+#include <algorithm>											// for sort
+#include <memory>												// for unique_ptr, make_unique
+#include <string>												// for to_string
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::to_string;
+using std::vector;
+using std::sort;
+using std::unique_ptr; using std::make_unique;
+using std::move;
+
+
+static unique_ptr<Expression> makePair(int catA, int itemA, int catB, int itemB, int categories, int itemsPer,
+	bool negate = false) {
+
+	int var = variableIndex(catA, itemA, catB, itemB, categories, itemsPer);
+	return make_unique<Literal>(var, to_string(var), negate);
+}
+
+static unique_ptr<Expression> makeJoin(unique_ptr<Expression>&& lhs, unique_ptr<Expression>&& rhs, Operator_e op) {
+	return make_unique<Clause>(move(lhs), move(rhs), op);
+}
+
+namespace Atropos {
+	TEST_CLASS(DomainEngineTester) {
+		public:
+			TEST_METHOD(DomainEngine_Construct) {
+				DomainEngine engine{ 4, 3 };
+
+				size_t num = variablesNeeded(4, 3);
+				for (size_t i = 0; i < num; ++i) {
+					Assert::IsTrue(engine.getStatus(i) == VarStatus_e::Unknown);
+				}
+				Assert::IsTrue(!engine.solved());
+			}
+
+			TEST_METHOD(DomainEngine_MatchesLogicEngine) {
+				const int cats = 4;
+				const int per = 3;
+				DomainEngine domain{ cats, per };
+				LogicEngine logic{ cats, per };
+
+				vector<unique_ptr<Expression>> clues;
+				clues.push_back(makeJoin(makePair(1, 0, 2, 1, cats, per), makePair(2, 2, 3, 0, cats, per), Operator_e::Or));
+				clues.push_back(makePair(0, 1, 3, 1, cats, per, true));
+				clues.push_back(makeJoin(makePair(1, 2, 3, 2, cats, per), makePair(0, 0, 2, 0, cats, per), Operator_e::Implies));
+				clues.push_back(makeJoin(makePair(1, 1, 2, 1, cats, per), makePair(0, 2, 1, 0, cats, per), Operator_e::Xor));
+				clues.push_back(makeJoin(makePair(2, 0, 3, 2, cats, per), makePair(0, 2, 3, 0, cats, per), Operator_e::Iff));
+				clues.push_back(makePair(1, 0, 3, 0, cats, per));
+
+				size_t num = variablesNeeded(cats, per);
+				for (const auto& clue : clues) {
+					Assert::IsTrue(domain.evaluateClue(*clue) == logic.evaluateClue(*clue));
+					for (size_t i = 0; i < num; ++i) {
+						Assert::IsTrue(domain.getStatus(i) == logic.getStatus(i));
+					}
+					Assert::IsTrue(domain.solved() == logic.solved());
+					Assert::IsTrue(domain.takeChanges() == logic.takeChanges());
+				}
+
+				Assert::IsTrue(domain.undoableClues() == logic.undoableClues());
+				for (size_t count : { size_t{ 2 }, domain.undoableClues() - 2 }) {
+					domain.undoClues(count);
+					logic.undoClues(count);
+					for (size_t i = 0; i < num; ++i) {
+						Assert::IsTrue(domain.getStatus(i) == logic.getStatus(i));
+					}
+					Assert::IsTrue(domain.solved() == logic.solved());
+
+					auto domainChanges = domain.takeChanges();
+					auto logicChanges = logic.takeChanges();
+					sort(domainChanges.begin(), domainChanges.end());
+					Assert::IsTrue(domainChanges == logicChanges);
+				}
+				Assert::IsTrue(domain.undoableClues() == 0);
+				Assert::IsTrue(domain.evaluateClue(*clues[1]));
+			}
+
+			TEST_METHOD(DomainEngine_Probe) {
+				const int cats = 4;
+				const int per = 3;
+				DomainEngine domain{ cats, per };
+				LogicEngine logic{ cats, per };
+
+				auto c1 = makeJoin(makePair(1, 0, 2, 1, cats, per), makePair(2, 2, 3, 0, cats, per), Operator_e::Or);
+				auto c2 = makePair(0, 1, 3, 1, cats, per, true);
+				Assert::IsTrue(domain.evaluateClue(*c1) && logic.evaluateClue(*c1));
+				Assert::IsTrue(domain.evaluateClue(*c2) && logic.evaluateClue(*c2));
+				domain.takeChanges();
+
+				auto h1 = makePair(1, 0, 3, 0, cats, per);
+				auto h2 = makePair(0, 1, 3, 1, cats, per);
+				auto h3 = makeJoin(makePair(1, 1, 2, 1, cats, per), makePair(0, 2, 1, 0, cats, per), Operator_e::Xor);
+				vector<const Expression*> hypotheses{ h1.get(), h2.get(), h3.get() };
+				auto domainProbes = domain.probeClues(hypotheses);
+				auto logicProbes = logic.probeClues(hypotheses);
+				Assert::IsTrue(domainProbes.size() == hypotheses.size());
+				for (size_t k = 0; k < hypotheses.size(); ++k) {
+					Assert::IsTrue(domainProbes[k].consistent == logicProbes[k].consistent);
+					Assert::IsTrue(domainProbes[k].survivors == (domainProbes[k].consistent ? kUncounted : 0));
+
+					auto domainChanges = domainProbes[k].changes;
+					sort(domainChanges.begin(), domainChanges.end(), [](const StatusReport& lhs, const StatusReport& rhs) {
+						return lhs.varIndex < rhs.varIndex;
+					});
+					Assert::IsTrue(domainChanges.size() == logicProbes[k].changes.size());
+					for (size_t c = 0; c < domainChanges.size(); ++c) {
+						Assert::IsTrue(domainChanges[c].varIndex == logicProbes[k].changes[c].varIndex);
+						Assert::IsTrue(domainChanges[c].status == logicProbes[k].changes[c].status);
+					}
+				}
+				Assert::IsTrue(!domainProbes[1].consistent);
+
+				size_t num = variablesNeeded(cats, per);
+				for (size_t i = 0; i < num; ++i) {
+					Assert::IsTrue(domain.getStatus(i) == logic.getStatus(i));
+				}
+				Assert::IsTrue(domain.undoableClues() == 2);
+				Assert::IsTrue(domain.takeChanges().empty());
+			}
+
+			TEST_METHOD(DomainEngine_Inconsistent) {
+				DomainEngine engine{ 3, 3 };
+
+				auto c1 = makePair(1, 2, 2, 0, 3, 3);
+				auto c2 = makeJoin(makePair(0, 0, 1, 2, 3, 3), makePair(0, 0, 2, 1, 3, 3), Operator_e::And);
+
+				Assert::IsTrue(engine.evaluateClue(*c1));
+				Assert::IsTrue(!engine.evaluateClue(*c2));
+				Assert::IsTrue(engine.getStatus(variableIndex(1, 2, 2, 0, 3, 3)) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(variableIndex(0, 0, 1, 2, 3, 3)) == VarStatus_e::Unknown);
+			}
+
+			TEST_METHOD(DomainEngine_Clone) {
+				DomainEngine engine{ 3, 3 };
+				auto c1 = makePair(0, 0, 1, 1, 3, 3);
+				Assert::IsTrue(engine.evaluateClue(*c1));
+
+				auto copy = engine.clone();
+				auto c2 = makePair(0, 1, 2, 2, 3, 3);
+				Assert::IsTrue(copy->evaluateClue(*c2));
+
+				int var = variableIndex(0, 1, 2, 2, 3, 3);
+				Assert::IsTrue(copy->getStatus(var) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(var) == VarStatus_e::Unknown);
+			}
+
+			TEST_METHOD(DomainEngine_SolveZebra) {
+				const int cats = 6;
+				const int per = 5;
+				enum { House, Color, Nation, Drink, Smoke, Pet };
+				enum { Green = 0, Blue, Ivory, Red, Yellow };
+				enum { Spaniard = 0, Japanese, Englishman, Ukrainian, Norwegian };
+				enum { Tea = 0, Water, OJ, Coffee, Milk };
+				enum { Lucky = 0, OldGold, Parliament, Kools, Chesterfield };
+				enum { Snails = 0, Zebra, Horse, Dog, Fox };
+				DomainEngine engine{ cats, per };
+
+				vector<unique_ptr<Expression>> clues;
+				clues.push_back(makePair(Color, Red, Nation, Englishman, cats, per));
+				clues.push_back(makePair(Nation, Spaniard, Pet, Dog, cats, per));
+				clues.push_back(makePair(Color, Green, Drink, Coffee, cats, per));
+				clues.push_back(makePair(Nation, Ukrainian, Drink, Tea, cats, per));
+				clues.push_back(rightOf(Color, Ivory, Color, Green));
+				clues.push_back(makePair(Smoke, OldGold, Pet, Snails, cats, per));
+				clues.push_back(makePair(Color, Yellow, Smoke, Kools, cats, per));
+				clues.push_back(makePair(House, 2, Drink, Milk, cats, per));
+				clues.push_back(makePair(House, 0, Nation, Norwegian, cats, per));
+				clues.push_back(nextTo(Smoke, Chesterfield, Pet, Fox));
+				clues.push_back(nextTo(Smoke, Kools, Pet, Horse));
+				clues.push_back(makePair(Drink, OJ, Smoke, Lucky, cats, per));
+				clues.push_back(makePair(Nation, Japanese, Smoke, Parliament, cats, per));
+				clues.push_back(nextTo(Color, Blue, Nation, Norwegian));
+
+				for (const auto& clue : clues) {
+					Assert::IsTrue(engine.evaluateClue(*clue));
+				}
+				Assert::IsTrue(engine.solved());
+				Assert::IsTrue(engine.getStatus(variableIndex(Nation, Japanese, Pet, Zebra, cats, per)) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(variableIndex(Nation, Norwegian, Drink, Water, cats, per)) == VarStatus_e::True);
+			}
+
+		private:
+			// the house of item <itemA> of category <catA> is immediately left of that of item <itemB>
+			//   of category <catB>, among the 5 houses of the Zebra Puzzle
+			unique_ptr<Expression> rightOf(int catA, int itemA, int catB, int itemB) const {
+				unique_ptr<Expression> expr = makeJoin(makePair(0, 0, catB, itemB, 6, 5, true),
+					makePair(0, 4, catA, itemA, 6, 5, true), Operator_e::And);
+				for (int house = 0; house < 4; ++house) {
+					expr = makeJoin(move(expr), makeJoin(makePair(0, house, catA, itemA, 6, 5),
+						makePair(0, house + 1, catB, itemB, 6, 5), Operator_e::Implies), Operator_e::And);
+				}
+				return expr;
+			}
+
+			// the houses of item <itemA> of category <catA> and item <itemB> of category <catB> are
+			//   adjacent, among the 5 houses of the Zebra Puzzle
+			unique_ptr<Expression> nextTo(int catA, int itemA, int catB, int itemB) const {
+				unique_ptr<Expression> expr = makePair(catA, itemA, catB, itemB, 6, 5, true);
+				for (int house = 0; house < 5; ++house) {
+					unique_ptr<Expression> neighbors = (house == 0 ? makePair(0, 1, catB, itemB, 6, 5) :
+						house == 4 ? makePair(0, 3, catB, itemB, 6, 5) :
+						makeJoin(makePair(0, house - 1, catB, itemB, 6, 5), makePair(0, house + 1, catB, itemB, 6, 5), Operator_e::Or));
+					expr = makeJoin(move(expr), makeJoin(makePair(0, house, catA, itemA, 6, 5), move(neighbors),
+						Operator_e::Implies), Operator_e::And);
+				}
+				return expr;
+			}
+	};
+}
\ No newline at end of file
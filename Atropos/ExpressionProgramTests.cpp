@@ -0,0 +1,102 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/Assignment.h"								// for Assignment
+#include "../Eunomia/Clause.h"									// for Clause
+#include "../Eunomia/Expression.h"								// for Expression
+#include "../Eunomia/ExpressionProgram.h"						// for ExpressionProgram
+#include "../Eunomia/Literal.h"									// for Literal
+#include "../Eunomia/Utility.h"									// for Operator_e
+#include <memory>												// for unique_ptr, make_unique
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::unique_ptr; using std::make_unique;
+using std::move;
+using std::vector;
+
+
+namespace Atropos {
+	TEST_CLASS(ExpressionProgramTester) {
+		public:
+			TEST_METHOD(ExpressionProgram_Literal) {
+				Literal literal{ 70, "A" };
+				Literal negated{ 70, "A", true };
+				ExpressionProgram program{ literal };
+				ExpressionProgram negatedProgram{ negated };
+				Assert::IsTrue(program.size() == 1 && program.heldCount() == 0);
+
+				Assignment assign{ 100 };
+				Assert::IsTrue(!program.evaluate(assign) && negatedProgram.evaluate(assign));
+				assign.setTrue(70);
+				Assert::IsTrue(program.evaluate(assign) && !negatedProgram.evaluate(assign));
+			}
+
+			TEST_METHOD(ExpressionProgram_Evaluate) {
+				const vector<Operator_e> ops{ Operator_e::And, Operator_e::Or, Operator_e::Implies, Operator_e::Xor, Operator_e::Iff };
+
+				// every operator joining every pair of operators, each negated or not, against every
+				// Assignment of four variables
+				for (auto top : ops) {
+					for (auto leftOp : ops) {
+						for (auto rightOp : ops) {
+							for (int negations = 0; negations < 16; ++negations) {
+								auto left = make_unique<Clause>(make_unique<Literal>(0, "A", (negations & 1) != 0),
+									make_unique<Literal>(1, "B"), leftOp, (negations & 2) != 0);
+								auto right = make_unique<Clause>(make_unique<Literal>(2, "C"),
+									make_unique<Literal>(3, "D", (negations & 4) != 0), rightOp);
+								Clause clause{ move(left), move(right), top, (negations & 8) != 0 };
+								ExpressionProgram program{ clause };
+
+								for (int bits = 0; bits < 16; ++bits) {
+									Assignment assign{ 4 };
+									for (int v = 0; v < 4; ++v) {
+										if ((bits >> v) & 1) {
+											assign.setTrue(v);
+										}
+									}
+									Assert::IsTrue(program.evaluate(assign) == clause.evaluate(assign));
+								}
+							}
+						}
+					}
+				}
+			}
+
+			TEST_METHOD(ExpressionProgram_ThreadJumps) {
+				// a run of conjunctions needs only one jump for each, and no values held aside
+				unique_ptr<Expression> conjunction = make_unique<Literal>(0, "A");
+				for (int v = 1; v < 5; ++v) {
+					conjunction = make_unique<Clause>(move(conjunction), make_unique<Literal>(v, "B"), Operator_e::And);
+				}
+				ExpressionProgram program{ *conjunction };
+				Assert::IsTrue(program.size() == 9 && program.heldCount() == 0);
+
+				Assignment assign{ 5 };
+				Assert::IsTrue(!program.evaluate(assign));
+				for (int v = 0; v < 5; ++v) {
+					assign.setTrue(v);
+				}
+				Assert::IsTrue(program.evaluate(assign));
+			}
+
+			TEST_METHOD(ExpressionProgram_DeepHeld) {
+				// an exclusive-or nested to the right holds aside more values than fit on the stack
+				const int numVars = static_cast<int>(ExpressionProgram::kInlineHeld) + 8;
+				unique_ptr<Expression> chain = make_unique<Literal>(numVars - 1, "Z");
+				for (int v = numVars - 2; v >= 0; --v) {
+					chain = make_unique<Clause>(make_unique<Literal>(v, "A"), move(chain), Operator_e::Xor);
+				}
+				ExpressionProgram program{ *chain };
+				Assert::IsTrue(program.heldCount() == ExpressionProgram::kInlineHeld + 7);
+
+				Assignment assign{ static_cast<size_t>(numVars) };
+				for (int v = 0; v < numVars; v += 3) {
+					assign.setTrue(v);
+				}
+				Assert::IsTrue(program.evaluate(assign) == chain->evaluate(assign));
+				assign.setTrue(1);
+				Assert::IsTrue(program.evaluate(assign) == chain->evaluate(assign));
+			}
+	};
+}
\ No newline at end of file
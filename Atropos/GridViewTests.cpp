@@ -27,5 +27,13 @@ namespace Atropos {
 
 				Assert::IsTrue(res);
 		}
+
+			TEST_METHOD(GridView_Batched) {
+				const char* testFileName = "SharedLongest";
+				bool res = testGridView(buildTestName(kViewPrefix, testFileName, kScenarioSuffix),
+					buildTestName(kViewPrefix, testFileName, kCorrectSuffix), true);
+
+				Assert::IsTrue(res);
+			}
 	};
 }
\ No newline at end of file
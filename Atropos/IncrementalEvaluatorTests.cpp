@@ -0,0 +1,86 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/Assignment.h"								// for Assignment
+#include "../Eunomia/Clause.h"									// for Clause
+#include "../Eunomia/Expression.h"								// for Expression
+#include "../Eunomia/IncrementalEvaluator.h"					// for IncrementalEvaluator
+#include "../Eunomia/Literal.h"									// for Literal
+#include "../Eunomia/Utility.h"									// for Operator_e, ExpressionNode
+#include <memory>												// for unique_ptr, make_unique
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::unique_ptr; using std::make_unique;
+using std::move;
+using std::vector;
+
+
+namespace Atropos {
+	TEST_CLASS(IncrementalEvaluatorTester) {
+		public:
+			TEST_METHOD(IncrementalEvaluator_Flatten) {
+				unique_ptr<Expression> literalA = make_unique<Literal>(0, "A", true);
+				unique_ptr<Expression> literalB = make_unique<Literal>(3, "B");
+				unique_ptr<Expression> literalC = make_unique<Literal>(1, "C");
+				unique_ptr<Expression> clauseAorB = make_unique<Clause>(move(literalA), move(literalB), Operator_e::Or);
+				Clause clause{ move(clauseAorB), move(literalC), Operator_e::Xor, true };
+
+				vector<ExpressionNode> nodes;
+				nodes.push_back(ExpressionNode{ true, false, 2, Operator_e::And, 0, 0 });
+				Assert::IsTrue(clause.flatten(nodes) == 5);
+				Assert::IsTrue(nodes.size() == 6);
+
+				Assert::IsTrue(nodes[1].isVariable && nodes[1].varIndex == 0 && nodes[1].negated);
+				Assert::IsTrue(nodes[2].isVariable && nodes[2].varIndex == 3 && !nodes[2].negated);
+				Assert::IsTrue(!nodes[3].isVariable && nodes[3].op == Operator_e::Or && nodes[3].left == 1 && nodes[3].right == 2);
+				Assert::IsTrue(nodes[4].isVariable && nodes[4].varIndex == 1);
+				Assert::IsTrue(!nodes[5].isVariable && nodes[5].op == Operator_e::Xor && nodes[5].negated);
+				Assert::IsTrue(nodes[5].left == 3 && nodes[5].right == 4);
+			}
+
+			TEST_METHOD(IncrementalEvaluator_Update) {
+				const size_t numVars = 5;
+				unique_ptr<Expression> literalA = make_unique<Literal>(0, "A", true);
+				unique_ptr<Expression> literalB = make_unique<Literal>(4, "B");
+				unique_ptr<Expression> literalC = make_unique<Literal>(2, "C");
+				unique_ptr<Expression> literalD = make_unique<Literal>(4, "D");
+				unique_ptr<Expression> clauseAorB = make_unique<Clause>(move(literalA), move(literalB), Operator_e::Or);
+				unique_ptr<Expression> clauseCxorD = make_unique<Clause>(move(literalC), move(literalD), Operator_e::Xor);
+				Clause nested{ move(clauseAorB), move(clauseCxorD), Operator_e::Implies, true };
+				unique_ptr<Expression> literalE = make_unique<Literal>(1, "E");
+				unique_ptr<Expression> literalF = make_unique<Literal>(3, "F", true);
+				Clause iff{ move(literalE), move(literalF), Operator_e::Iff };
+				Literal single{ 2, "G" };
+
+				vector<const Expression*> clues{ &nested, &iff, &single };
+				IncrementalEvaluator evaluator{ clues, numVars };
+				Assignment assign{ numVars };
+				evaluator.reset(assign);
+
+				// flip one variable at a time in Gray-code order, and now and then a second one as well
+				vector<int> changed;
+				for (int step = 1; step < 64; ++step) {
+					int flips = step ^ (step >> 1) ^ (step - 1) ^ ((step - 1) >> 1);
+					if (step % 3 == 0) {
+						flips ^= 1 << (step % 5);
+					}
+					changed.clear();
+					for (int v = 0; v < static_cast<int>(numVars); ++v) {
+						if (flips & (1 << v)) {
+							assign.getAssignedValue(v) ? assign.setFalse(v) : assign.setTrue(v);
+							changed.push_back(v);
+						}
+					}
+					if (step % 7 == 0) {
+						changed.push_back(4);									// an unchanged variable is harmless
+					}
+					evaluator.update(assign, changed);
+
+					for (size_t k = 0; k < clues.size(); ++k) {
+						Assert::IsTrue(evaluator.value(k) == clues[k]->evaluate(assign));
+					}
+				}
+			}
+	};
+}
\ No newline at end of file
@@ -1,14 +1,20 @@
 #include "stdafx.h"												// for UnitTesting framework
 #include "CppUnitTest.h"										// for UnitTesting framework
 #include "../Eunomia/Assignment.h"								// for Assignment
+#include "../Eunomia/BitSet.h"									// for BitSet
+#include "../Eunomia/Expression.h"								// for Expression
 #include "../Eunomia/Literal.h"									// for Literal
-#include "../Eunomia/Utility.h"									// for constant char symbols
+#include "../Eunomia/Utility.h"									// for constant char symbols, VarStatus_e
+#include <memory>												// for unique_ptr
 #include <sstream>												// for stringstream
 #include <string>												// for string
+#include <vector>												// for vector
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using std::string;
 using std::stringstream;
+using std::vector;
+using std::unique_ptr;
 
 
 namespace Atropos {
@@ -69,5 +75,48 @@ namespace Atropos {
 				literal.negate();
 				Assert::IsTrue(!literal.evaluate(assign));
 			}
+
+			TEST_METHOD(Literal_EvaluateColumns) {
+				Literal literal{ 1, "Gnocchi" };
+				vector<BitSet> columns{ BitSet{ 3 }, BitSet{ 3 } };
+				columns[1].set(0);
+				columns[1].set(2);
+
+				BitSet result = literal.evaluate(columns);
+				Assert::IsTrue(result.test(0) && !result.test(1) && result.test(2));
+
+				literal.negate();
+				result = literal.evaluate(columns);
+				Assert::IsTrue(!result.test(0) && result.test(1) && !result.test(2));
+				Assert::IsTrue(result.count() == 1);
+			}
+
+			TEST_METHOD(Literal_EvaluatePartial) {
+				Literal literal{ 1, "Rigatoni" };
+				vector<VarStatus_e> statuses{ VarStatus_e::False, VarStatus_e::True };
+
+				Assert::IsTrue(literal.evaluate(statuses) == VarStatus_e::True);
+				literal.negate();
+				Assert::IsTrue(literal.evaluate(statuses) == VarStatus_e::False);
+
+				statuses[1] = VarStatus_e::Unknown;
+				Assert::IsTrue(literal.evaluate(statuses) == VarStatus_e::Unknown);
+				literal.negate();
+				Assert::IsTrue(literal.evaluate(statuses) == VarStatus_e::Unknown);
+			}
+
+			TEST_METHOD(Literal_CloneAndCollect) {
+				Literal literal{ 2, "Farfalle", true };
+				unique_ptr<Expression> copy = literal.clone();
+				literal.negate();
+
+				Assignment assign{ 3 };
+				Assert::IsTrue(copy->evaluate(assign));
+				Assert::IsTrue(!literal.evaluate(assign));
+
+				vector<int> vars;
+				copy->collectVariables(vars);
+				Assert::IsTrue(vars == vector<int>{ 2 });
+			}
 	};
 }
\ No newline at end of file
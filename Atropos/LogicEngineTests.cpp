@@ -1,20 +1,24 @@
 #include "stdafx.h"												// for UnitTesting framework
 #include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/Assignment.h"								// for Assignment
+#include "../Eunomia/AssignmentStore.h"							// for orderBySelectivity(), enumerateSurvivors(), decodeRank(), encodeRank()
 #include "../Eunomia/Category.h"								// for Category
 #include "../Eunomia/Clause.h"									// for Clause
 #include "../Eunomia/Expression.h"								// for Expression
 #include "../Eunomia/Literal.h"									// for Literal
 #include "../Eunomia/LogicEngine.h"								// for LogicEngine
 #include "../Eunomia/Puzzle.h"									// for Puzzle
-#include "../Eunomia/Utility.h"									// for VarStatus_e
+#include "../Eunomia/Utility.h"									// for VarStatus_e, Storage_e, kStreamMemoryCap, ProbeResult
 #include <memory>												// for unique_ptr, make_unique
 #include <string>												// for string
+#include <utility>												// for pair
 #include <vector>												// for vector
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using std::string; using std::to_string;
 using std::vector;
 using std::unique_ptr; using std::make_unique;
+using std::pair;
 
 
 static unique_ptr<Expression> makeExpr(const Literal& literal, bool negate = false) {
@@ -245,7 +249,584 @@ namespace Atropos {
 				Assert::IsTrue(!engine.solved());
 			}
 
+
+			TEST_METHOD(LogicEngine_InitialClues) {
+				Puzzle puzzle = buildPuzzle();
+				auto literals = getLiterals();
+
+				auto c1 = makeExpr(literals[7]);
+				auto c2 = makeExpr(literals[7], true);
+				auto c3 = make_unique<Clause>(makeExpr(literals[0]), makeExpr(literals[2]), Operator_e::Or);
+				auto c4 = makeExpr(literals[26]);
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get(), c4.get() };
+
+				LogicEngine sequential{ puzzle.numCategories(), puzzle.itemsPerCategory() };
+				vector<bool> expected;
+				for (auto clue : clues) {
+					expected.push_back(sequential.evaluateClue(*clue));
+				}
+				Assert::IsTrue(expected == vector<bool>{ true, false, true, true });
+
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine batched{ puzzle.numCategories(), puzzle.itemsPerCategory(), storage, 16 };
+					Assert::IsTrue(batched.evaluateClues(clues) == expected);
+
+					LogicEngine constructed{ puzzle.numCategories(), puzzle.itemsPerCategory(), clues, storage, 16 };
+
+					size_t num = puzzle.numVariables();
+					for (size_t i = 0; i < num; ++i) {
+						Assert::IsTrue(batched.getStatus(i) == sequential.getStatus(i));
+						Assert::IsTrue(constructed.getStatus(i) == sequential.getStatus(i));
+					}
+					Assert::IsTrue(batched.solved() == sequential.solved());
+				}
+			}
+
+			TEST_METHOD(LogicEngine_FirstClueContradiction) {
+				Puzzle puzzle = buildPuzzle();
+				LogicEngine engine{ puzzle.numCategories(), puzzle.itemsPerCategory() };
+				auto literals = getLiterals();
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[7]), makeExpr(literals[7], true), Operator_e::And);
+				auto c2 = makeExpr(literals[7]);
+
+				Assert::IsTrue(!engine.evaluateClue(*c1));
+				Assert::IsTrue(engine.getStatus(7) == VarStatus_e::Unknown);
+				Assert::IsTrue(!engine.solved());
+
+				LogicEngine copy{ engine };
+				Assert::IsTrue(copy.evaluateClue(*c2));
+				Assert::IsTrue(copy.getStatus(7) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(7) == VarStatus_e::Unknown);
+			}
+
+			TEST_METHOD(LogicEngine_SlicedMatchesDense) {
+				matchesDense(Storage_e::Sliced);
+			}
+
+			TEST_METHOD(LogicEngine_SlicedInconsistent) {
+				rejectsInconsistent(Storage_e::Sliced);
+			}
+
+			TEST_METHOD(LogicEngine_RankedMatchesDense) {
+				matchesDense(Storage_e::Ranked);
+			}
+
+			TEST_METHOD(LogicEngine_RankedInconsistent) {
+				rejectsInconsistent(Storage_e::Ranked);
+			}
+
+			TEST_METHOD(LogicEngine_RankedCopy) {
+				Puzzle puzzle = buildPuzzle();
+				LogicEngine engine{ puzzle.numCategories(), puzzle.itemsPerCategory(), Storage_e::Ranked };
+				auto literals = getLiterals();
+
+				auto c1 = makeExpr(literals[7]);
+				Assert::IsTrue(engine.evaluateClue(*c1));
+
+				LogicEngine copy{ engine };
+				auto c2 = makeExpr(literals[0]);
+				Assert::IsTrue(copy.evaluateClue(*c2));
+				Assert::IsTrue(copy.getStatus(0) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(0) == VarStatus_e::Unknown);
+				Assert::IsTrue(engine.getStatus(7) == VarStatus_e::True);
+			}
+
+			TEST_METHOD(LogicEngine_StreamedMatchesDense) {
+				matchesDense(Storage_e::Streamed);
+			}
+
+			TEST_METHOD(LogicEngine_StreamedSmallSegments) {
+				matchesDense(Storage_e::Streamed, 16);
+			}
+
+			TEST_METHOD(LogicEngine_StreamedInconsistent) {
+				rejectsInconsistent(Storage_e::Streamed);
+			}
+
+			TEST_METHOD(LogicEngine_StreamedCopy) {
+				Puzzle puzzle = buildPuzzle();
+				LogicEngine engine{ puzzle.numCategories(), puzzle.itemsPerCategory(), Storage_e::Streamed, 16 };
+				auto literals = getLiterals();
+
+				auto c1 = makeExpr(literals[7]);
+				Assert::IsTrue(engine.evaluateClue(*c1));
+
+				LogicEngine copy{ engine };
+				auto c2 = makeExpr(literals[0]);
+				Assert::IsTrue(copy.evaluateClue(*c2));
+				Assert::IsTrue(copy.getStatus(0) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(0) == VarStatus_e::Unknown);
+
+				auto c3 = makeExpr(literals[0], true);
+				Assert::IsTrue(engine.evaluateClue(*c3));
+				Assert::IsTrue(engine.getStatus(0) == VarStatus_e::False);
+				Assert::IsTrue(engine.getStatus(7) == VarStatus_e::True);
+			}
+
+			TEST_METHOD(LogicEngine_ManyShards) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[0]), makeExpr(literals[0], true), Operator_e::Or);
+				auto c2 = make_unique<Clause>(makeExpr(literals[1]), makeExpr(literals[31]), Operator_e::Implies);
+				auto c3 = makeExpr(literals[12], true);
+				auto c4 = make_unique<Clause>(makeExpr(literals[30]), makeExpr(literals[55]), Operator_e::Xor);
+				auto c5 = makeExpr(literals[12]);
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get(), c4.get(), c5.get() };
+
+				LogicEngine dense{ 3, 5, Storage_e::Dense };
+				vector<bool> expected;
+				for (auto clue : clues) {
+					expected.push_back(dense.evaluateClue(*clue));
+				}
+				Assert::IsTrue(expected == vector<bool>{ true, true, true, true, false });
+				Assert::IsTrue(dense.getStatus(12) == VarStatus_e::False);
+
+				for (auto storage : { Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine other{ 3, 5, storage, 4096 };
+					for (size_t k = 0; k < clues.size(); ++k) {
+						Assert::IsTrue(other.evaluateClue(*clues[k]) == expected[k]);
+					}
+					for (int i = 0; i < 75; ++i) {
+						Assert::IsTrue(dense.getStatus(i) == other.getStatus(i));
+					}
+				}
+			}
+
+			TEST_METHOD(LogicEngine_TakeChanges) {
+				Puzzle puzzle = buildPuzzle();
+				LogicEngine engine{ puzzle.numCategories(), puzzle.itemsPerCategory() };
+				auto literals = getLiterals();
+				int num = static_cast<int>(puzzle.numVariables());
+				Assert::IsTrue(engine.takeChanges().empty());
+
+				auto c1 = makeExpr(literals[7]);
+				auto c2 = makeExpr(literals[7], true);
+				auto c3 = makeExpr(literals[0], true);
+				vector<bool> seen(num, false);
+				for (const Expression* clue : vector<const Expression*>{ c1.get(), c2.get(), c3.get() }) {
+					bool consistent = engine.evaluateClue(*clue);
+					auto changes = engine.takeChanges();
+					Assert::IsTrue(consistent || changes.empty());
+					for (auto varIndex : changes) {
+						Assert::IsTrue(!seen[varIndex]);
+						seen[varIndex] = true;
+					}
+					for (int i = 0; i < num; ++i) {
+						Assert::IsTrue(seen[i] == (engine.getStatus(i) != VarStatus_e::Unknown));
+					}
+					Assert::IsTrue(engine.takeChanges().empty());
+				}
+				Assert::IsTrue(seen[7] && seen[0]);
+			}
+
+			TEST_METHOD(LogicEngine_Undo) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[1]), makeExpr(literals[31]), Operator_e::Implies);
+				auto c2 = makeExpr(literals[12], true);
+				auto c3 = make_unique<Clause>(makeExpr(literals[30]), makeExpr(literals[55]), Operator_e::Xor);
+				auto c4 = makeExpr(literals[0]);
+				auto c5 = makeExpr(literals[0], true);
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get(), c4.get() };
+
+				vector<vector<VarStatus_e>> expected;						// expected[k] = statuses after the first k clues
+				for (size_t k = 0; k <= clues.size(); ++k) {
+					LogicEngine reference{ 3, 5 };
+					for (size_t c = 0; c < k; ++c) {
+						Assert::IsTrue(reference.evaluateClue(*clues[c]));
+					}
+					expected.push_back(statusesOf(reference, 75));
+				}
+
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine engine{ 3, 5, storage, 4096 };
+					Assert::IsTrue(engine.evaluateClues({ c1.get(), c2.get() }) == vector<bool>{ true, true });
+					Assert::IsTrue(engine.evaluateClue(*c3));
+					Assert::IsTrue(engine.evaluateClue(*c4));
+					Assert::IsTrue(!engine.evaluateClue(*c5));
+					Assert::IsTrue(engine.undoableClues() == 4);
+					engine.takeChanges();
+
+					LogicEngine copy{ engine };
+					for (auto [count, remaining] : { pair{ 1, 3 }, pair{ 2, 1 }, pair{ 1, 0 } }) {
+						auto before = statusesOf(copy, 75);
+						copy.undoClues(count);
+						Assert::IsTrue(copy.undoableClues() == static_cast<size_t>(remaining));
+						Assert::IsTrue(statusesOf(copy, 75) == expected[remaining]);
+
+						vector<bool> changed(75, false);
+						for (auto varIndex : copy.takeChanges()) {
+							changed[varIndex] = true;
+						}
+						for (int i = 0; i < 75; ++i) {
+							Assert::IsTrue(changed[i] == (before[i] != expected[remaining][i]));
+						}
+					}
+					Assert::IsTrue(statusesOf(engine, 75) == expected[4]);
+
+					engine.undoClues(2);
+					Assert::IsTrue(engine.evaluateClue(*c5));
+					Assert::IsTrue(engine.getStatus(0) == VarStatus_e::False);
+					Assert::IsTrue(engine.getStatus(12) == VarStatus_e::False);
+				}
+			}
+
+			TEST_METHOD(LogicEngine_FusedBatch) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[1]), makeExpr(literals[31]), Operator_e::Implies);
+				auto c2 = makeExpr(literals[12], true);
+				auto c3 = make_unique<Clause>(makeExpr(literals[30]), makeExpr(literals[55]), Operator_e::Xor);
+				auto c4 = makeExpr(literals[12]);
+				auto c5 = makeExpr(literals[0]);
+				auto c6 = makeExpr(literals[0], true);
+				vector<const Expression*> clues;
+				for (int k = 0; k < 70; ++k) {								// more than one group of fused clues
+					clues.push_back(k % 7 == 6 ? c6.get() : k % 3 == 0 ? c2.get() : k % 3 == 1 ? c3.get() : c4.get());
+				}
+				clues.push_back(c5.get());
+				clues.push_back(c6.get());
+
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine oneByOne{ 3, 5, storage, 4096 };
+					LogicEngine batched{ 3, 5, storage, 4096 };
+					Assert::IsTrue(oneByOne.evaluateClue(*c1) && batched.evaluateClue(*c1));
+
+					vector<bool> expected;
+					for (auto clue : clues) {
+						expected.push_back(oneByOne.evaluateClue(*clue));
+					}
+					Assert::IsTrue(batched.evaluateClues(clues) == expected);
+					Assert::IsTrue(!expected[2] && !expected[70] && expected[71]);
+					Assert::IsTrue(statusesOf(batched, 75) == statusesOf(oneByOne, 75));
+					Assert::IsTrue(batched.countSurvivors() == oneByOne.countSurvivors());
+
+					Assert::IsTrue(batched.undoableClues() == oneByOne.undoableClues());
+					while (batched.undoableClues() > 0) {
+						batched.undoClues(1);
+						oneByOne.undoClues(1);
+						Assert::IsTrue(statusesOf(batched, 75) == statusesOf(oneByOne, 75));
+						Assert::IsTrue(batched.countSurvivors() == oneByOne.countSurvivors());
+					}
+				}
+			}
+
+			TEST_METHOD(LogicEngine_Probe) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[1]), makeExpr(literals[31]), Operator_e::Implies);
+				auto c2 = makeExpr(literals[12], true);
+				auto c3 = make_unique<Clause>(makeExpr(literals[30]), makeExpr(literals[55]), Operator_e::Xor);
+				auto h1 = makeExpr(literals[0]);
+				auto h2 = makeExpr(literals[12]);
+				auto h3 = makeExpr(literals[12], true);
+				auto h4 = make_unique<Clause>(makeExpr(literals[30]), makeExpr(literals[1], true), Operator_e::Or);
+				vector<const Expression*> hypotheses{ h1.get(), h2.get(), h3.get(), h4.get() };
+
+				vector<size_t> denseSurvivors;
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine engine{ 3, 5, storage, 4096 };
+					auto unclued = engine.probeClues(hypotheses);
+					Assert::IsTrue(unclued.size() == hypotheses.size());
+					for (size_t k = 0; k < hypotheses.size(); ++k) {
+						Assert::IsTrue(probedAs(engine, *hypotheses[k], unclued[k]));
+					}
+
+					Assert::IsTrue(engine.evaluateClues({ c1.get(), c2.get() }) == vector<bool>{ true, true });
+					Assert::IsTrue(engine.evaluateClue(*c3));
+					engine.takeChanges();
+					auto before = statusesOf(engine, 75);
+					size_t survivors = engine.countSurvivors();
+
+					auto probes = engine.probeClues(hypotheses);
+					Assert::IsTrue(probes.size() == hypotheses.size());
+					for (size_t k = 0; k < hypotheses.size(); ++k) {
+						Assert::IsTrue(probedAs(engine, *hypotheses[k], probes[k]));
+					}
+					Assert::IsTrue(probes[0].consistent && probes[0].survivors < survivors && !probes[0].changes.empty());
+					Assert::IsTrue(!probes[1].consistent && probes[1].survivors == 0 && probes[1].changes.empty());
+					Assert::IsTrue(probes[2].consistent && probes[2].survivors == survivors && probes[2].changes.empty());
+
+					Assert::IsTrue(statusesOf(engine, 75) == before);
+					Assert::IsTrue(engine.countSurvivors() == survivors);
+					Assert::IsTrue(engine.undoableClues() == 3);
+					Assert::IsTrue(engine.takeChanges().empty());
+
+					if (storage == Storage_e::Dense) {
+						for (const auto& probe : probes) {
+							denseSurvivors.push_back(probe.survivors);
+						}
+					}
+					for (size_t k = 0; k < hypotheses.size(); ++k) {
+						Assert::IsTrue(probes[k].survivors == denseSurvivors[k]);
+					}
+				}
+			}
+
+			TEST_METHOD(LogicEngine_Compact) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				auto c1 = makeExpr(literals[0]);
+				auto c2 = makeExpr(literals[6]);
+				auto c3 = make_unique<Clause>(makeExpr(literals[12]), makeExpr(literals[18]), Operator_e::Or);
+				auto c4 = makeExpr(literals[25]);
+				auto c5 = makeExpr(literals[31], true);
+				auto h1 = makeExpr(literals[37]);
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get(), c4.get(), c5.get() };
+
+				vector<vector<VarStatus_e>> denseStatuses;
+				vector<size_t> denseSurvivors;
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine engine{ 3, 5, storage, 4096 };
+					vector<vector<VarStatus_e>> statuses;
+					vector<size_t> survivors;
+					for (auto clue : clues) {
+						Assert::IsTrue(engine.evaluateClue(*clue));
+						statuses.push_back(statusesOf(engine, 75));
+						survivors.push_back(engine.countSurvivors());
+						survivors.push_back(engine.probeClues({ h1.get() }).front().survivors);
+					}
+					Assert::IsTrue(survivors[8] * 64 < 14400);			// few enough that a Ranked store is sparse
+
+					LogicEngine copy{ engine };
+					Assert::IsTrue(copy.evaluateClue(*h1));
+					Assert::IsTrue(copy.countSurvivors() == survivors[9]);
+
+					if (storage == Storage_e::Dense) {
+						denseStatuses = statuses;
+						denseSurvivors = survivors;
+					}
+					Assert::IsTrue(statuses == denseStatuses && survivors == denseSurvivors);
+
+					for (size_t k = clues.size() - 1; k > 0; --k) {
+						engine.undoClues(1);
+						Assert::IsTrue(statusesOf(engine, 75) == statuses[k - 1]);
+						Assert::IsTrue(engine.countSurvivors() == survivors[2 * (k - 1)]);
+						Assert::IsTrue(engine.probeClues({ h1.get() }).front().survivors == survivors[2 * (k - 1) + 1]);
+					}
+					for (size_t k = 1; k < clues.size(); ++k) {
+						Assert::IsTrue(engine.evaluateClue(*clues[k]));
+						Assert::IsTrue(statusesOf(engine, 75) == statuses[k]);
+						Assert::IsTrue(engine.countSurvivors() == survivors[2 * k]);
+					}
+
+					LogicEngine batched{ 3, 5, clues, storage, 4096 };
+					Assert::IsTrue(statusesOf(batched, 75) == statuses.back());
+					batched.undoClues(1);
+					Assert::IsTrue(statusesOf(batched, 75) == statuses[clues.size() - 2]);
+					Assert::IsTrue(batched.countSurvivors() == survivors[2 * (clues.size() - 2)]);
+				}
+			}
+
+			TEST_METHOD(LogicEngine_CompactKeepsKind) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				// the first batch leaves 144 of 14400 possible solutions, which is what the store holds
+				// at its largest, so only the later clues, which leave 12 of those, make it compact
+				auto c1 = makeExpr(literals[0]);
+				auto c2 = makeExpr(literals[5]);
+				auto c3 = makeExpr(literals[11]);
+				auto c4 = makeExpr(literals[16]);
+				auto c5 = makeExpr(literals[22]);
+				vector<const Expression*> first{ c1.get(), c2.get(), c3.get() };
+
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced }) {
+					LogicEngine engine{ 3, 5, first, storage };
+					Assert::IsTrue(engine.countSurvivors() == 144);
+					Assert::IsTrue(engine.heldAs() == storage);
+
+					Assert::IsTrue(engine.evaluateClue(*c4));
+					Assert::IsTrue(engine.heldAs() == storage);
+					Assert::IsTrue(engine.evaluateClue(*c5));
+					Assert::IsTrue(engine.countSurvivors() == 12);
+					Assert::IsTrue(engine.heldAs() == Storage_e::Ranked);
+
+					engine.undoClues(3);
+					Assert::IsTrue(engine.countSurvivors() == 576);
+					Assert::IsTrue(engine.heldAs() == storage);
+				}
+			}
+
+			TEST_METHOD(LogicEngine_SelectivityOrder) {
+				vector<Literal> literals;
+				for (int i = 0; i < 75; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				auto neutral = makeExpr(literals[12], true);
+				auto weak = make_unique<Clause>(makeExpr(literals[0]), makeExpr(literals[1]), Operator_e::Or);
+				auto contra = makeExpr(literals[1]);
+				auto strong = make_unique<Clause>(makeExpr(literals[0]), makeExpr(literals[31]), Operator_e::And);
+				vector<const Expression*> clues{ neutral.get(), weak.get(), contra.get(), strong.get() };
+
+				auto ordered = orderBySelectivity(3, 5, clues);
+				Assert::IsTrue(ordered == vector<const Expression*>{ strong.get(), contra.get(), weak.get(), neutral.get() });
+				Assert::IsTrue(orderBySelectivity(3, 5, { weak.get() }) == vector<const Expression*>{ weak.get() });
+
+				for (auto storage : { Storage_e::Dense, Storage_e::Sliced, Storage_e::Ranked, Storage_e::Streamed }) {
+					LogicEngine oneByOne{ 3, 5, storage, 4096 };
+					LogicEngine batched{ 3, 5, storage, 4096 };
+
+					vector<bool> expected;
+					for (auto clue : clues) {
+						expected.push_back(oneByOne.evaluateClue(*clue));
+					}
+					Assert::IsTrue(expected == vector<bool>{ true, true, true, false });
+					Assert::IsTrue(batched.evaluateClues(clues) == expected);
+					Assert::IsTrue(statusesOf(batched, 75) == statusesOf(oneByOne, 75));
+					Assert::IsTrue(batched.countSurvivors() == oneByOne.countSurvivors());
+
+					Assert::IsTrue(batched.undoableClues() == oneByOne.undoableClues());
+					while (batched.undoableClues() > 0) {
+						batched.undoClues(1);
+						oneByOne.undoClues(1);
+						Assert::IsTrue(statusesOf(batched, 75) == statusesOf(oneByOne, 75));
+						Assert::IsTrue(batched.countSurvivors() == oneByOne.countSurvivors());
+					}
+				}
+			}
+
+			TEST_METHOD(LogicEngine_PrunedEnumeration) {
+				vector<Literal> literals;
+				for (int i = 0; i < 54; ++i) {
+					literals.emplace_back(i, to_string(i));
+				}
+
+				// a relation fixed at the first level, one fixed only at the last, mixed ones, and a
+				// clue that contradicts the first so that it fails wherever the first holds
+				auto first = makeExpr(literals[0]);
+				auto deep = makeExpr(literals[40], true);
+				auto mixed = make_unique<Clause>(makeExpr(literals[20]), makeExpr(literals[50]), Operator_e::Xor);
+				auto implied = make_unique<Clause>(makeExpr(literals[30]), makeExpr(literals[5]), Operator_e::Implies);
+				auto contra = makeExpr(literals[0], true);
+				vector<const Expression*> clues{ first.get(), deep.get(), mixed.get(), implied.get(), contra.get() };
+				vector<const Expression*> kept{ clues.cbegin(), clues.cend() - 1 };
+
+				for (const auto& batch : { clues, kept }) {
+					vector<size_t> expectedRanks;
+					vector<size_t> expectedPrefixes(batch.size(), 0);
+					vector<int> scratch;
+					for (size_t rank = 0; rank < 216; ++rank) {
+						Assignment assign = decodeRank(rank, 4, 3, scratch);
+						Assert::IsTrue(encodeRank(assign, 4, 3) == rank);
+						size_t k = 0;
+						while (k < batch.size() && batch[k]->evaluate(assign)) {
+							++expectedPrefixes[k++];
+						}
+						if (k == batch.size()) {
+							expectedRanks.push_back(rank);
+						}
+					}
+
+					vector<size_t> ranks;
+					auto prefixes = enumerateSurvivors(4, 3, batch, [&ranks](size_t rank, const Assignment&) {
+						ranks.push_back(rank);
+					});
+					Assert::IsTrue(prefixes == expectedPrefixes);
+					Assert::IsTrue(ranks == expectedRanks);
+
+					vector<vector<size_t>> sliceRanks(survivorSlices(4, 3));
+					prefixes = enumerateSurvivorSlices(4, 3, batch, [&sliceRanks](size_t slice, size_t rank, const Assignment&) {
+						sliceRanks[slice].push_back(rank);
+					});
+					ranks.clear();
+					for (const auto& slice : sliceRanks) {
+						ranks.insert(ranks.end(), slice.cbegin(), slice.cend());
+					}
+					Assert::IsTrue(prefixes == expectedPrefixes);
+					Assert::IsTrue(ranks == expectedRanks);
+				}
+			}
+
 		private:
+			static bool probedAs(const LogicEngine& engine, const Expression& clue, const ProbeResult& probe) {
+				LogicEngine copy{ engine };
+				copy.takeChanges();
+				if (copy.evaluateClue(clue) != probe.consistent) {
+					return false;
+				}
+				if (probe.survivors != (probe.consistent ? copy.countSurvivors() : 0)) {
+					return false;
+				}
+
+				auto changed = copy.takeChanges();
+				if (changed.size() != probe.changes.size()) {
+					return false;
+				}
+				for (size_t k = 0; k < changed.size(); ++k) {
+					if (changed[k] != probe.changes[k].varIndex || copy.getStatus(changed[k]) != probe.changes[k].status) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			static vector<VarStatus_e> statusesOf(const LogicEngine& engine, int num) {
+				vector<VarStatus_e> statuses;
+				for (int i = 0; i < num; ++i) {
+					statuses.push_back(engine.getStatus(i));
+				}
+				return statuses;
+			}
+
+			void matchesDense(Storage_e storage, size_t memoryCap = kStreamMemoryCap) const {
+				Puzzle puzzle = buildPuzzle();
+				LogicEngine dense{ puzzle.numCategories(), puzzle.itemsPerCategory(), Storage_e::Dense };
+				LogicEngine other{ puzzle.numCategories(), puzzle.itemsPerCategory(), storage, memoryCap };
+				auto literals = getLiterals();
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[6]), makeExpr(literals[8]), Operator_e::Or);
+				auto c2 = make_unique<Clause>(
+					make_unique<Clause>(makeExpr(literals[2], true), makeExpr(literals[22], true), Operator_e::And),
+					makeExpr(literals[4]), Operator_e::Iff);
+				auto c3 = makeExpr(literals[4], true);
+				auto c4 = make_unique<Clause>(makeExpr(literals[17]), makeExpr(literals[14]), Operator_e::Xor);
+
+				Assert::IsTrue(dense.evaluateClue(*c1) == other.evaluateClue(*c1));
+				Assert::IsTrue(dense.evaluateClue(*c2) == other.evaluateClue(*c2));
+				Assert::IsTrue(dense.evaluateClue(*c3) == other.evaluateClue(*c3));
+				Assert::IsTrue(dense.evaluateClue(*c4) == other.evaluateClue(*c4));
+
+				size_t num = puzzle.numVariables();
+				for (size_t i = 0; i < num; ++i) {
+					Assert::IsTrue(dense.getStatus(i) == other.getStatus(i));
+				}
+				Assert::IsTrue(dense.solved() == other.solved());
+			}
+
+			void rejectsInconsistent(Storage_e storage) const {
+				Puzzle puzzle = buildPuzzle();
+				LogicEngine engine{ puzzle.numCategories(), puzzle.itemsPerCategory(), storage };
+				auto literals = getLiterals();
+
+				auto c1 = makeExpr(literals[7]);
+				auto c2 = makeExpr(literals[7], true);
+
+				Assert::IsTrue(engine.evaluateClue(*c1));
+				Assert::IsTrue(!engine.evaluateClue(*c2));
+				Assert::IsTrue(engine.getStatus(7) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(0) == VarStatus_e::Unknown);
+			}
+
 			Puzzle buildPuzzle() const {
 				vector<string> items1{ "Leopard", "Ocelot", "Tiger" };
 				vector<string> items2{ "Quetzalcoatl", "Huitzilopochtli", "Tlaloc" };
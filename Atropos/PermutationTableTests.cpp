@@ -0,0 +1,72 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/PermutationTable.h"						// for PermutationTable
+#include <algorithm>											// for lexicographical_compare, is_permutation, equal, swap
+#include <cstdint>												// for int8_t
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::int8_t;
+using std::vector;
+using std::lexicographical_compare; using std::is_permutation; using std::equal; using std::swap;
+
+
+namespace Atropos {
+	TEST_CLASS(PermutationTableTester) {
+		public:
+			TEST_METHOD(PermutationTable_Small) {
+				const auto& table = PermutationTable::of(3);
+				Assert::IsTrue(table.width() == 3);
+				Assert::IsTrue(table.count() == 6);
+
+				vector<vector<int8_t>> expected{ { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+				for (size_t r = 0; r < table.count(); ++r) {
+					Assert::IsTrue(vector<int8_t>(table[r], table[r] + 3) == expected[r]);
+				}
+			}
+
+			TEST_METHOD(PermutationTable_Shared) {
+				Assert::IsTrue(&PermutationTable::of(5) == &PermutationTable::of(5));
+				Assert::IsTrue(&PermutationTable::of(9) == &PermutationTable::of(9));
+				Assert::IsTrue(&PermutationTable::of(5) != &PermutationTable::of(6));
+			}
+
+			TEST_METHOD(PermutationTable_Ordered) {
+				for (int items : { 8, 9 }) {
+					const auto& table = PermutationTable::of(items);
+					Assert::IsTrue(table.width() == items);
+
+					vector<int8_t> identity(table[0], table[0] + items);
+					for (size_t r = 1; r < table.count(); ++r) {
+						Assert::IsTrue(lexicographical_compare(table[r - 1], table[r - 1] + items, table[r], table[r] + items));
+						Assert::IsTrue(is_permutation(table[r], table[r] + items, identity.cbegin()));
+					}
+					Assert::IsTrue(table[table.count() - 1][0] == items - 1);
+				}
+				Assert::IsTrue(PermutationTable::of(8).count() == 40320);
+				Assert::IsTrue(PermutationTable::of(9).count() == 362880);
+			}
+
+			TEST_METHOD(PermutationTable_GrayOrder) {
+				for (int items : { 1, 2, 4, 7, 9 }) {
+					const auto& table = PermutationTable::of(items);
+					const auto& steps = table.grayOrder();
+					Assert::IsTrue(steps.size() == table.count());
+					Assert::IsTrue(steps.front().row == 0);
+
+					// replay the swaps from the identity, checking each against the row it names
+					vector<int8_t> perm(table[0], table[0] + items);
+					vector<bool> seen(table.count(), false);
+					for (size_t s = 0; s < steps.size(); ++s) {
+						if (s > 0) {
+							Assert::IsTrue(steps[s].swap >= 0 && steps[s].swap + 1 < items);
+							swap(perm[steps[s].swap], perm[steps[s].swap + 1]);
+						}
+						Assert::IsTrue(equal(perm.cbegin(), perm.cend(), table[steps[s].row]));
+						Assert::IsTrue(!seen[steps[s].row]);
+						seen[steps[s].row] = true;
+					}
+				}
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/Assignment.h"								// for Assignment
+#include "../Eunomia/AssignmentStore.h"							// for decodeRank()
+#include "../Eunomia/Clause.h"									// for Clause
+#include "../Eunomia/Expression.h"								// for Expression
+#include "../Eunomia/Literal.h"									// for Literal
+#include "../Eunomia/ProjectionMemo.h"							// for ProjectionMemo
+#include "../Eunomia/Utility.h"									// for Operator_e
+#include <memory>												// for unique_ptr, make_unique
+#include <string>												// for to_string
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::unique_ptr; using std::make_unique;
+using std::to_string;
+using std::move;
+using std::vector;
+
+
+namespace Atropos {
+	TEST_CLASS(ProjectionMemoTester) {
+		public:
+			TEST_METHOD(ProjectionMemo_Compiled) {
+				Literal single{ 3, "A" };
+				ProjectionMemo direct{ single, 1 };
+				Assert::IsTrue(direct.compiled() && !direct.memoized());
+				Assert::IsTrue(direct.supportSize() == 1);
+
+				auto repeated = chain(vector<int>{ 5, 1, 5, 9, 1 }, Operator_e::Or);
+				ProjectionMemo table{ *repeated, ProjectionMemo::kSlots };
+				Assert::IsTrue(table.compiled() && !table.memoized());
+				Assert::IsTrue(table.supportSize() == 3);
+
+				// a table much larger than the number of Assignments expected is not worth compiling
+				auto twelve = chain(vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }, Operator_e::And);
+				ProjectionMemo few{ *twelve, 1 };
+				Assert::IsTrue(!few.compiled() && !few.memoized());
+				ProjectionMemo enough{ *twelve, 64 };
+				Assert::IsTrue(enough.compiled());
+			}
+
+			TEST_METHOD(ProjectionMemo_Memoized) {
+				vector<int> many;
+				for (int v = 0; v <= static_cast<int>(ProjectionMemo::kMaxTableSupport); ++v) {
+					many.push_back(v);
+				}
+				auto large = chain(many, Operator_e::Or);
+				ProjectionMemo memo{ *large, ProjectionMemo::kSlots };
+				Assert::IsTrue(memo.memoized() && !memo.compiled());
+				Assert::IsTrue(memo.supportSize() == ProjectionMemo::kMaxTableSupport + 1);
+				ProjectionMemo few{ *large, 1 };
+				Assert::IsTrue(!few.memoized());
+
+				for (int v = static_cast<int>(ProjectionMemo::kMaxTableSupport) + 1; v <= static_cast<int>(ProjectionMemo::kMaxSupport); ++v) {
+					many.push_back(v);
+				}
+				auto wide = chain(many, Operator_e::And);
+				ProjectionMemo tooWide{ *wide, ProjectionMemo::kSlots };
+				Assert::IsTrue(!tooWide.memoized() && !tooWide.compiled());
+				Assert::IsTrue(tooWide.supportSize() == ProjectionMemo::kMaxSupport + 1);
+			}
+
+			TEST_METHOD(ProjectionMemo_Evaluate) {
+				// the variables relating the first two Categories of a 4x3 Puzzle, and a few others
+				auto first = chain(vector<int>{ 0, 4, 8, 20, 30 }, Operator_e::Xor);
+				auto second = chain(vector<int>{ 1, 40, 12, 1, 53, 27 }, Operator_e::Iff);
+				auto third = make_unique<Clause>(chain(vector<int>{ 0, 3, 6 }, Operator_e::Or),
+					chain(vector<int>{ 45, 50, 33 }, Operator_e::And), Operator_e::Implies, true);
+				vector<int> many;
+				for (int v = 0; v < 48; v += 2) {
+					many.push_back(v);
+				}
+				auto fourth = chain(many, Operator_e::Xor);						// too large to compile, so memoized
+
+				vector<const Expression*> clues{ first.get(), second.get(), third.get(), fourth.get() };
+				for (auto clue : clues) {
+					ProjectionMemo memo{ *clue, ProjectionMemo::kSlots };
+					Assert::IsTrue(memo.compiled() != (clue == fourth.get()));
+					Assert::IsTrue(memo.memoized() == (clue == fourth.get()));
+
+					vector<int> scratch;
+					for (int pass = 0; pass < 2; ++pass) {						// the second pass finds everything remembered
+						for (size_t rank = 0; rank < 216; ++rank) {
+							Assignment assign = decodeRank(rank, 4, 3, scratch);
+							Assert::IsTrue(memo.evaluate(assign) == clue->evaluate(assign));
+						}
+					}
+				}
+			}
+
+		private:
+			// join a Literal for each of <vars> with <op>, left to right
+			static unique_ptr<Expression> chain(const vector<int>& vars, Operator_e op) {
+				unique_ptr<Expression> expr = make_unique<Literal>(vars[0], to_string(vars[0]));
+				for (size_t i = 1; i < vars.size(); ++i) {
+					expr = make_unique<Clause>(move(expr), make_unique<Literal>(vars[i], to_string(vars[i])), op);
+				}
+				return expr;
+			}
+	};
+}
\ No newline at end of file
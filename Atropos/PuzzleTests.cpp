@@ -12,7 +12,7 @@
 #include <vector>												// for vector
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
-using std::string;
+using std::string; using std::to_string;
 using std::vector; using std::set;
 using std::unique_ptr; using std::make_unique;
 
@@ -220,5 +220,131 @@ namespace Atropos {
 				puzzle.applyClue(*c3);
 				Assert::IsTrue(puzzle.solved());
 			}
+
+			TEST_METHOD(Puzzle_ApplyClueBatch) {
+				vector<string> items1{ "Hamlet", "Macbeth", "Romeo & Juliet" };
+				vector<string> items2{ "Stephen Colbert", "John Oliver", "Jordan Klepper" };
+
+				vector<Category> categories{
+					Category{ "Shakespearean Tragedies", items1.cbegin(), items1.cend() },
+					Category{ "Daily Show Correspondents", items2.cbegin(), items2.cend() }
+				};
+				Puzzle puzzle{ "Yet Again Another Puzzle Batched", "...still no description needed",
+					categories.cbegin(), categories.cend() };
+
+				size_t num = items1.size();
+				vector<Literal> literals;
+				literals.reserve(puzzle.numVariables());
+				for (size_t i = 0; i < num; ++i) {
+					for (size_t j = 0; j < num; ++j) {
+						literals.emplace_back(i * num + j, items1[i] + "|" + items2[j]);
+					}
+				}
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[0]), makeExpr(literals[2]), Operator_e::Xor);
+				auto c2 = makeExpr(literals[6], true);
+				auto c3 = makeExpr(literals[6]);
+				auto c4 = make_unique<Clause>(
+					make_unique<Clause>(makeExpr(literals[4]), makeExpr(literals[7]), Operator_e::Or),
+					makeExpr(literals[5]), Operator_e::Implies);
+
+				auto results = puzzle.applyClues({ c1.get(), c2.get(), c3.get(), c4.get() });
+				Assert::IsTrue(results == vector<bool>{ true, true, false, true });
+				Assert::IsTrue(puzzle.solved());
+			}
+
+			TEST_METHOD(Puzzle_UndoClues) {
+				vector<string> items1{ "Hamlet", "Macbeth", "Romeo & Juliet" };
+				vector<string> items2{ "Stephen Colbert", "John Oliver", "Jordan Klepper" };
+
+				vector<Category> categories{
+					Category{ "Shakespearean Tragedies", items1.cbegin(), items1.cend() },
+					Category{ "Daily Show Correspondents", items2.cbegin(), items2.cend() }
+				};
+				Puzzle puzzle{ "Yet Again Another Puzzle Undone", "...description undone too",
+					categories.cbegin(), categories.cend() };
+
+				size_t num = items1.size();
+				vector<Literal> literals;
+				literals.reserve(puzzle.numVariables());
+				for (size_t i = 0; i < num; ++i) {
+					for (size_t j = 0; j < num; ++j) {
+						literals.emplace_back(i * num + j, items1[i] + "|" + items2[j]);
+					}
+				}
+
+				auto c1 = make_unique<Clause>(makeExpr(literals[0]), makeExpr(literals[2]), Operator_e::Xor);
+				auto c2 = makeExpr(literals[6], true);
+				auto c3 = makeExpr(literals[6]);
+				auto c4 = make_unique<Clause>(
+					make_unique<Clause>(makeExpr(literals[4]), makeExpr(literals[7]), Operator_e::Or),
+					makeExpr(literals[5]), Operator_e::Implies);
+
+				auto results = puzzle.applyClues({ c1.get(), c2.get(), c3.get() });
+				Assert::IsTrue(results == vector<bool>{ true, true, false });
+				Assert::IsTrue(puzzle.applyClue(*c4));
+				Assert::IsTrue(puzzle.solved());
+
+				Assert::IsTrue(puzzle.undoClues(1) == 1);
+				Assert::IsTrue(!puzzle.solved());
+				Assert::IsTrue(puzzle.undoClues(1) == 1);
+				Assert::IsTrue(puzzle.applyClue(*c3));
+				Assert::IsTrue(puzzle.undoClues(5) == 2);
+				Assert::IsTrue(puzzle.undoClues(1) == 0);
+				Assert::IsTrue(!puzzle.solved());
+			}
+
+			TEST_METHOD(Puzzle_LargeCopy) {
+				vector<Category> categories;
+				for (int c = 0; c < 6; ++c) {
+					vector<string> items{ "A", "B", "C", "D", "E" };
+					for (auto& item : items) {
+						item += to_string(c);
+					}
+					categories.push_back(Category{ "Category " + to_string(c), items.cbegin(), items.cend() });
+				}
+				Puzzle puzzle{ "A Puzzle Too Big To Enumerate", "six categories of five items each",
+					categories.cbegin(), categories.cend() };
+				Assert::IsTrue(puzzle.numVariables() == 375);
+
+				Literal literal{ 0, "A0|A1" };
+				Assert::IsTrue(puzzle.applyClue(literal));
+
+				Puzzle copy{ puzzle };
+				literal.negate();
+				Assert::IsTrue(!copy.applyClue(literal));
+				Assert::IsTrue(!puzzle.solved() && !copy.solved());
+			}
+
+			TEST_METHOD(Puzzle_CopyOnWrite) {
+				vector<string> items1{ "Hamlet", "Macbeth", "Romeo & Juliet" };
+				vector<string> items2{ "Stephen Colbert", "John Oliver", "Jordan Klepper" };
+
+				vector<Category> categories{
+					Category{ "Shakespearean Tragedies", items1.cbegin(), items1.cend() },
+					Category{ "Daily Show Correspondents", items2.cbegin(), items2.cend() }
+				};
+				Puzzle first{ "One Of A Pair", "...", categories.cbegin(), categories.cend() };
+				Puzzle second{ "The Other Of A Pair", "...", categories.cbegin(), categories.cend() };
+
+				Literal lit0{ 0, "Hamlet|Stephen Colbert" };
+				Literal lit4{ 4, "Macbeth|John Oliver" };
+				Assert::IsTrue(first.applyClue(lit0) && first.applyClue(lit4));
+				Assert::IsTrue(first.solved() && !second.solved());
+
+				Puzzle copy{ first };
+				Assert::IsTrue(copy.solved());
+				Assert::IsTrue(copy.undoClues(1) == 1);
+				Assert::IsTrue(!copy.solved() && first.solved());
+
+				second = first;
+				Assert::IsTrue(first.undoClues(2) == 2);
+				Assert::IsTrue(!first.solved() && second.solved() && !copy.solved());
+				Assert::IsTrue(first.undoClues(1) == 0);
+
+				lit4.negate();
+				Assert::IsTrue(copy.applyClue(lit4) && copy.solved());
+				Assert::IsTrue(!second.applyClue(lit4) && second.solved());
+			}
 	};
 }
\ No newline at end of file
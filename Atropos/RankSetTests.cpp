@@ -0,0 +1,106 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/RankSet.h"									// for RankSet
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::vector;
+
+
+namespace Atropos {
+	TEST_CLASS(RankSetTester) {
+		public:
+			TEST_METHOD(RankSet_Construct) {
+				const size_t num = RankSet::kChunkSize * 2 + 5;
+				RankSet empty{ num };
+				RankSet full{ num, true };
+
+				Assert::IsTrue(empty.size() == num);
+				Assert::IsTrue(empty.chunkCount() == 3);
+				Assert::IsTrue(empty.count() == 0);
+				Assert::IsTrue(full.count() == num);
+				Assert::IsTrue(full.test(0) && full.test(num - 1));
+				Assert::IsTrue(!empty.test(num - 1));
+				Assert::IsTrue(RankSet{}.chunkCount() == 0);
+			}
+
+			TEST_METHOD(RankSet_SetAndVisit) {
+				const size_t num = RankSet::kChunkSize * 2;
+				RankSet ranks{ num };
+
+				// enough ranks in the first chunk to outgrow an array
+				for (size_t rank = 0; rank < RankSet::kArrayMax + 10; ++rank) {
+					ranks.set(rank * 3);
+				}
+				ranks.set(RankSet::kChunkSize + 7);
+				ranks.set(RankSet::kChunkSize + 1);
+				ranks.set(RankSet::kChunkSize + 7);
+
+				Assert::IsTrue(ranks.count() == RankSet::kArrayMax + 12);
+				Assert::IsTrue(ranks.test(3) && !ranks.test(4));
+				Assert::IsTrue(ranks.test(RankSet::kChunkSize + 1) && !ranks.test(RankSet::kChunkSize + 2));
+
+				vector<size_t> visited;
+				ranks.visitChunk(1, [&visited](size_t rank) { visited.push_back(rank); });
+				Assert::IsTrue(visited == vector<size_t>{ RankSet::kChunkSize + 1, RankSet::kChunkSize + 7 });
+
+				visited.clear();
+				ranks.visitChunk(0, [&visited](size_t rank) { visited.push_back(rank); });
+				Assert::IsTrue(visited.size() == RankSet::kArrayMax + 10);
+				Assert::IsTrue(visited[1] == 3 && visited.back() == (RankSet::kArrayMax + 9) * 3);
+			}
+
+			TEST_METHOD(RankSet_Combine) {
+				const size_t num = RankSet::kChunkSize + 100;
+				RankSet lhs{ num };
+				RankSet rhs{ num, true };
+				lhs.set(2);
+				lhs.set(3);
+				lhs.set(RankSet::kChunkSize + 50);
+				RankSet some{ num };
+				some.set(3);
+				some.set(RankSet::kChunkSize + 99);
+
+				RankSet ranksAnd{ lhs };
+				ranksAnd &= some;
+				RankSet ranksOr{ lhs };
+				ranksOr |= some;
+				RankSet ranksAndNot{ rhs };
+				ranksAndNot.andNot(lhs);
+
+				Assert::IsTrue(ranksAnd.count() == 1 && ranksAnd.test(3));
+				Assert::IsTrue(ranksOr.count() == 4 && ranksOr.test(RankSet::kChunkSize + 99));
+				Assert::IsTrue(ranksAndNot.count() == num - 3);
+				Assert::IsTrue(!ranksAndNot.test(2) && ranksAndNot.test(4));
+
+				ranksAndNot |= lhs;
+				Assert::IsTrue(ranksAndNot == rhs);
+				ranksAndNot &= lhs;
+				Assert::IsTrue(ranksAndNot == lhs);
+			}
+
+			TEST_METHOD(RankSet_Optimize) {
+				const size_t num = RankSet::kChunkSize * 3;
+				RankSet full{ num, true };
+				RankSet holes{ full };
+				RankSet cleared{ num };
+				for (size_t rank = 100; rank < num; rank += 1000) {
+					cleared.set(rank);
+				}
+				holes.andNot(cleared);
+
+				RankSet optimized{ holes };
+				optimized.optimize();
+				Assert::IsTrue(optimized == holes);
+				Assert::IsTrue(optimized.count() == num - cleared.count());
+				Assert::IsTrue(!optimized.test(1100) && optimized.test(1101));
+
+				// a RankSet that was optimized into runs can still be added to
+				optimized.set(1100);
+				Assert::IsTrue(optimized.test(1100));
+				optimized |= cleared;
+				Assert::IsTrue(optimized == full);
+				Assert::IsTrue(optimized != holes);
+			}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/AssignmentStore.h"							// for permutationsCrossSize()
+#include "../Eunomia/Clause.h"									// for Clause
+#include "../Eunomia/Expression.h"								// for Expression
+#include "../Eunomia/Literal.h"									// for Literal
+#include "../Eunomia/LogicEngine.h"								// for LogicEngine
+#include "../Eunomia/ShapedLogicEngine.h"						// for ShapedLogicEngine
+#include "../Eunomia/Utility.h"									// for VarStatus_e, Operator_e, ProbeResult
+#include <memory>												// for unique_ptr, make_unique
+#include <string>												// for to_string
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::to_string;
+using std::vector;
+using std::unique_ptr; using std::make_unique;
+
+
+static unique_ptr<Expression> makeExpr(int varIndex, bool negate = false) {
+	auto expr = make_unique<Literal>(varIndex, to_string(varIndex));
+	if (negate) {
+		expr->negate();
+	}
+	return expr;
+}
+
+namespace Atropos {
+	TEST_CLASS(ShapedLogicEngineTester) {
+		public:
+			TEST_METHOD(ShapedLogicEngine_Construct) {
+				ShapedLogicEngine<3, 4> engine{};
+				Assert::IsTrue(ShapedLogicEngine<3, 4>::kVariables == 48);
+				for (int i = 0; i < ShapedLogicEngine<3, 4>::kVariables; ++i) {
+					Assert::IsTrue(engine.getStatus(i) == VarStatus_e::Unknown);
+				}
+				Assert::IsTrue(!engine.solved());
+			}
+
+			TEST_METHOD(ShapedLogicEngine_Matches3x4) {
+				matchesLogicEngine<3, 4>();
+			}
+
+			TEST_METHOD(ShapedLogicEngine_Matches4x4) {
+				matchesLogicEngine<4, 4>();
+			}
+
+			TEST_METHOD(ShapedLogicEngine_Matches4x5) {
+				matchesLogicEngine<4, 5>();
+			}
+
+			TEST_METHOD(ShapedLogicEngine_Compact3x4) {
+				compactsLikeLogicEngine<3, 4>();
+			}
+
+			TEST_METHOD(ShapedLogicEngine_Compact4x5) {
+				compactsLikeLogicEngine<4, 5>();
+			}
+
+			TEST_METHOD(ShapedLogicEngine_InitialClues) {
+				auto c1 = makeExpr(0);
+				auto c2 = makeExpr(0, true);
+				auto c3 = makeExpr(13, true);
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get() };
+
+				LogicEngine generic{ 4, 4 };
+				ShapedLogicEngine<4, 4> shaped{};
+				Assert::IsTrue(shaped.evaluateClues(clues) == generic.evaluateClues(clues));
+				Assert::IsTrue(shaped.evaluateClues(clues) == vector<bool>({ true, false, true }));
+				for (int i = 0; i < ShapedLogicEngine<4, 4>::kVariables; ++i) {
+					Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+				}
+
+				Assert::IsTrue(shaped.undoableClues() == 4);
+				Assert::IsTrue(generic.undoableClues() == 2);
+				shaped.undoClues(3);
+				generic.undoClues(1);
+				Assert::IsTrue(shaped.getStatus(13) == VarStatus_e::Unknown);
+				for (int i = 0; i < ShapedLogicEngine<4, 4>::kVariables; ++i) {
+					Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+				}
+			}
+
+			TEST_METHOD(ShapedLogicEngine_FusedBatch) {
+				auto c1 = make_unique<Clause>(makeExpr(0), makeExpr(5), Operator_e::Or);
+				auto c2 = makeExpr(0, true);
+				auto c3 = makeExpr(5, true);
+				auto c4 = make_unique<Clause>(makeExpr(20), makeExpr(37), Operator_e::Iff);
+				auto c5 = makeExpr(95);
+				vector<const Expression*> clues{ c2.get(), c3.get(), c4.get(), c5.get(), c2.get() };
+
+				LogicEngine generic{ 4, 4 };
+				ShapedLogicEngine<4, 4> shaped{};
+				Assert::IsTrue(generic.evaluateClue(*c1) && shaped.evaluateClue(*c1));
+
+				vector<bool> expected;
+				for (auto clue : clues) {
+					expected.push_back(generic.evaluateClue(*clue));
+				}
+				Assert::IsTrue(expected == vector<bool>({ true, false, true, true, true }));
+				Assert::IsTrue(shaped.evaluateClues(clues) == expected);
+				for (int i = 0; i < ShapedLogicEngine<4, 4>::kVariables; ++i) {
+					Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+				}
+				Assert::IsTrue(shaped.countSurvivors() == generic.countSurvivors());
+
+				Assert::IsTrue(shaped.undoableClues() == 5);
+				shaped.undoClues(3);
+				generic.undoClues(3);
+				for (int i = 0; i < ShapedLogicEngine<4, 4>::kVariables; ++i) {
+					Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+				}
+			}
+
+			TEST_METHOD(ShapedLogicEngine_SettledClues) {
+				ShapedLogicEngine<3, 4> engine{};
+				auto c1 = makeExpr(5);
+				auto c2 = makeExpr(5, true);
+				auto c3 = make_unique<Clause>(makeExpr(5), makeExpr(17), Operator_e::Or);
+				Assert::IsTrue(engine.evaluateClue(*c1));
+				size_t survivors = engine.countSurvivors();
+
+				// a clue that the statuses already contradict, or already satisfy, is settled without
+				// looking at the rows, but the satisfied one still counts as a consistent clue
+				auto probes = engine.probeClues({ c2.get(), c3.get() });
+				Assert::IsTrue(!probes[0].consistent && probes[0].survivors == 0);
+				Assert::IsTrue(probes[1].consistent && probes[1].survivors == survivors && probes[1].changes.empty());
+				Assert::IsTrue(!engine.evaluateClue(*c2));
+				Assert::IsTrue(engine.evaluateClue(*c3));
+				Assert::IsTrue(engine.countSurvivors() == survivors);
+				Assert::IsTrue(engine.undoableClues() == 2);
+			}
+
+			TEST_METHOD(ShapedLogicEngine_Copy) {
+				ShapedLogicEngine<3, 4> engine{};
+				auto c1 = makeExpr(5);
+				Assert::IsTrue(engine.evaluateClue(*c1));
+
+				auto copy = engine.clone();
+				auto c2 = makeExpr(0);
+				Assert::IsTrue(copy->evaluateClue(*c2));
+				Assert::IsTrue(copy->getStatus(0) == VarStatus_e::True);
+				Assert::IsTrue(engine.getStatus(0) == VarStatus_e::Unknown);
+				Assert::IsTrue(engine.getStatus(5) == VarStatus_e::True);
+			}
+
+		private:
+			static bool sameProbes(const vector<ProbeResult>& lhs, const vector<ProbeResult>& rhs) {
+				if (lhs.size() != rhs.size()) {
+					return false;
+				}
+				for (size_t k = 0; k < lhs.size(); ++k) {
+					if (lhs[k].consistent != rhs[k].consistent || lhs[k].survivors != rhs[k].survivors ||
+						lhs[k].changes.size() != rhs[k].changes.size()) {
+						return false;
+					}
+					for (size_t c = 0; c < lhs[k].changes.size(); ++c) {
+						if (lhs[k].changes[c].varIndex != rhs[k].changes[c].varIndex ||
+							lhs[k].changes[c].status != rhs[k].changes[c].status) {
+							return false;
+						}
+					}
+				}
+				return true;
+			}
+
+			template <int Categories, int Items>
+			void matchesLogicEngine() const {
+				const int last = ShapedLogicEngine<Categories, Items>::kVariables - 1;
+				LogicEngine generic{ Categories, Items };
+				ShapedLogicEngine<Categories, Items> shaped{};
+
+				auto c1 = make_unique<Clause>(makeExpr(0), makeExpr(Items + 1), Operator_e::Or);
+				auto c2 = makeExpr(last - Items);
+				auto c3 = make_unique<Clause>(makeExpr(last - Items, true), makeExpr(2), Operator_e::And);
+				auto c4 = make_unique<Clause>(makeExpr(last), makeExpr(3), Operator_e::Xor);
+				auto c5 = make_unique<Clause>(makeExpr(Items * Items + 1), makeExpr(last - 1, true), Operator_e::Implies);
+
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get(), c4.get(), c5.get() };
+				for (auto clue : clues) {
+					Assert::IsTrue(sameProbes(shaped.probeClues(clues), generic.probeClues(clues)));
+					Assert::IsTrue(shaped.evaluateClue(*clue) == generic.evaluateClue(*clue));
+					for (int i = 0; i <= last; ++i) {
+						Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+					}
+					Assert::IsTrue(shaped.solved() == generic.solved());
+					Assert::IsTrue(shaped.takeChanges() == generic.takeChanges());
+				}
+
+				Assert::IsTrue(shaped.undoableClues() == generic.undoableClues());
+				while (shaped.undoableClues() > 0) {
+					shaped.undoClues(1);
+					generic.undoClues(1);
+					for (int i = 0; i <= last; ++i) {
+						Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+					}
+					Assert::IsTrue(shaped.solved() == generic.solved());
+					Assert::IsTrue(shaped.takeChanges() == generic.takeChanges());
+				}
+				Assert::IsTrue(shaped.getStatus(0) == VarStatus_e::Unknown);
+			}
+
+			template <int Categories, int Items>
+			void compactsLikeLogicEngine() const {
+				const int last = ShapedLogicEngine<Categories, Items>::kVariables - 1;
+				LogicEngine generic{ Categories, Items };
+				ShapedLogicEngine<Categories, Items> shaped{};
+
+				// each of the first three clues pairs one more item with an item of Category 0, so the
+				// rows fall far enough to be compacted at least once along the way
+				auto c1 = makeExpr(0);
+				auto c2 = makeExpr(Items);
+				auto c3 = makeExpr((Categories - 1) * Items + 1);
+				auto c4 = make_unique<Clause>(makeExpr(last), makeExpr(last - 1), Operator_e::Or);
+				auto h1 = makeExpr(last - Items);
+				vector<const Expression*> clues{ c1.get(), c2.get(), c3.get(), c4.get() };
+
+				for (auto clue : clues) {
+					Assert::IsTrue(shaped.evaluateClue(*clue) && generic.evaluateClue(*clue));
+					Assert::IsTrue(shaped.countSurvivors() == generic.countSurvivors());
+					Assert::IsTrue(sameProbes(shaped.probeClues({ h1.get() }), generic.probeClues({ h1.get() })));
+					for (int i = 0; i <= last; ++i) {
+						Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+					}
+					Assert::IsTrue(shaped.takeChanges() == generic.takeChanges());
+				}
+				Assert::IsTrue(shaped.countSurvivors() * 64 < permutationsCrossSize(Categories - 1, Items));
+
+				auto copy = shaped.clone();
+				LogicEngine genericCopy{ generic };
+				Assert::IsTrue(copy->evaluateClue(*h1) == genericCopy.evaluateClue(*h1));
+				Assert::IsTrue(copy->countSurvivors() == genericCopy.countSurvivors());
+
+				while (shaped.undoableClues() > 0) {
+					shaped.undoClues(1);
+					generic.undoClues(1);
+					Assert::IsTrue(shaped.countSurvivors() == generic.countSurvivors());
+					for (int i = 0; i <= last; ++i) {
+						Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+					}
+					Assert::IsTrue(shaped.takeChanges() == generic.takeChanges());
+				}
+
+				Assert::IsTrue(shaped.evaluateClues(clues) == generic.evaluateClues(clues));
+				shaped.undoClues(1);
+				generic.undoClues(1);
+				Assert::IsTrue(shaped.countSurvivors() == generic.countSurvivors());
+				for (int i = 0; i <= last; ++i) {
+					Assert::IsTrue(shaped.getStatus(i) == generic.getStatus(i));
+				}
+			}
+	};
+}
\ No newline at end of file
@@ -43,5 +43,21 @@ namespace Atropos {
 
 				Assert::IsTrue(res);
 			}
+
+			TEST_METHOD(SummaryView_Regroup) {
+				const char* testFileName = "Regroup";
+				bool res = testSummaryView(buildTestName(kViewPrefix, testFileName, kScenarioSuffix),
+					buildTestName(kViewPrefix, testFileName, kCorrectSuffix));
+
+				Assert::IsTrue(res);
+			}
+
+			TEST_METHOD(SummaryView_Batched) {
+				const char* testFileName = "Full";
+				bool res = testSummaryView(buildTestName(kViewPrefix, testFileName, kScenarioSuffix),
+					buildTestName(kViewPrefix, testFileName, kCorrectSuffix), true);
+
+				Assert::IsTrue(res);
+			}
 	};
 }
\ No newline at end of file
@@ -1,31 +1,35 @@
 #include "stdafx.h"												// because the framework requires this header file
 #include "../Eunomia/GridView.h"								// for GridView
 #include "../Eunomia/SummaryView.h"								// for SummaryView
-#include "../Eunomia/Utility.h"									// for VarStatus_e
+#include "../Eunomia/Utility.h"									// for VarStatus_e, PuzzleId_t, StatusReport
 #include "../Eunomia/View.h"									// for View-inherited functions
 #include "ViewTestReader.h"										// for testing functions
 #include <fstream>												// for ifstream
 #include <iostream>												// for cout
 #include <sstream>												// for stringstream, strbuf
 #include <string>												// for string, strlen, strcat
+#include <vector>												// for vector
 
 using std::string; using std::strlen; using std::strcat;
 using std::ifstream;
 using std::cout; using std::endl;
 using std::stringstream; using std::streambuf;
+using std::vector;
 
 const char* kRelativeFileLoc = "../Atropos/ViewTestFiles/";
 const char* kFileSuffix = ".txt";
 const string kVName = "TestView";
 const string kPName = "Test Puzzle";
+const PuzzleId_t kPId = 7;
 
 // REQUIRES: neither <scenario> nor <correct> is a null-pointer, there are properly-
 //   formatted text files named <scenario> and <correct>
 // EFFECTS:  builds a View of type <Vw> based on the contents of the text file <scenario> and
 //   returns TRUE if the View's output matches the contents of the text file <correct>, otherwise
-//   returns FALSE
+//   returns FALSE; if <batched> is TRUE, the View is subscribed to a Puzzle id and everything
+//   is reported by that id, the statuses in a single batch, alongside a batch for another id
 template <typename Vw>
-bool testView(const std::string& scenario, const std::string& correct);
+bool testView(const std::string& scenario, const std::string& correct, bool batched);
 
 
 // concatenates <viewName> + <testName> + <suffix>
@@ -41,7 +45,7 @@ std::string buildTestName(const char* viewName, const char* testName, const char
 // test a View of type <Vw> with the contents of <scenario> against the contents of
 // <correct>
 template <typename Vw>
-bool testView(const std::string& scenario, const std::string& correct) {
+bool testView(const std::string& scenario, const std::string& correct, bool batched) {
 	ifstream scenarioIn{ scenario };										// open files
 	ifstream correctIn{ correct };
 
@@ -49,18 +53,40 @@ bool testView(const std::string& scenario, const std::string& correct) {
 	size_t itemsPer;
 	scenarioIn >> categories >> itemsPer;
 	Vw view{ kVName, kPName, categories, itemsPer };						// construct View
+	if (batched) {
+		view.subscribe(kPId);
+	}
 	for (size_t cat = 0; cat < categories; ++cat) {							// read in all the item strings
 		for (size_t item = 0; item < itemsPer; ++item) {
 			string itemStr{};
 			scenarioIn >> itemStr;
-			view.reportItem(kPName, cat, item, itemStr);
+			if (batched) {
+				view.reportItem(kPId + 1, cat, item, "Decoy");
+				view.reportItem(kPId, cat, item, itemStr);
+			}
+			else {
+				view.reportItem(kPName, cat, item, itemStr);
+			}
 		}
 	}
+	vector<StatusReport> reports;
 	int varIdx;
 	while (scenarioIn >> varIdx) {											// read in all the variable assignments
 		char val;
 		scenarioIn >> val;
-		view.reportStatus(kPName, varIdx, (val == 'T' ? VarStatus_e::True : VarStatus_e::False));
+		auto status = (val == 'T' ? VarStatus_e::True : (val == 'U' ? VarStatus_e::Unknown : VarStatus_e::False));
+		reports.push_back(StatusReport{ varIdx, status });
+		if (!batched) {
+			view.reportStatus(kPName, varIdx, reports.back().status);
+		}
+	}
+	if (batched) {
+		vector<StatusReport> decoys{ reports };
+		for (auto& decoy : decoys) {
+			decoy.status = (decoy.status == VarStatus_e::True ? VarStatus_e::False : VarStatus_e::True);
+		}
+		view.reportStatuses(kPId + 1, decoys);
+		view.reportStatuses(kPId, reports);
 	}
 
 	string correctStr{};
@@ -78,11 +104,11 @@ bool testView(const std::string& scenario, const std::string& correct) {
 }
 
 // test a GridView with the contents of <scenario> against the contents of <correct>
-bool testGridView(const std::string& scenario, const std::string& correct) {
-	return testView<GridView>(scenario, correct);
+bool testGridView(const std::string& scenario, const std::string& correct, bool batched) {
+	return testView<GridView>(scenario, correct, batched);
 }
 
 // test a SummaryView with the contents of <secnario> against the contents of <correct>
-bool testSummaryView(const std::string& scenario, const std::string& correct) {
-	return testView<SummaryView>(scenario, correct);
+bool testSummaryView(const std::string& scenario, const std::string& correct, bool batched) {
+	return testView<SummaryView>(scenario, correct, batched);
 }
\ No newline at end of file
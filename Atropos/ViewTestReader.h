@@ -14,14 +14,16 @@ std::string buildTestName(const char* viewName, const char* testName, const char
 //   formatted text files named <scenario> and <correct>
 // EFFECTS:  builds a GridView based on the contents of the text file <scenario> and returns
 //   TRUE if the GridView's output matches the contents of the text file <correct>, otherwise
-//   returns FALSE
-bool testGridView(const std::string& scenario, const std::string& correct);
+//   returns FALSE; if <batched> is TRUE, the contents are reported by Puzzle id, the statuses
+//   in a single batch
+bool testGridView(const std::string& scenario, const std::string& correct, bool batched = false);
 
 // REQUIRES: neither <scenario> nor <correct> is a null-pointer, there are properly-
 //   formatted text files named <scenario> and <correct>
 // EFFECTS:  builds a SummaryView based on the contents of the text file <scenario> and returns
 //   TRUE if the SummaryView's output matches the contents of the text file <correct>, otherwise
-//   returns FALSE
-bool testSummaryView(const std::string& scenario, const std::string& correct);
+//   returns FALSE; if <batched> is TRUE, the contents are reported by Puzzle id, the statuses
+//   in a single batch
+bool testSummaryView(const std::string& scenario, const std::string& correct, bool batched = false);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "stdafx.h"												// for UnitTesting framework
+#include "CppUnitTest.h"										// for UnitTesting framework
+#include "../Eunomia/WorkerPool.h"								// for WorkerPool
+#include <atomic>												// for atomic
+#include <stdexcept>											// for runtime_error
+#include <vector>												// for vector
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using std::atomic;
+using std::runtime_error;
+using std::vector;
+
+
+namespace Atropos {
+	TEST_CLASS(WorkerPoolTester) {
+		public:
+			TEST_METHOD(WorkerPool_Singleton) {
+				auto& pool = WorkerPool::getInstance();
+				Assert::IsTrue(&pool == &WorkerPool::getInstance());
+				Assert::IsTrue(pool.threadCount() >= 1);
+			}
+
+			TEST_METHOD(WorkerPool_TasksFor) {
+				auto& pool = WorkerPool::getInstance();
+				Assert::IsTrue(pool.tasksFor(0, 16) == 1);
+				Assert::IsTrue(pool.tasksFor(10, 16) == 1);
+				Assert::IsTrue(pool.tasksFor(1000000, 1) == 4 * pool.threadCount());
+				Assert::IsTrue(pool.tasksFor(32, 16) == 2);
+			}
+
+			TEST_METHOD(WorkerPool_RunsEveryTaskOnce) {
+				auto& pool = WorkerPool::getInstance();
+				for (size_t tasks : { 0, 1, 2, 7, 1000 }) {
+					vector<atomic<int>> calls(tasks);
+					pool.run(tasks, [&calls](size_t task) {
+						++calls[task];
+					});
+					for (const auto& count : calls) {
+						Assert::IsTrue(count == 1);
+					}
+				}
+			}
+
+			TEST_METHOD(WorkerPool_Nested) {
+				auto& pool = WorkerPool::getInstance();
+				vector<atomic<int>> calls(64);
+				pool.run(8, [&pool, &calls](size_t outer) {
+					pool.run(8, [&calls, outer](size_t inner) {
+						++calls[outer * 8 + inner];
+					});
+				});
+				for (const auto& count : calls) {
+					Assert::IsTrue(count == 1);
+				}
+			}
+
+			TEST_METHOD(WorkerPool_Exception) {
+				auto& pool = WorkerPool::getInstance();
+				bool caught = false;
+				try {
+					pool.run(100, [](size_t task) {
+						if (task == 42) {
+							throw runtime_error{ "task 42" };
+						}
+					});
+				}
+				catch (const runtime_error&) {
+					caught = true;
+				}
+				Assert::IsTrue(caught);
+
+				atomic<size_t> total{ 0 };
+				pool.run(100, [&total](size_t task) {
+					total += task;
+				});
+				Assert::IsTrue(total == 4950);
+			}
+	};
+}
\ No newline at end of file
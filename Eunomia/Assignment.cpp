@@ -1,11 +1,12 @@
 #include "Assignment.h"											// for Assignment
-#include <algorithm>											// for find
+#include <algorithm>											// for copy
+#include <bit>													// for countr_zero, popcount
 #include <cassert>												// for assert
-#include <iterator>												// for distance
+#include <stdexcept>											// for out_of_range
 #include <vector>												// for vector
 
-using std::find;
-using std::distance;
+using std::copy;
+using std::countr_zero; using std::popcount;
 using std::out_of_range;
 
 
@@ -17,11 +18,9 @@ Assignment::VarIterator::VarIterator(const Assignment* assign, bool target, int
 	assert(initialPos >= 0 && initialPos <= static_cast<int>(assign->size()));
 }
 
-// pre-increment
+// pre-increment by scanning word-by-word for the next variable with the target value
 Assignment::VarIterator& Assignment::VarIterator::operator++() {
-	do {
-		++position;
-	} while (position != assignment->size() && assignment->getAssignedValue(position) != target);
+	position = assignment->findNext(position + 1, target);
 	return *this;
 }
 
@@ -52,73 +51,161 @@ bool Assignment::VarIterator::operator!=(const Assignment::VarIterator& rhs) con
 	return !(*this == rhs);
 }
 
-// constructor
+// constructor; small Assignments never touch the heap
 Assignment::Assignment(size_t varCount)
-	: truths(varCount, false) {
+	: varCount{ varCount }, localWords{} {
 
 	assert(varCount > 0);
+	if (varCount > kInlineVariables) {
+		heapWords.assign((varCount + kWordBits - 1) / kWordBits, 0);
+	}
+}
+
+// constructor from packed words
+Assignment::Assignment(size_t varCount, const word_t* words)
+	: Assignment{ varCount } {
+
+	copy(words, words + wordCount(), this->words());
 }
 
 // return the size, which is the number of variables assigned to
 size_t Assignment::size() const {
-	return truths.size();
+	return varCount;
 }
 
-// index <truths> for the assigned value
+// mask out the variable's bit in its word
 bool Assignment::getAssignedValue(int varIndex) const {
-	assert(varIndex >= 0 && varIndex < static_cast<int>(truths.size()));
-	return truths[varIndex];
+	assert(varIndex >= 0 && varIndex < static_cast<int>(varCount));
+	return (words()[varIndex / kWordBits] >> (varIndex % kWordBits)) & 1;
 }
 
-// change the value of <truths> at given idex to TRUE
+// set the variable's bit in its word
 void Assignment::setTrue(int varIndex) {
-	assert(varIndex >= 0 && varIndex < static_cast<int>(truths.size()));
-	truths[varIndex] = true;
+	assert(varIndex >= 0 && varIndex < static_cast<int>(varCount));
+	words()[varIndex / kWordBits] |= (word_t{ 1 } << (varIndex % kWordBits));
 }
 
-// change the value of <truths> at given index to FALSE
+// clear the variable's bit in its word
 void Assignment::setFalse(int varIndex) {
-	assert(varIndex >= 0 && varIndex < static_cast<int>(truths.size()));
-	truths[varIndex] = false;
+	assert(varIndex >= 0 && varIndex < static_cast<int>(varCount));
+	words()[varIndex / kWordBits] &= ~(word_t{ 1 } << (varIndex % kWordBits));
 }
 
-// return an iterator to the first element of <truths> whose value is <target>,
-// or "one past the end" if none have the value of <target>
-typename Assignment::iterator_t Assignment::makeBeginIterator(bool target) const {
-	auto iter = find(truths.cbegin(), truths.cend(), target);
-	if (iter == truths.cend()) {
-		return iterator_t{ this, target, static_cast<int>(truths.size()) };
+// return the number of words needed for <varCount> bits
+size_t Assignment::wordCount() const {
+	return (varCount + kWordBits - 1) / kWordBits;
+}
+
+// return the <wordIndex>th word
+typename Assignment::word_t Assignment::getWord(size_t wordIndex) const {
+	assert(wordIndex < wordCount());
+	return words()[wordIndex];
+}
+
+// AND each word of <rhs> into the matching word of <this>
+Assignment& Assignment::operator&=(const Assignment& rhs) {
+	assert(rhs.varCount == varCount);
+
+	size_t count = wordCount();
+	word_t* mine = words();
+	const word_t* theirs = rhs.words();
+	for (size_t w = 0; w < count; ++w) {
+		mine[w] &= theirs[w];
+	}
+	return *this;
+}
+
+// OR each word of <rhs> into the matching word of <this>
+Assignment& Assignment::operator|=(const Assignment& rhs) {
+	assert(rhs.varCount == varCount);
+
+	size_t count = wordCount();
+	word_t* mine = words();
+	const word_t* theirs = rhs.words();
+	for (size_t w = 0; w < count; ++w) {
+		mine[w] |= theirs[w];
+	}
+	return *this;
+}
+
+// sum the popcounts of every word; the bits past <varCount> are always clear
+size_t Assignment::countTrue() const {
+	size_t count = wordCount();
+	const word_t* mine = words();
+
+	size_t total = 0;
+	for (size_t w = 0; w < count; ++w) {
+		total += popcount(mine[w]);
 	}
+	return total;
+}
+
+// return whichever of the two word buffers is in use
+typename Assignment::word_t* Assignment::words() {
+	return (heapWords.empty() ? localWords : heapWords.data());
+}
+
+// return whichever of the two word buffers is in use
+const typename Assignment::word_t* Assignment::words() const {
+	return (heapWords.empty() ? localWords : heapWords.data());
+}
 
-	int dist = static_cast<int>(distance(truths.cbegin(), iter));
-	return iterator_t{ this, target, dist };
+// skip whole words that hold no variable with the value <target>, then use the
+// trailing-zero count of the first interesting word to locate the variable
+int Assignment::findNext(int from, bool target) const {
+	assert(from >= 0 && from <= static_cast<int>(varCount));
+
+	size_t wordIdx = from / kWordBits;
+	size_t count = wordCount();
+	if (wordIdx >= count) {
+		return static_cast<int>(varCount);
+	}
+
+	const word_t* mine = words();
+	word_t current = (target ? mine[wordIdx] : ~mine[wordIdx]);
+	current &= (~word_t{ 0 } << (from % kWordBits));					// ignore variables before <from>
+	while (current == 0) {
+		if (++wordIdx == count) {
+			return static_cast<int>(varCount);
+		}
+		current = (target ? mine[wordIdx] : ~mine[wordIdx]);
+	}
+
+	size_t found = wordIdx * kWordBits + countr_zero(current);
+	return static_cast<int>(found < varCount ? found : varCount);		// FALSE scans can run into the unused tail bits
+}
+
+// return an iterator to the first variable whose value is <target>, or "one
+// past the end" if none have the value of <target>
+typename Assignment::iterator_t Assignment::makeBeginIterator(bool target) const {
+	return iterator_t{ this, target, findNext(0, target) };
 }
 
-// return an iterator to "one past the last" element of <truths>
+// return an iterator to "one past the last" variable
 typename Assignment::iterator_t Assignment::makeEndIterator(bool target) const {
-	return iterator_t{ this, target, static_cast<int>(truths.size()) };
+	return iterator_t{ this, target, static_cast<int>(varCount) };
 }
 
-// return an iterator to the first element of <truths> that is TRUE, or
-// "one past the end" if none are TRUE
+// return an iterator to the first variable that is TRUE, or "one past the end"
+// if none are TRUE
 typename Assignment::iterator_t Assignment::trueBegin() const {
 	return makeBeginIterator(true);
 }
 
-// return an iterator to "one past the last" element of <truths> that is
-// TRUE, or "one past the end" if none are TRUE
+// return an iterator to "one past the last" variable that is TRUE, or "one past
+// the end" if none are TRUE
 typename Assignment::iterator_t Assignment::trueEnd() const {
 	return makeEndIterator(true);
 }
 
-// return an iterator to the first element of <truths> that is FALSE, or
-// "one past the end" if none are FALSE
+// return an iterator to the first variable that is FALSE, or "one past the end"
+// if none are FALSE
 typename Assignment::iterator_t Assignment::falseBegin() const {
 	return makeBeginIterator(false);
 }
 
-// return an iterator to "one past the last" element of <truths> that is
-// FALSE, or "one past the end" if none are FALSE
+// return an iterator to "one past the last" variable that is FALSE, or "one past
+// the end" if none are FALSE
 typename Assignment::iterator_t Assignment::falseEnd() const {
 	return makeEndIterator(false);
 }
\ No newline at end of file
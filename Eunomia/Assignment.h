@@ -1,6 +1,7 @@
 #ifndef EUNOMIA_ASSIGNMENT
 #define EUNOMIA_ASSIGNMENT
 
+#include <cstdint>												// for uint64_t
 #include <vector>												// for vector
 
 /*
@@ -17,13 +18,29 @@
 	Assignment that currently has a specific assigned value. It is not possible to modify the value
 	of any variable directly through an iterator, and modifying the value indirectly or through the
 	Assignment itself renders the iterators invalid.
+
+	Internally, the assigned values are packed 64 to a word, and an Assignment of no more than
+	<kInlineVariables> variables keeps its words inline rather than on the heap. The words are exposed
+	(read-only) so that Assignments can be combined word-by-word; the bits of the final word beyond
+	<size()> are always FALSE.
 */
 
 class Assignment {
 	public:
-		// [Constructor]
-		// REQUIRES: <varCount> is positive and nonzero
+		using word_t = std::uint64_t;
+
+		static constexpr size_t kWordBits = 64;
+		static constexpr size_t kInlineWords = 4;
+		static constexpr size_t kInlineVariables = kWordBits * kInlineWords;
+
+		// [Constructors]
+		// REQUIRES: <varCount> is positive and nonzero; <words> points at the words that hold
+		//   the assigned values of <varCount> variables in the layout of <getWord()>, with the
+		//   bits of the final word beyond <varCount> FALSE
+		// EFFECTS:  constructs <this> with every variable assigned FALSE, or with the assigned
+		//   values held in <words>
 		explicit Assignment(size_t varCount);
+		Assignment(size_t varCount, const word_t* words);
 
 		// [Size Accessor]
 		// EFFECTS:  returns the number of variables for which <this> holds an assigned
@@ -43,6 +60,25 @@ class Assignment {
 		void setTrue(int varIndex);
 		void setFalse(int varIndex);
 
+		// [Word Accessors]
+		// REQUIRES: <wordIndex> is non-negative and less than <wordCount()>
+		// EFFECTS:  returns the number of words used to hold the assigned values of <this>,
+		//   or the <wordIndex>th such word, where variable ~v~ is bit ~v % 64~ of word ~v / 64~
+		size_t wordCount() const;
+		word_t getWord(size_t wordIndex) const;
+
+		// [Word-Wise Combiners]
+		// REQUIRES: <rhs> has the same size as <this>
+		// MODIFIES: <this>, invalidates any active iterators
+		// EFFECTS:  sets each variable of <this> to the AND or the OR of its current assigned
+		//   value and the assigned value of the same variable in <rhs>, then returns <this>
+		Assignment& operator&=(const Assignment& rhs);
+		Assignment& operator|=(const Assignment& rhs);
+
+		// [Truth Counter]
+		// EFFECTS:  returns the number of variables of <this> whose assigned value is TRUE
+		size_t countTrue() const;
+
 		/*
 			A VarIterator is a type of forward iterator that is attached to a particular
 			Assignment object and only stops at elements with a particular assigned
@@ -98,7 +134,20 @@ class Assignment {
 		iterator_t falseEnd() const;
 
 	private:
-		std::vector<bool> truths;
+		size_t varCount;
+		word_t localWords[kInlineWords];						// used when <varCount> is no more than <kInlineVariables>
+		std::vector<word_t> heapWords;							//   and this is used otherwise
+
+		// [Word Storage Accessors]
+		// EFFECTS:  returns a pointer to the first of the <wordCount()> words of <this>
+		word_t* words();
+		const word_t* words() const;
+
+		// [Word Scanner]
+		// REQUIRES: <from> is non-negative and no greater than <size()>
+		// EFFECTS:  returns the index of the first variable at or after <from> whose assigned
+		//   value is <target>, or <size()> if no such variable exists
+		int findNext(int from, bool target) const;
 
 		// [Iterator Generator Helpers]
 		// EFFECTS:  creates either a "begin" iterator that iterates over variables with an
@@ -0,0 +1,519 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for AssignmentStore
+#include "Expression.h"											// for Expression
+#include "IncrementalEvaluator.h"								// for IncrementalEvaluator
+#include "PermutationTable.h"									// for PermutationTable
+#include "Utility.h"											// for variablesNeeded(), VarStatus_e
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for copy, any_of, stable_sort, find_if, sort, iter_swap
+#include <cassert>												// for assert
+#include <cstdint>												// for int8_t, uint64_t
+#include <memory>												// for unique_ptr
+#include <numeric>												// for iota
+#include <random>												// for mt19937_64, uniform_int_distribution
+#include <vector>												// for vector
+
+using std::int8_t; using std::uint64_t;
+using std::vector;
+using std::unique_ptr;
+using std::copy; using std::any_of; using std::stable_sort; using std::find_if; using std::sort; using std::iter_swap;
+using std::iota;
+using std::mt19937_64; using std::uniform_int_distribution;
+
+// the number of possible solutions sampled to estimate how selective each clue is, and the
+// seed of the sample, fixed so that a batch of clues is always applied in the same order
+constexpr size_t kSelectivitySample = 256;
+constexpr std::uint_fast64_t kSelectivitySeed = 0x5eed;
+
+// REQUIRES: <num> is non-negative, <cumulative> is greater than 0
+// EFFECTS:  returns <num>! * <cumulative> tail-recursively
+constexpr int factorial(int num, int cumulative = 1);
+
+// REQUIRES: <categories> and <itemsPer> are both at least 2, <slice> is less than
+//   <survivorSlices(categories, itemsPer)>, <failures> has one element per clue
+// MODIFIES: <failures>
+// EFFECTS:  enumerates the possible solutions of the <slice>th slice in order of rank, calling
+//   <visit> with the rank and Assignment of each one for which every one of <clues> evaluates
+//   to TRUE, and adding to the ~k~th element of <failures> the number for which the ~k~th of
+//   <clues> is the first to evaluate to FALSE; the product of permutations is walked as a tree
+//   whose ~b~th level fixes the ~b~th permutation, each clue evaluated three-valued at each
+//   node, and a node at which the first clue still undecided is already FALSE is pruned along
+//   with every possible solution below it, none of which is ever built; the last level is
+//   stepped through in minimal-change order, so that each clue is brought up to date from the
+//   handful of variables that change rather than evaluated again from scratch
+void enumerateSlice(int categories, int itemsPer, size_t slice, const std::vector<const Expression*>& clues,
+	const SurvivorVisitor_t& visit, std::vector<size_t>& failures);
+
+/*
+	A PrefixWalk holds what the levels of the prefix tree of one slice share while <walkPrefix()> descends
+	it: the permutation whose leading blocks are fixed, the status of each variable that those blocks
+	settle, the number of possible solutions below a node at each level, and the rank of the next possible
+	solution to be reached, along with the IncrementalEvaluator that <walkLeaves()> keeps up to date.
+*/
+struct PrefixWalk {
+	const PermutationTable& table;
+	int categories;
+	int itemsPer;
+	const std::vector<const Expression*>& clues;
+	const SurvivorVisitor_t& visit;
+	std::vector<size_t>& failures;
+	IncrementalEvaluator evaluator;
+	std::vector<int> permutation;
+	std::vector<VarStatus_e> statuses;
+	std::vector<size_t> leavesBelow;							// leavesBelow[b] = possible solutions under a node fixing blocks 0..b
+	size_t rank;
+
+	// REQUIRES: the same as <enumerateSlice()>
+	// EFFECTS:  constructs <this> at the root of the prefix tree of the <slice>th slice, with
+	//   only the first block of <permutation> fixed and set in <statuses>, and every clue
+	//   undecided
+	PrefixWalk(int categories, int itemsPer, size_t slice, const std::vector<const Expression*>& clues,
+		const SurvivorVisitor_t& visit, std::vector<size_t>& failures);
+};
+
+// REQUIRES: <block> is less than <categories> - 1, the <block>th block of <permutation> is set
+// MODIFIES: <statuses>
+// EFFECTS:  sets the status of each variable that relates Category <block> + 1 to an earlier
+//   Category to TRUE if <permutation> puts the two items in the same group and FALSE otherwise,
+//   if <known> is TRUE, or to unknown if <known> is FALSE
+void setBlockStatuses(std::vector<VarStatus_e>& statuses, const std::vector<int>& permutation, int block,
+	int categories, int itemsPer, bool known);
+
+// REQUIRES: blocks 0 through <block> of <walk.permutation> are fixed and set in <walk.statuses>,
+//   every other variable being unknown there; <active> holds, in order, the indices of the clues
+//   that are not already TRUE at the parent of this node
+// MODIFIES: <walk>
+// EFFECTS:  enumerates every possible solution below this node in order of rank, exactly as
+//   <enumerateSlice()> describes, advancing <walk.rank> past all of them
+void walkPrefix(PrefixWalk& walk, int block, const std::vector<size_t>& active);
+
+// REQUIRES: every block of <walk.permutation> but the last is fixed, <active> is as for
+//   <walkPrefix()> at a child of this node
+// MODIFIES: <walk>
+// EFFECTS:  the same as <walkPrefix()> for every child of a node whose children are leaves
+void walkLeaves(PrefixWalk& walk, const std::vector<size_t>& active);
+
+// REQUIRES: <failures> is as tallied by <enumerateSlice()> over all <total> possible solutions
+// EFFECTS:  returns the prefix counts described by <enumerateSurvivors()>
+std::vector<size_t> prefixCounts(size_t total, const std::vector<size_t>& failures);
+
+
+// return <num>! * <cumulative>
+constexpr int factorial(int num, int cumulative) {
+	assert(num >= 0);
+	assert(cumulative > 0);
+
+	if (num == 0) {
+		return cumulative;
+	}
+	return factorial(num - 1, cumulative * num);
+}
+
+// translate each item in <permutations> into a variable index, where [0,1,1,0] would correspond
+// to two groups: one has Cat0Item0 and Cat1Item1, and the second has Cat0Item1 and Cat1Item0
+vector<int> getVariables(const vector<int>& permutation, int categories, int itemsPer) {
+	assert(!permutation.empty());
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+
+	vector<int> variables;
+	variables.reserve(itemsPer * categories * (categories - 1) / 2);			// categories CHOOSE 2 big cells, itemsPer variables each
+	
+	size_t permSize = permutation.size();
+	for (size_t i = 0; i < permSize; ++i) {
+		int cat = i / itemsPer;
+		int item = i % itemsPer;
+
+		int var = (categories - 1) * itemsPer * item +							// calculate the index of the variable for the item intersecion
+			itemsPer * cat +
+			permutation[i];
+		variables.emplace_back(var);
+	}
+
+	for (int cat = 1; cat < categories; ++cat) {														// get each intracategory match variable
+		for (int item = 0; item < itemsPer; ++item) {
+			for (int otherCat = cat + 1; otherCat < categories; ++otherCat) {
+				int var = sectionStart(categories - otherCat, categories, itemsPer) +					// shift to first cell of row-block
+					permutation[itemsPer * (otherCat - 1) + item] * itemsPer * (otherCat - 1) +			// shift to first cell or row-block row
+					itemsPer * (cat - 1) +																// shift to first cell of blocks intersection
+					permutation[itemsPer * (cat - 1) + item];											// shift to cell of intersection
+				variables.emplace_back(var);
+			}
+		}
+	}
+	return variables;
+}
+
+// return (<blockSize>!)^<blocks>
+size_t permutationsCrossSize(int blocks, int blockSize) {
+	assert(blocks > 0);
+	assert(blockSize >= 2);
+
+	size_t perBlock = static_cast<size_t>(factorial(blockSize));
+	size_t total = 1;
+	for (int b = 0; b < blocks; ++b) {
+		total *= perBlock;
+	}
+	return total;
+}
+
+// peel one base-<blockSize>! digit off of <rank> per block, least significant (i.e. last
+// block) first; since the permutation table is in lexicographic order, each digit, being
+// a Lehmer code, is simply the row of the table that holds the permutation for its block
+void unrankPermutationsCross(size_t rank, int blocks, int blockSize, vector<int>& permutation) {
+	assert(blocks > 0);
+	assert(blockSize >= 2);
+	assert(rank < permutationsCrossSize(blocks, blockSize));
+
+	const auto& table = PermutationTable::of(blockSize);
+	permutation.resize(static_cast<size_t>(blocks) * blockSize);
+	size_t perBlock = table.count();
+
+	for (int b = blocks - 1; b >= 0; --b) {
+		const int8_t* entries = table[rank % perBlock];
+		rank /= perBlock;
+		copy(entries, entries + blockSize, permutation.begin() + b * blockSize);
+	}
+}
+
+// unrank into <scratch>, then set each of the resulting variables TRUE
+Assignment decodeRank(size_t rank, int categories, int itemsPer, vector<int>& scratch) {
+	unrankPermutationsCross(rank, categories - 1, itemsPer, scratch);
+	Assignment assign{ variablesNeeded(categories, itemsPer) };
+	for (auto varIdx : getVariables(scratch, categories, itemsPer)) {
+		assign.setTrue(varIdx);
+	}
+	return assign;
+}
+
+// read the permutation of each block back out of the variables that pair Category 0 with the
+// block's Category, and append its Lehmer code to <rank> as the next, less significant, digit
+size_t encodeRank(const Assignment& assign, int categories, int itemsPer) {
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+
+	size_t perBlock = PermutationTable::of(itemsPer).count();
+	vector<int> items(itemsPer);
+	size_t rank = 0;
+	for (int cat = 1; cat < categories; ++cat) {
+		for (int group = 0; group < itemsPer; ++group) {
+			int item = 0;
+			while (!assign.getAssignedValue(variableIndex(0, group, cat, item, categories, itemsPer))) {
+				++item;
+				assert(item < itemsPer);
+			}
+			items[group] = item;
+		}
+
+		size_t code = 0;
+		for (int i = 0; i < itemsPer; ++i) {
+			int smaller = 0;
+			for (int j = i + 1; j < itemsPer; ++j) {
+				smaller += (items[j] < items[i] ? 1 : 0);
+			}
+			code = code * static_cast<size_t>(itemsPer - i) + static_cast<size_t>(smaller);
+		}
+		rank = rank * perBlock + code;
+	}
+	return rank;
+}
+
+// one slice after another, on this thread alone
+vector<size_t> enumerateSurvivors(int categories, int itemsPer, const vector<const Expression*>& clues,
+	const SurvivorVisitor_t& visit) {
+
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+
+	vector<size_t> failures(clues.size(), 0);
+	size_t slices = survivorSlices(categories, itemsPer);
+	for (size_t slice = 0; slice < slices; ++slice) {
+		enumerateSlice(categories, itemsPer, slice, clues, visit, failures);
+	}
+	return prefixCounts(permutationsCrossSize(categories - 1, itemsPer), failures);
+}
+
+// one task per slice on the WorkerPool, each tallying its failures separately so that
+// nothing is shared until the tallies are summed at the end
+vector<size_t> enumerateSurvivorSlices(int categories, int itemsPer, const vector<const Expression*>& clues,
+	const SliceVisitor_t& visit) {
+
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+
+	size_t slices = survivorSlices(categories, itemsPer);
+	vector<vector<size_t>> sliceFailures(slices, vector<size_t>(clues.size(), 0));
+	WorkerPool::getInstance().run(slices, [&](size_t slice) {
+		enumerateSlice(categories, itemsPer, slice, clues,
+			[&visit, slice](size_t rank, const Assignment& assign) {
+				visit(slice, rank, assign);
+			},
+			sliceFailures[slice]);
+	});
+
+	vector<size_t> failures(clues.size(), 0);
+	for (const auto& tally : sliceFailures) {
+		for (size_t k = 0; k < tally.size(); ++k) {
+			failures[k] += tally[k];
+		}
+	}
+	return prefixCounts(permutationsCrossSize(categories - 1, itemsPer), failures);
+}
+
+// the first block stays fixed on the slice's permutation while the rest are walked as a
+// prefix tree below it, starting with every clue undecided
+void enumerateSlice(int categories, int itemsPer, size_t slice, const vector<const Expression*>& clues,
+	const SurvivorVisitor_t& visit, vector<size_t>& failures) {
+
+	PrefixWalk walk{ categories, itemsPer, slice, clues, visit, failures };
+	vector<size_t> active(clues.size());
+	iota(active.begin(), active.end(), 0);
+	walkPrefix(walk, 0, active);
+}
+
+// constructor; the blocks past the first are left clear until the walk reaches them, and the
+// walk starts at the lowest rank of the slice
+PrefixWalk::PrefixWalk(int categories, int itemsPer, size_t slice, const vector<const Expression*>& clues,
+	const SurvivorVisitor_t& visit, vector<size_t>& failures)
+	: table{ PermutationTable::of(itemsPer) }, categories{ categories }, itemsPer{ itemsPer }, clues{ clues },
+	visit{ visit }, failures{ failures }, evaluator{ clues, variablesNeeded(categories, itemsPer) },
+	permutation(static_cast<size_t>(categories - 1) * itemsPer, 0),
+	statuses(variablesNeeded(categories, itemsPer), VarStatus_e::Unknown),
+	leavesBelow(categories - 1, 1), rank{ 0 } {
+
+	int blocks = categories - 1;
+	for (int b = blocks - 1; b > 0; --b) {
+		leavesBelow[b - 1] = leavesBelow[b] * table.count();
+	}
+	rank = slice * leavesBelow[0];
+
+	copy(table[slice], table[slice] + itemsPer, permutation.begin());
+	setBlockStatuses(statuses, permutation, 0, categories, itemsPer, true);
+}
+
+// category 0 is paired with Category <block> + 1 through the items of the block themselves, and
+// each earlier Category through the items that its own block gives the same group
+void setBlockStatuses(vector<VarStatus_e>& statuses, const vector<int>& permutation, int block,
+	int categories, int itemsPer, bool known) {
+
+	int cat = block + 1;
+	const int* items = permutation.data() + static_cast<size_t>(block) * itemsPer;
+	VarStatus_e unmatched = (known ? VarStatus_e::False : VarStatus_e::Unknown);
+	for (int catA = 0; catA < cat; ++catA) {
+		for (int itemA = 0; itemA < itemsPer; ++itemA) {
+			for (int itemB = 0; itemB < itemsPer; ++itemB) {
+				statuses[variableIndex(catA, itemA, cat, itemB, categories, itemsPer)] = unmatched;
+			}
+		}
+		if (!known) {
+			continue;
+		}
+
+		for (int group = 0; group < itemsPer; ++group) {
+			int itemA = (catA == 0 ? group : permutation[static_cast<size_t>(catA - 1) * itemsPer + group]);
+			statuses[variableIndex(catA, itemA, cat, items[group], categories, itemsPer)] = VarStatus_e::True;
+		}
+	}
+}
+
+// narrow the active clues to those this node leaves undecided, up to and including the first
+// that it makes FALSE, after which no clue can be the first to fail; if that one comes first,
+// every possible solution below fails at it and the node is pruned; a leaf that is not pruned
+// had every clue TRUE, so it is the only kind whose Assignment is built
+void walkPrefix(PrefixWalk& walk, int block, const vector<size_t>& active) {
+	vector<size_t> undecided;
+	undecided.reserve(active.size());
+	for (auto k : active) {
+		VarStatus_e status = walk.clues[k]->evaluate(walk.statuses);
+		if (status == VarStatus_e::True) {
+			continue;
+		}
+		undecided.push_back(k);
+		if (status == VarStatus_e::False) {
+			if (undecided.size() == 1) {								// every clue before it is TRUE, so prune
+				walk.failures[k] += walk.leavesBelow[block];
+				walk.rank += walk.leavesBelow[block];
+				return;
+			}
+			break;
+		}
+	}
+
+	int blocks = walk.categories - 1;
+	if (block + 1 == blocks) {											// a leaf, and every clue is TRUE
+		assert(undecided.empty());
+		Assignment assign{ walk.statuses.size() };
+		for (auto varIdx : getVariables(walk.permutation, walk.categories, walk.itemsPer)) {
+			assign.setTrue(varIdx);
+		}
+		walk.visit(walk.rank, assign);
+		++walk.rank;
+		return;
+	}
+
+	int next = block + 1;
+	if (next + 1 == blocks) {
+		walkLeaves(walk, undecided);
+		return;
+	}
+
+	auto slot = walk.permutation.begin() + static_cast<size_t>(next) * walk.itemsPer;
+	for (size_t row = 0; row < walk.table.count(); ++row) {
+		copy(walk.table[row], walk.table[row] + walk.itemsPer, slot);
+		setBlockStatuses(walk.statuses, walk.permutation, next, walk.categories, walk.itemsPer, true);
+		walkPrefix(walk, next, undecided);
+	}
+	setBlockStatuses(walk.statuses, walk.permutation, next, walk.categories, walk.itemsPer, false);
+}
+
+// step through the last block in minimal-change order, so that each leaf differs from the one
+// before it by two items of the last Category trading groups, which changes four variables per
+// earlier Category; only those are handed to the IncrementalEvaluator; the leaves for which
+// every clue is TRUE are then visited in order of rank, which is their order in the table
+void walkLeaves(PrefixWalk& walk, const vector<size_t>& active) {
+	int itemsPer = walk.itemsPer;
+	int last = walk.categories - 2;
+	auto slot = walk.permutation.begin() + static_cast<size_t>(last) * itemsPer;
+	copy(walk.table[0], walk.table[0] + itemsPer, slot);				// the minimal-change order starts at the identity
+
+	Assignment assign{ walk.statuses.size() };
+	for (auto varIdx : getVariables(walk.permutation, walk.categories, itemsPer)) {
+		assign.setTrue(varIdx);
+	}
+	walk.evaluator.reset(assign);
+
+	// the variables pairing each earlier Category with the last one for the groups at <swap>
+	// and just after it, all set to <value>
+	vector<int> changed;
+	auto setPairs = [&walk, &assign, &changed, slot, itemsPer, last](int swap, bool value) {
+		for (int catA = 0; catA <= last; ++catA) {
+			for (int group = swap; group <= swap + 1; ++group) {
+				int itemA = (catA == 0 ? group : walk.permutation[static_cast<size_t>(catA - 1) * itemsPer + group]);
+				int var = variableIndex(catA, itemA, last + 1, slot[group], walk.categories, itemsPer);
+				value ? assign.setTrue(var) : assign.setFalse(var);
+				changed.push_back(var);
+			}
+		}
+	};
+
+	const auto& steps = walk.table.grayOrder();
+	vector<size_t> kept;
+	for (size_t s = 0; s < steps.size(); ++s) {
+		if (s > 0) {
+			int swap = steps[s].swap;
+			changed.clear();
+			setPairs(swap, false);
+			iter_swap(slot + swap, slot + swap + 1);
+			setPairs(swap, true);
+			walk.evaluator.update(assign, changed);
+		}
+
+		auto failed = find_if(active.cbegin(), active.cend(), [&walk](size_t k) { return !walk.evaluator.value(k); });
+		if (failed == active.cend()) {
+			kept.push_back(steps[s].row);
+		}
+		else {
+			++walk.failures[*failed];
+		}
+	}
+
+	sort(kept.begin(), kept.end());
+	size_t base = walk.rank;
+	for (auto row : kept) {
+		copy(walk.table[row], walk.table[row] + itemsPer, slot);
+		Assignment leaf{ walk.statuses.size() };
+		for (auto varIdx : getVariables(walk.permutation, walk.categories, itemsPer)) {
+			leaf.setTrue(varIdx);
+		}
+		walk.visit(base + row, leaf);
+	}
+	walk.rank = base + walk.table.count();
+}
+
+// every failure at clue k or before takes one solution out of the k-th prefix
+vector<size_t> prefixCounts(size_t total, const vector<size_t>& failures) {
+	size_t numClues = failures.size();
+	vector<size_t> prefixes(numClues);
+	for (size_t k = 0; k < numClues; ++k) {
+		total -= failures[k];
+		prefixes[k] = total;
+	}
+	return prefixes;
+}
+
+// one slice per permutation of the first block
+size_t survivorSlices(int categories, int itemsPer) {
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+
+	return PermutationTable::of(itemsPer).count();
+}
+
+// take each clue in turn, keeping it if some Assignment fails neither it nor any clue
+// already kept; a consistent clue is usually satisfied near the front, so the search
+// seldom goes far
+uint64_t consistentClues(const vector<uint64_t>& failures, size_t numClues) {
+	assert(numClues <= 64);
+
+	uint64_t kept = 0;
+	for (size_t k = 0; k < numClues; ++k) {
+		uint64_t trial = kept | (uint64_t{ 1 } << k);
+		if (any_of(failures.cbegin(), failures.cend(), [trial](uint64_t mask) { return (mask & trial) == 0; })) {
+			kept = trial;
+		}
+	}
+	return kept;
+}
+
+// count how many of a fixed sample of ranks each clue lets through, then sort by that count;
+// the sample is drawn with replacement, which matters little since it only guides the order
+vector<const Expression*> orderBySelectivity(int categories, int itemsPer, const vector<const Expression*>& clues) {
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+
+	if (clues.size() < 2) {
+		return clues;
+	}
+
+	mt19937_64 engine{ kSelectivitySeed };
+	uniform_int_distribution<size_t> ranks{ 0, permutationsCrossSize(categories - 1, itemsPer) - 1 };
+	vector<size_t> passes(clues.size(), 0);
+	vector<int> scratch;
+	for (size_t s = 0; s < kSelectivitySample; ++s) {
+		Assignment assign = decodeRank(ranks(engine), categories, itemsPer, scratch);
+		for (size_t k = 0; k < clues.size(); ++k) {
+			if (clues[k]->evaluate(assign)) {
+				++passes[k];
+			}
+		}
+	}
+
+	vector<size_t> order(clues.size());
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&passes](size_t a, size_t b) { return passes[a] < passes[b]; });
+
+	vector<const Expression*> ordered;
+	ordered.reserve(clues.size());
+	for (auto k : order) {
+		ordered.push_back(clues[k]);
+	}
+	return ordered;
+}
+
+// polymorphic destructor
+AssignmentStore::~AssignmentStore() {}
+
+// nothing to give back unless a derived class says otherwise
+unique_ptr<AssignmentStore> AssignmentStore::compact() {
+	return nullptr;
+}
+
+// filter by the clues one at a time
+vector<bool> AssignmentStore::filterAll(const vector<const Expression*>& clues, vector<long long>& counts) {
+	vector<bool> results;
+	results.reserve(clues.size());
+	for (auto clue : clues) {
+		results.push_back(filter(*clue, counts));
+	}
+	return results;
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#ifndef EUNOMIA_ASSIGNMENT_STORE
+#define EUNOMIA_ASSIGNMENT_STORE
+
+#include <cassert>												// for assert
+#include <cstdint>												// for uint64_t
+#include <functional>											// for function
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+
+class Assignment;
+class Expression;
+enum class Storage_e;
+
+/*
+	An AssignmentStore is an abstract container for the viable Assignments of a logic Puzzle on behalf of a
+	LogicEngine. Every AssignmentStore starts out holding exactly one Assignment for each possible solution
+	of a Puzzle with a given number of Categories and items per Category, or only those for which every one
+	of an initial batch of clues is TRUE, and thereafter only ever shrinks, except when a filter is undone.
+	Derived classes decide how those Assignments are laid out in memory and how a clue is evaluated against
+	them; the LogicEngine only relies on the interface below.
+
+	An AssignmentStore can report how many Assignments remain viable and can tally, for each variable, the
+	number of viable Assignments in which that variable is TRUE. Filtering an AssignmentStore by a clue
+	removes each viable Assignment for which the clue evaluates to FALSE, and keeps such tallies up to date
+	as it does so. A filter that would remove every viable Assignment instead has no effect at all. A clue
+	can also be probed, which reports what filtering by it would remove without removing anything, and a
+	batch of clues can be filtered in one go with the same outcome as filtering by them one at a time.
+	Derived classes filter in shards of about <kShardSize> viable Assignments spread over the WorkerPool,
+	and commit nothing until every shard is done.
+
+	Every successful filter leaves a checkpoint behind, so that undoing it puts back exactly the Assignments
+	it removed without evaluating any clue. Once no more than one in <kCompactFactor> of the Assignments
+	that an AssignmentStore has held survive, it can be asked to compact, which may hand back an
+	AssignmentStore of another kind to take its place.
+
+	The possible solutions of a Puzzle with ~C~ Categories of ~I~ items each are enumerated as the Cartesian
+	product of ~C-1~ permutations of ~I~ items, the ~b~th of which maps the items of Category 0 onto those
+	of Category ~b+1~. The free functions declared below translate such a product into the variables that it
+	sets to TRUE, and are shared by all derived classes; each permutation is read out of the shared
+	PermutationTable for its size.
+*/
+
+class AssignmentStore {
+	public:
+		static constexpr size_t kShardSize = 4096;
+		static constexpr size_t kFusedClues = 64;
+		static constexpr size_t kCompactFactor = 8;
+
+		// [Destructor]
+		// EFFECTS:  virtually destructs <this>
+		virtual ~AssignmentStore();
+
+		// [Size Accessor]
+		// EFFECTS:  returns the number of Assignments that remain viable in <this>
+		virtual size_t size() const = 0;
+
+		// [Count Tallier]
+		// REQUIRES: <counts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <counts>
+		// EFFECTS:  adds to each element of <counts> the number of viable Assignments in <this>
+		//   in which the corresponding variable is TRUE
+		virtual void tally(std::vector<long long>& counts) const = 0;
+
+		// [Clue Filter]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  removes each viable Assignment for which <clue> evaluates to FALSE, updating
+		//   <counts> so that its elements remain accurate, and returns TRUE; if every viable
+		//   Assignment would be removed, makes no changes whatsoever and returns FALSE
+		virtual bool filter(const Expression& clue, std::vector<long long>& counts) = 0;
+
+		// [Batch Filter]
+		// REQUIRES: each variable that forms part of each of <clues> is a variable of the Assignments
+		//   of <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  filters <this> by each of <clues> in order exactly as <filter()> would, leaving
+		//   a checkpoint for each successful filter, and returns a list with one element per clue
+		//   that is TRUE if and only if that filter was successful
+		virtual std::vector<bool> filterAll(const std::vector<const Expression*>& clues, std::vector<long long>& counts);
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, <removedCounts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <removedCounts>
+		// EFFECTS:  returns the number of viable Assignments for which <clue> evaluates to FALSE and
+		//   adds to each element of <removedCounts> the number of those in which the corresponding
+		//   variable is TRUE, without changing <this>
+		virtual size_t probe(const Expression& clue, std::vector<long long>& removedCounts) const = 0;
+
+		// [Checkpoint Accessor]
+		// EFFECTS:  returns the number of successful filters of <this> that have not been undone
+		virtual size_t checkpoints() const = 0;
+
+		// [Filter Undoer]
+		// REQUIRES: <checkpoints()> is positive, each element of <counts> is the number of viable
+		//   Assignments of <this> in which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  restores each Assignment removed by the most recent successful filter of <this>
+		//   that has not been undone, updating <counts> so that its elements remain accurate
+		virtual void undo(std::vector<long long>& counts) = 0;
+
+		// [Memory Releaser]
+		// MODIFIES: <this>
+		// EFFECTS:  gives back what memory <this> still holds for Assignments that are no longer
+		//   viable, either in place, returning null, or by returning a new AssignmentStore that
+		//   holds the same viable Assignments and checkpoints in less room, which is then to take
+		//   the place of <this>; by default, does nothing and returns null
+		virtual std::unique_ptr<AssignmentStore> compact();
+
+		// [Kind Accessor]
+		// EFFECTS:  returns the kind of AssignmentStore that <this> is
+		virtual Storage_e kind() const = 0;
+
+		// [Cloner]
+		// EFFECTS:  returns a new AssignmentStore of the same kind as <this> holding the same
+		//   viable Assignments
+		virtual std::unique_ptr<AssignmentStore> clone() const = 0;
+};
+
+// REQUIRES: <permutation> is non-empty, <categories> and <itemsPer> are both at least 2
+// EFFECTS:  returns a list of variable indices corresponding to the items of <permutation>,
+//   where each ~n~th value is the index of an item from a category that all belong to the
+//   same group
+std::vector<int> getVariables(const std::vector<int>& permutation, int categories, int itemsPer);
+
+// REQUIRES: <axisIdx> is in the range [0, <categories>), <categories> is at least
+//   2, <itemsPer> is at least 2, <cumulative> is non-negative
+// EFFECTS:  returns the index of the variable corresponding to the intersection of
+//   item 0 in category <axisIdx> and item 0 in category 1 assuming that the variable
+//   at the intersection of item <itemsPer> in category <axisIdx> + 1 and item <itemsPer>
+//   in category <categories> is <cumulative>
+constexpr int sectionStart(int axisIdx, int categories, int itemsPer, int cumulative = 0);
+
+// REQUIRES: <catA> is non-negative and less than <catB>, <catB> is less than <categories>,
+//   <itemA> and <itemB> are non-negative and less than <itemsPer>, <categories> and <itemsPer>
+//   are both at least 2
+// EFFECTS:  returns the index of the variable that is TRUE exactly when item <itemA> of
+//   category <catA> and item <itemB> of category <catB> belong to the same group, in the same
+//   layout as that used by <getVariables()>
+constexpr int variableIndex(int catA, int itemA, int catB, int itemB, int categories, int itemsPer);
+
+// REQUIRES: <blocks> is positive, <blockSize> is at least 2
+// EFFECTS:  returns the number of elements in the Cartesian product of <blocks> lists of all
+//   possible permutations of <blockSize> items, which is (<blockSize>!)^<blocks>
+size_t permutationsCrossSize(int blocks, int blockSize);
+
+// REQUIRES: <blocks> is positive, <blockSize> is at least 2, <rank> is less than
+//   <permutationsCrossSize(blocks, blockSize)>
+// MODIFIES: <permutation>
+// EFFECTS:  overwrites <permutation> with the element at index <rank> of the Cartesian product
+//   of <blocks> lists of all possible permutations of <blockSize> items, each in lexicographic
+//   order: <rank> is read as a mixed-radix number with one digit of base <blockSize>! per
+//   block, most significant first, and each digit is the Lehmer code of the permutation for
+//   that block
+void unrankPermutationsCross(size_t rank, int blocks, int blockSize, std::vector<int>& permutation);
+
+// REQUIRES: <categories> and <itemsPer> are both at least 2, <rank> is less than
+//   <permutationsCrossSize(categories - 1, itemsPer)>
+// MODIFIES: <scratch>
+// EFFECTS:  returns the Assignment of the possible solution with rank <rank>, using <scratch>
+//   to hold its permutations
+Assignment decodeRank(size_t rank, int categories, int itemsPer, std::vector<int>& scratch);
+
+// REQUIRES: <categories> and <itemsPer> are both at least 2, <assign> is the Assignment of a
+//   possible solution of a Puzzle with those dimensions
+// EFFECTS:  returns the rank of the possible solution whose Assignment is <assign>, which
+//   <decodeRank()> turns back into <assign>
+size_t encodeRank(const Assignment& assign, int categories, int itemsPer);
+
+using SurvivorVisitor_t = std::function<void(size_t, const Assignment&)>;
+
+// REQUIRES: <categories> and <itemsPer> are both at least 2, each variable that forms part of
+//   each of <clues> is a variable of a Puzzle with those dimensions
+// EFFECTS:  enumerates the possible solutions of a Puzzle with the given dimensions in order of
+//   rank and calls <visit> with the rank and Assignment of each one for which every one of
+//   <clues> evaluates to TRUE; returns a list with one element per clue, the ~k~th of which is
+//   the number of possible solutions for which each of the first ~k+1~ of <clues> evaluates to
+//   TRUE; no Assignment outlives the call to <visit> for it
+std::vector<size_t> enumerateSurvivors(int categories, int itemsPer, const std::vector<const Expression*>& clues,
+	const SurvivorVisitor_t& visit);
+
+// REQUIRES: <categories> and <itemsPer> are both at least 2
+// EFFECTS:  returns the number of slices into which the possible solutions of a Puzzle with the
+//   given dimensions are split for parallel enumeration: one per permutation of the first
+//   block, each slice holding a run of consecutive ranks that precede those of the next slice
+size_t survivorSlices(int categories, int itemsPer);
+
+// REQUIRES: <numClues> is no greater than 64, the ~k~th bit of each element of <failures> is set if
+//   and only if the ~k~th of a batch of <numClues> clues evaluates to FALSE for the corresponding one
+//   of a set of Assignments
+// EFFECTS:  returns a mask whose ~k~th bit is set if and only if the ~k~th clue of the batch would be
+//   consistent were the clues evaluated in order against the set, each inconsistent clue having no
+//   effect: that is, if some Assignment satisfies it along with every consistent clue before it
+std::uint64_t consistentClues(const std::vector<std::uint64_t>& failures, size_t numClues);
+
+// REQUIRES: the same as <enumerateSurvivors()>
+// EFFECTS:  returns <clues> reordered so that the clues which a small random sample of the possible
+//   solutions of a Puzzle with the given dimensions suggests are the most selective come first,
+//   clues that seem equally selective keeping their order; the sample is the same on every call
+std::vector<const Expression*> orderBySelectivity(int categories, int itemsPer,
+	const std::vector<const Expression*>& clues);
+
+using SliceVisitor_t = std::function<void(size_t, size_t, const Assignment&)>;
+
+// REQUIRES: the same as <enumerateSurvivors()>
+// EFFECTS:  the same as <enumerateSurvivors()>, except that the slices are enumerated in parallel
+//   on the WorkerPool, and <visit> is called with the slice as well as the rank and Assignment of
+//   each survivor; calls to <visit> for different slices may run concurrently, but those for any
+//   one slice are made by a single thread in order of rank
+std::vector<size_t> enumerateSurvivorSlices(int categories, int itemsPer, const std::vector<const Expression*>& clues,
+	const SliceVisitor_t& visit);
+
+
+// return the index of the first variable in the row-block where items from category <axisIdx>
+// label the individual cell rows; this runs for every generated solution, so it stays in
+// integer arithmetic
+constexpr int sectionStart(int axisIdx, int categories, int itemsPer, int cumulative) {
+	assert(axisIdx >= 0 && axisIdx < categories);
+	assert(categories >= 2);
+	assert(itemsPer >= 2);
+	assert(cumulative >= 0);
+
+	if (axisIdx == 0) {
+		return cumulative;
+	}
+	int toAdd = itemsPer * itemsPer * (categories - axisIdx);
+	return sectionStart(axisIdx - 1, categories, itemsPer, cumulative + toAdd);
+}
+
+// pairs with category 0 live in the first row-block, addressed by the item of category 0;
+// every other pair lives in the row-block of <catB>, as in the second loop of <getVariables()>
+constexpr int variableIndex(int catA, int itemA, int catB, int itemB, int categories, int itemsPer) {
+	assert(catA >= 0 && catA < catB && catB < categories);
+	assert(itemA >= 0 && itemA < itemsPer);
+	assert(itemB >= 0 && itemB < itemsPer);
+
+	if (catA == 0) {
+		return (categories - 1) * itemsPer * itemA + itemsPer * (catB - 1) + itemB;
+	}
+	return sectionStart(categories - catB, categories, itemsPer) +
+		itemB * itemsPer * (catB - 1) +
+		itemsPer * (catA - 1) +
+		itemA;
+}
+
+#endif
\ No newline at end of file
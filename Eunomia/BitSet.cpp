@@ -0,0 +1,199 @@
+#include "BitSet.h"												// for BitSet
+#include <algorithm>											// for any_of
+#include <bit>													// for countr_zero, popcount
+#include <cassert>												// for assert
+#include <vector>												// for vector
+
+using std::any_of;
+using std::countr_zero; using std::popcount;
+
+
+// constructor
+BitSet::BitSet(size_t length, bool value)
+	: words((length + kWordBits - 1) / kWordBits, value ? ~word_t{ 0 } : 0), length{ length } {
+
+	clearTail();
+}
+
+// return the number of bits
+size_t BitSet::size() const {
+	return length;
+}
+
+// return the number of words
+size_t BitSet::wordCount() const {
+	return words.size();
+}
+
+// mask out the bit in its word
+bool BitSet::test(size_t index) const {
+	assert(index < length);
+	return (words[index / kWordBits] >> (index % kWordBits)) & 1;
+}
+
+// set the bit in its word
+void BitSet::set(size_t index) {
+	assert(index < length);
+	words[index / kWordBits] |= (word_t{ 1 } << (index % kWordBits));
+}
+
+// clear the bit in its word
+void BitSet::reset(size_t index) {
+	assert(index < length);
+	words[index / kWordBits] &= ~(word_t{ 1 } << (index % kWordBits));
+}
+
+// return the <wordIndex>th word
+typename BitSet::word_t BitSet::getWord(size_t wordIndex) const {
+	assert(wordIndex < words.size());
+	return words[wordIndex];
+}
+
+// return the <wordIndex>th word for overwriting
+typename BitSet::word_t& BitSet::getWord(size_t wordIndex) {
+	assert(wordIndex < words.size());
+	return words[wordIndex];
+}
+
+// sum the popcounts of every word
+size_t BitSet::count() const {
+	size_t total = 0;
+	for (auto word : words) {
+		total += popcount(word);
+	}
+	return total;
+}
+
+// TRUE iff no word has a bit set
+bool BitSet::none() const {
+	return !any();
+}
+
+// TRUE iff some word has a bit set
+bool BitSet::any() const {
+	return any_of(words.cbegin(), words.cend(), [](auto word)->bool { return word != 0; });
+}
+
+// skip empty words, then use the trailing-zero count of the first nonempty one
+size_t BitSet::findNext(size_t from) const {
+	assert(from <= length);
+
+	size_t wordIdx = from / kWordBits;
+	if (wordIdx >= words.size()) {
+		return length;
+	}
+
+	word_t current = words[wordIdx] & (~word_t{ 0 } << (from % kWordBits));
+	while (current == 0) {
+		if (++wordIdx == words.size()) {
+			return length;
+		}
+		current = words[wordIdx];
+	}
+	return wordIdx * kWordBits + countr_zero(current);
+}
+
+// flip every word, then clear the tail that flipping set
+void BitSet::flip() {
+	for (auto& word : words) {
+		word = ~word;
+	}
+	clearTail();
+}
+
+// AND word-by-word
+BitSet& BitSet::operator&=(const BitSet& rhs) {
+	assert(rhs.length == length);
+
+	size_t count = words.size();
+	for (size_t w = 0; w < count; ++w) {
+		words[w] &= rhs.words[w];
+	}
+	return *this;
+}
+
+// OR word-by-word
+BitSet& BitSet::operator|=(const BitSet& rhs) {
+	assert(rhs.length == length);
+
+	size_t count = words.size();
+	for (size_t w = 0; w < count; ++w) {
+		words[w] |= rhs.words[w];
+	}
+	return *this;
+}
+
+// XOR word-by-word
+BitSet& BitSet::operator^=(const BitSet& rhs) {
+	assert(rhs.length == length);
+
+	size_t count = words.size();
+	for (size_t w = 0; w < count; ++w) {
+		words[w] ^= rhs.words[w];
+	}
+	return *this;
+}
+
+// a IMPLIES b is (NOT a) OR b, word-by-word
+BitSet& BitSet::implies(const BitSet& rhs) {
+	assert(rhs.length == length);
+
+	size_t count = words.size();
+	for (size_t w = 0; w < count; ++w) {
+		words[w] = ~words[w] | rhs.words[w];
+	}
+	clearTail();
+	return *this;
+}
+
+// a IFF b is NOT (a XOR b), word-by-word
+BitSet& BitSet::iff(const BitSet& rhs) {
+	assert(rhs.length == length);
+
+	size_t count = words.size();
+	for (size_t w = 0; w < count; ++w) {
+		words[w] = ~(words[w] ^ rhs.words[w]);
+	}
+	clearTail();
+	return *this;
+}
+
+// a AND NOT b, word-by-word
+BitSet& BitSet::andNot(const BitSet& rhs) {
+	assert(rhs.length == length);
+
+	size_t count = words.size();
+	for (size_t w = 0; w < count; ++w) {
+		words[w] &= ~rhs.words[w];
+	}
+	return *this;
+}
+
+// sum the popcounts of each pair of words ANDed together
+size_t BitSet::countAnd(const BitSet& lhs, const BitSet& rhs) {
+	assert(lhs.length == rhs.length);
+
+	size_t total = 0;
+	size_t count = lhs.words.size();
+	for (size_t w = 0; w < count; ++w) {
+		total += popcount(lhs.words[w] & rhs.words[w]);
+	}
+	return total;
+}
+
+// equality operator
+bool BitSet::operator==(const BitSet& rhs) const {
+	return (length == rhs.length && words == rhs.words);
+}
+
+// inequality operator
+bool BitSet::operator!=(const BitSet& rhs) const {
+	return !(*this == rhs);
+}
+
+// clear whatever bits of the last word lie past <length>
+void BitSet::clearTail() {
+	if (length % kWordBits != 0) {
+		words.back() &= (~word_t{ 0 } >> (kWordBits - length % kWordBits));
+	}
+}
\ No newline at end of file
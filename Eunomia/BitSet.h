@@ -0,0 +1,108 @@
+#ifndef EUNOMIA_BIT_SET
+#define EUNOMIA_BIT_SET
+
+#include <cstdint>												// for uint64_t
+#include <vector>												// for vector
+
+/*
+	A BitSet is a fixed-length sequence of bits, packed 64 to a word, whose length is set at construction
+	and cannot thereafter be changed. Individual bits can be read, set, and cleared by their zero-based
+	index, and the number of set bits can be counted.
+
+	BitSets are meant to be combined in bulk: the Boolean operators AND, OR, XOR, IMPLIES, and IFF, as well
+	as negation, are applied to entire BitSets a word at a time. Combining two BitSets requires that both
+	have the same length. The bits of the final word past the length of a BitSet are always clear, so
+	that counting and comparing never need to special-case them.
+*/
+
+class BitSet {
+	public:
+		using word_t = std::uint64_t;
+
+		static constexpr size_t kWordBits = 64;
+
+		// [Constructor]
+		// EFFECTS:  creates a BitSet of <length> bits, all of which are set if <value> is TRUE
+		//   and clear otherwise
+		explicit BitSet(size_t length = 0, bool value = false);
+
+		// [Size Accessors]
+		// EFFECTS:  returns the number of bits in <this>, or the number of words used to hold
+		//   them
+		size_t size() const;
+		size_t wordCount() const;
+
+		// [Bit Accessor]
+		// REQUIRES: <index> is less than <size()>
+		// EFFECTS:  returns TRUE if the <index>th bit of <this> is set and FALSE otherwise
+		bool test(size_t index) const;
+
+		// [Bit Setters]
+		// REQUIRES: <index> is less than <size()>
+		// MODIFIES: <this>
+		// EFFECTS:  sets or clears the <index>th bit of <this>
+		void set(size_t index);
+		void reset(size_t index);
+
+		// [Word Accessors]
+		// REQUIRES: <wordIndex> is less than <wordCount()>
+		// EFFECTS:  returns the <wordIndex>th word of <this>, where bit ~b~ is bit ~b % 64~ of
+		//   word ~b / 64~; the non-const overload allows the word to be overwritten, in which
+		//   case the caller must keep the bits past <size()> clear
+		word_t getWord(size_t wordIndex) const;
+		word_t& getWord(size_t wordIndex);
+
+		// [Counters]
+		// EFFECTS:  returns the number of set bits in <this>, or whether that number is zero
+		//   or nonzero
+		size_t count() const;
+		bool none() const;
+		bool any() const;
+
+		// [Bit Scanner]
+		// REQUIRES: <from> is no greater than <size()>
+		// EFFECTS:  returns the index of the first set bit at or after <from>, or <size()> if
+		//   there is no such bit
+		size_t findNext(size_t from) const;
+
+		// [Negator]
+		// MODIFIES: <this>
+		// EFFECTS:  flips every bit of <this>
+		void flip();
+
+		// [Combiners]
+		// REQUIRES: <rhs> has the same size as <this>
+		// MODIFIES: <this>
+		// EFFECTS:  replaces each bit ~a~ of <this> with (~a~ AND ~b~), (~a~ OR ~b~), (~a~ XOR ~b~),
+		//   (~a~ IMPLIES ~b~), (~a~ IFF ~b~), or (~a~ AND NOT ~b~), where ~b~ is the matching bit
+		//   of <rhs>, then returns <this>
+		BitSet& operator&=(const BitSet& rhs);
+		BitSet& operator|=(const BitSet& rhs);
+		BitSet& operator^=(const BitSet& rhs);
+		BitSet& implies(const BitSet& rhs);
+		BitSet& iff(const BitSet& rhs);
+		BitSet& andNot(const BitSet& rhs);
+
+		// [Intersection Counter]
+		// REQUIRES: <lhs> and <rhs> have the same size
+		// EFFECTS:  returns the number of bits set in both <lhs> and <rhs>, without building
+		//   their intersection
+		static size_t countAnd(const BitSet& lhs, const BitSet& rhs);
+
+		// [Equality Operators]
+		// EFFECTS:  returns TRUE if <this> and <rhs> have the same size and the same bits set,
+		//   and returns FALSE otherwise; returns the opposite for the inequality operator
+		bool operator==(const BitSet& rhs) const;
+		bool operator!=(const BitSet& rhs) const;
+
+	private:
+		std::vector<word_t> words;
+		size_t length;
+
+		// [Tail Clearer]
+		// MODIFIES: <this>
+		// EFFECTS:  clears the bits of the final word that lie past <size()>
+		void clearTail();
+};
+
+#endif
\ No newline at end of file
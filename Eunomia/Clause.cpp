@@ -1,16 +1,23 @@
 #include "Assignment.h"											// for Assignment
+#include "BitSet.h"												// for BitSet
 #include "Clause.h"												// for Clause
-#include "Utility.h"											// for Operator_e
+#include "Utility.h"											// for Operator_e, VarStatus_e, ExpressionNode
 #include <cassert>												// for assert
 #include <iostream>												// for ostream
-#include <memory>												// for unique_ptr
+#include <memory>												// for unique_ptr, make_unique
 #include <string>												// for string
 #include <utility>												// for move
+#include <vector>												// for vector
 
 using std::ostream;
 using std::string;
-using std::unique_ptr;
+using std::unique_ptr; using std::make_unique;
 using std::move;
+using std::vector;
+
+
+// EFFECTS:  returns the three-valued evaluation that is known to be <value>
+VarStatus_e statusOf(bool value);
 
 
 // constructor
@@ -99,6 +106,119 @@ bool Clause::evaluate(const Assignment& assign) const {
 	}
 }
 
+// evaluate both sides column-wise, then combine the results a word at a time with <op>,
+// flipping the combination if negated (short-circuiting is not possible for columns)
+BitSet Clause::evaluate(const vector<BitSet>& columns) const {
+	BitSet result = leftExpr->evaluate(columns);
+	BitSet rightEval = rightExpr->evaluate(columns);
+
+	switch (op) {
+		case Operator_e::And:
+			result &= rightEval;
+			break;
+		case Operator_e::Or:
+			result |= rightEval;
+			break;
+		case Operator_e::Implies:
+			result.implies(rightEval);
+			break;
+		case Operator_e::Xor:
+			result ^= rightEval;
+			break;
+		case Operator_e::Iff:
+			result.iff(rightEval);
+			break;
+		default:
+			throw;												// this will never be reached; cases are exhaustive for Operator_e
+	}
+
+	if (negated) {
+		result.flip();
+	}
+	return result;
+}
+
+// evaluate the left-hand Expression and short-circuit if it alone settles <op>; if not,
+// evaluate the right-hand Expression and combine the two, where an unknown side leaves the
+// result unknown unless the other side settles it; negation flips a known result only
+VarStatus_e Clause::evaluate(const vector<VarStatus_e>& statuses) const {
+	VarStatus_e leftEval = leftExpr->evaluate(statuses);
+	VarStatus_e result;
+
+	switch (op) {
+		case Operator_e::And:
+			if (leftEval == VarStatus_e::False) {						// F and ? --> F
+				result = VarStatus_e::False;
+				break;
+			}
+			result = rightExpr->evaluate(statuses);
+			if (leftEval == VarStatus_e::Unknown && result == VarStatus_e::True) {		// U and T --> U
+				result = VarStatus_e::Unknown;
+			}
+			break;
+		case Operator_e::Or:
+			if (leftEval == VarStatus_e::True) {						// T or ? --> T
+				result = VarStatus_e::True;
+				break;
+			}
+			result = rightExpr->evaluate(statuses);
+			if (leftEval == VarStatus_e::Unknown && result == VarStatus_e::False) {		// U or F --> U
+				result = VarStatus_e::Unknown;
+			}
+			break;
+		case Operator_e::Implies:
+			if (leftEval == VarStatus_e::False) {						// F imp. ? --> T
+				result = VarStatus_e::True;
+				break;
+			}
+			result = rightExpr->evaluate(statuses);
+			if (leftEval == VarStatus_e::Unknown && result == VarStatus_e::False) {		// U imp. F --> U
+				result = VarStatus_e::Unknown;
+			}
+			break;
+		case Operator_e::Xor:
+		case Operator_e::Iff: {
+			if (leftEval == VarStatus_e::Unknown) {						// U xor ? --> U, U iff ? --> U
+				result = VarStatus_e::Unknown;
+				break;
+			}
+			VarStatus_e rightEval = rightExpr->evaluate(statuses);
+			if (rightEval == VarStatus_e::Unknown) {
+				result = VarStatus_e::Unknown;
+				break;
+			}
+			result = statusOf((leftEval != rightEval) == (op == Operator_e::Xor));
+			break;
+		}
+		default:
+			throw;												// this will never be reached; cases are exhaustive for Operator_e
+	}
+
+	if (negated && result != VarStatus_e::Unknown) {
+		result = statusOf(result == VarStatus_e::False);
+	}
+	return result;
+}
+
+// clone both sides into a new Clause with the same operator and negation
+unique_ptr<Expression> Clause::clone() const {
+	return make_unique<Clause>(leftExpr->clone(), rightExpr->clone(), op, negated);
+}
+
+// collect the variables of the left-hand Expression, then the right-hand one
+void Clause::collectVariables(vector<int>& vars) const {
+	leftExpr->collectVariables(vars);
+	rightExpr->collectVariables(vars);
+}
+
+// flatten the left-hand Expression, then the right-hand one, then add the node joining them
+size_t Clause::flatten(vector<ExpressionNode>& nodes) const {
+	size_t left = leftExpr->flatten(nodes);
+	size_t right = rightExpr->flatten(nodes);
+	nodes.push_back(ExpressionNode{ false, negated, -1, op, left, right });
+	return nodes.size() - 1;
+}
+
 // if not negated, print "(<leftExpr> AND <rightExpr>)"
 // if negated, print "(NOT<leftExpr> OR NOT<rightExpr>)"
 void Clause::printAnd(ostream& os) const {
@@ -218,4 +338,9 @@ void Clause::print(std::ostream& os) const {
 		default:
 			throw;												// this will never be reached; cases are exhaustive for Operator_e
 	}
+}
+
+// TRUE or FALSE, never unknown
+VarStatus_e statusOf(bool value) {
+	return (value ? VarStatus_e::True : VarStatus_e::False);
 }
\ No newline at end of file
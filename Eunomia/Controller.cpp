@@ -8,6 +8,7 @@
 #include "Puzzle.h"
 #include "SummaryView.h"
 #include "Utility.h"
+#include <cctype>
 #include <exception>
 #include <fstream>
 #include <iostream>
@@ -17,6 +18,7 @@
 #include <vector>
 
 using std::unique_ptr; using std::invalid_argument;
+using std::isspace;
 using std::cin; using std::getline; using std::ifstream;
 using std::vector; using std::string;
 using std::move;
@@ -37,6 +39,10 @@ unique_ptr<Parser> buildParser(const Puzzle& puzzle);
 // EFFECTS:  prompts the user for a name and <itemsPer> items to build a new Category
 Category readCategory(int catIdx, int itemsPer);
 
+// EFFECTS:  returns <line> without any leading whitespace and without the clue-number label
+//   (such as "(#12)") that may precede the clue, along with any whitespace following it
+string stripClueLabel(const string& line);
+
 
 // prompt user for puzzle info and build puzzle
 Controller::Controller()
@@ -97,12 +103,42 @@ Controller::Controller(const char* fileName)
     }
     parser = unique_ptr<Parser>{ new Parser{ parseStrings.cbegin(), parseStrings.cend() } };
 
+    vector<string> clueStrings{};
+    string line;
+    while (getline(is, line)) {
+        string clueStr = stripClueLabel(line);
+        if (clueStr != "") {
+            clueStrings.push_back(clueStr);
+        }
+    }
+
+    if (!clueStrings.empty()) {
+        eout << "\t" << "Applying " << clueStrings.size() << " initial clues . . ." << endl;
+
+        vector<unique_ptr<Expression>> clues{};
+        vector<const Expression*> batch{};
+        clues.reserve(clueStrings.size());
+        batch.reserve(clueStrings.size());
+        for (const auto& clueStr : clueStrings) {
+            clues.push_back(parser->parse(clueStr));
+            batch.push_back(clues.back().get());
+        }
+
+        auto results = puzzle->applyClues(batch);
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (!results[i]) {
+                eout << "\t\t" << "Clue '" << clueStrings[i] << "' is logically inconsistent with previous clues" << endl;
+            }
+        }
+    }
+
     eout << "Puzzle and praser completed!";
 
     init();
 }
 
-//
+// open the puzzle and its views, then drop the Controller's copy, which would
+// otherwise make the Model's copy clone the Engine the first time it changed
 void Controller::init() {
     Model::getInstance().openPuzzle(*puzzle, *parser);
 
@@ -112,6 +148,9 @@ void Controller::init() {
     Model::getInstance().attachView(move(grid));
     Model::getInstance().attachView(move(summary));
     puzzle->broadcastState();
+
+    puzzleName = puzzle->getName();
+    puzzle.reset();
 }
 
 // run the Controller
@@ -175,6 +214,25 @@ Category readCategory(int catIdx, int itemsPer) {
 	return Category{ name, items.cbegin(), items.cend() };
 }
 
+// skip leading whitespace, then a "(#...)" label if there is one, then the whitespace after it
+string stripClueLabel(const string& line) {
+	size_t pos = 0;
+	while (pos < line.length() && isspace(static_cast<unsigned char>(line[pos]))) {
+		++pos;
+	}
+
+	if (line.compare(pos, 2, "(#") == 0) {
+		size_t close = line.find(')', pos);
+		if (close != string::npos) {
+			pos = close + 1;
+			while (pos < line.length() && isspace(static_cast<unsigned char>(line[pos]))) {
+				++pos;
+			}
+		}
+	}
+	return line.substr(pos);
+}
+
 // build parser
 unique_ptr<Parser> buildParser(const Puzzle& puzzle) {
 	auto categories = puzzle.numCategories();
@@ -227,6 +285,10 @@ bool Controller::readCommand() {
 		case 'S':
 			printSummary();
 			return true;
+		case 'u':
+		case 'U':
+			undoClues();
+			return true;
 		default:
 			throw EunomiaException{ "Invalid command" };
 	}
@@ -240,11 +302,23 @@ void Controller::evaluateClue() {
     eout << "Enter Clue:  ";
 	getline(cin, clue);
 
-    if (!Model::getInstance().assess(puzzle->getName(), clue)) {
+    if (!Model::getInstance().assess(puzzleName, clue)) {
         eout << "This clue is logically inconsistent with previous clues" << endl;
     }
 }
 
+// read a number of clues and undo that many
+void Controller::undoClues() {
+	eout << "Number of Clues to Undo:  ";
+	int count = readInt(cin);
+	if (count < 0) {
+		throw EunomiaException{ "Invalid number of clues" };
+	}
+
+	size_t undone = Model::getInstance().undo(puzzleName, count);
+	eout << "Undid " << undone << " clue" << (undone == 1 ? "" : "s") << endl;
+}
+
 // print the grid view
 void Controller::printGrid() const {
 	Model::getInstance().displayView("Grid");
@@ -2,6 +2,7 @@
 #define EUNOMIA_CONTROLLER
 
 #include <memory>												// for unique_ptr
+#include <string>												// for string
 #include "Parser.h"												// because Parser is a template parameter
 #include "Puzzle.h"												// because Puzzle is a template parameter
 
@@ -15,7 +16,9 @@ class Controller {
         // REQUIRES: <fileName> is a valid text file name with properly-formatted content
 		// MODIFIES: standard input, standard output
 		// EFFECTS:  prompts the user for metadata concerning the logic puzzle and then reads
-		//   from standard input to construct the puzzle
+		//   from standard input to construct the puzzle; when reading from <fileName>, any
+		//   clues that follow the parse strings are applied to the puzzle as a single batch,
+		//   and those that are logically inconsistent are reported
 		Controller();
         Controller(const char* fileName);
 
@@ -28,8 +31,11 @@ class Controller {
 	private:
 		std::unique_ptr<Puzzle> puzzle;
 		std::unique_ptr<Parser> parser;
+		std::string puzzleName;
 
-        //
+        // MODIFIES: <Model> Singleton instance, <this>
+        // EFFECTS:  opens <puzzle> on the Model along with its Views, then lets go of <puzzle>
+        //   so that the Model's copy is the only one holding its Engine
         void init();
 
 		// MODIFIES: standard input, standard output, <this>
@@ -42,6 +48,11 @@ class Controller {
 		//   clue to <puzzle>
 		void evaluateClue();
 
+		// MODIFIES: standard input, standard output, <this>
+		// EFFECTS:  reads a number of clues from standard input and undoes that many of the most
+		//   recent consistent clues applied to <puzzle>, or all of them if there are fewer
+		void undoClues();
+
 		// MODIFIES: standard output
 		// EFFECTS:  prints <grid> to standard output
 		void printGrid() const;
@@ -0,0 +1,347 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for survivorSlices(), enumerateSurvivorSlices(), consistentClues(), encodeRank(), decodeRank(), permutationsCrossSize()
+#include "BitSet.h"												// for BitSet
+#include "DenseStore.h"											// for DenseStore
+#include "Expression.h"											// for Expression
+#include "ProjectionMemo.h"										// for ProjectionMemo
+#include "RankSet.h"											// for RankSet
+#include "RankedStore.h"										// for RankedStore
+#include "Utility.h"											// for Storage_e
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for min, move, remove_if
+#include <cassert>												// for assert
+#include <cstdint>												// for uint64_t
+#include <iterator>												// for make_move_iterator
+#include <memory>												// for unique_ptr, make_unique
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::vector;
+using std::min; using std::move; using std::remove_if;
+using std::uint64_t;
+using std::make_move_iterator;
+using std::unique_ptr; using std::make_unique;
+
+// the fewest Assignments worth handing to one task of the WorkerPool when tallying, and
+// the fewest variables worth handing to one when merging the count deltas of the shards
+constexpr size_t kTallyGrain = 4096;
+constexpr size_t kMergeGrain = 16;
+
+
+// constructor; every possible solution survives an empty batch of clues
+DenseStore::DenseStore(size_t numCategories, size_t itemsPerCategory)
+	: DenseStore{ numCategories, itemsPerCategory, vector<const Expression*>{} } {}
+
+// constructor with an initial batch of clues; only the survivors are ever materialized, each
+// slice into a list of its own, and the lists are then moved into <assignments> in order of
+// slice (and so in order of rank), each freed as soon as it has been moved
+DenseStore::DenseStore(size_t numCategories, size_t itemsPerCategory, const vector<const Expression*>& clues)
+	: categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+
+	vector<vector<Assignment>> sliceAssignments(survivorSlices(numCategories, itemsPerCategory));
+	enumerateSurvivorSlices(numCategories, itemsPerCategory, clues,
+		[&sliceAssignments](size_t slice, size_t, const Assignment& assign) {
+			sliceAssignments[slice].push_back(assign);
+		}
+	);
+
+	size_t total = 0;
+	for (const auto& part : sliceAssignments) {
+		total += part.size();
+	}
+	assignments.reserve(total);
+	for (auto& part : sliceAssignments) {
+		assignments.insert(assignments.end(), make_move_iterator(part.begin()), make_move_iterator(part.end()));
+		vector<Assignment>{}.swap(part);
+	}
+}
+
+// return the number of Assignments remaining in <assignments>
+size_t DenseStore::size() const {
+	return assignments.size();
+}
+
+// for each Assignment in <assignments>, increment the count of each variable
+// that is TRUE; each task of the WorkerPool counts a contiguous run of Assignments
+// into counts of its own, which are added into <counts> once every task has finished
+void DenseStore::tally(vector<long long>& counts) const {
+	auto& pool = WorkerPool::getInstance();
+	size_t numAssigns = assignments.size();
+	size_t tasks = pool.tasksFor(numAssigns, kTallyGrain);
+	vector<vector<long long>> taskCounts(tasks, vector<long long>(counts.size(), 0));
+	pool.run(tasks, [&](size_t task) {
+		auto& mine = taskCounts[task];
+		size_t last = numAssigns * (task + 1) / tasks;
+		for (size_t i = numAssigns * task / tasks; i < last; ++i) {
+			auto end = assignments[i].trueEnd();
+			for (auto begin = assignments[i].trueBegin(); begin != end; ++begin) {
+				++mine[*begin];
+			}
+		}
+	});
+
+	size_t numVars = counts.size();
+	for (const auto& mine : taskCounts) {
+		for (size_t v = 0; v < numVars; ++v) {
+			counts[v] += mine[v];
+		}
+	}
+}
+
+// evaluate <clue> against every Assignment remaining in <assignments> and
+// remove those for which <clue> evaluates to FALSE; for each such removed
+// Assignment, decrement the counts of all variables set to TRUE by 1;
+// return TRUE if <clue> is consistent (i.e. doesn't evaluate to FALSE for
+// all active Assignments) and return FALSE otherwise
+bool DenseStore::filter(const Expression& clue, vector<long long>& counts) {
+	size_t numAssigns = assignments.size();
+	BitSet shouldRemove{ numAssigns };									// set if assignments[i] causes FALSE evaluation
+	vector<long long> removedCounts(counts.size(), 0);
+
+	ProjectionMemo memo{ clue, numAssigns };
+	size_t totalToRemove = mark([&](size_t i) { return !memo.evaluate(assignments[i]); }, &shouldRemove, removedCounts);
+	if (totalToRemove == numAssigns) {									// would remove everything, indicating logical inconsistency
+		return false;
+	}
+	erase(move(shouldRemove), totalToRemove, move(removedCounts), counts);
+	return true;
+}
+
+// evaluate each group of up to <kFusedClues> clues against every Assignment at once, each
+// shard of <assignments> in a task of the WorkerPool, recording for each Assignment a mask
+// of the clues for which it is FALSE; once the consistent clues are known, erase the
+// Assignments that each of them fails in turn, keeping the masks in step with <assignments>,
+// so that an Assignment still present when a clue is reached fails no earlier kept clue
+vector<bool> DenseStore::filterAll(const vector<const Expression*>& clues, vector<long long>& counts) {
+	auto& pool = WorkerPool::getInstance();
+	vector<bool> results;
+	results.reserve(clues.size());
+
+	for (size_t first = 0; first < clues.size(); first += kFusedClues) {
+		size_t numClues = min(kFusedClues, clues.size() - first);
+		size_t numAssigns = assignments.size();
+		size_t numShards = (numAssigns + kShardSize - 1) / kShardSize;
+		vector<uint64_t> failures(numAssigns, 0);
+		vector<ProjectionMemo> memos;
+		memos.reserve(numClues);
+		for (size_t k = 0; k < numClues; ++k) {
+			memos.emplace_back(*clues[first + k], numAssigns);
+		}
+		pool.run(numShards, [&](size_t shard) {
+			size_t last = min((shard + 1) * kShardSize, numAssigns);
+			for (size_t i = shard * kShardSize; i < last; ++i) {
+				for (size_t k = 0; k < numClues; ++k) {
+					if (!memos[k].evaluate(assignments[i])) {
+						failures[i] |= uint64_t{ 1 } << k;
+					}
+				}
+			}
+		});
+
+		uint64_t consistent = consistentClues(failures, numClues);
+		for (size_t k = 0; k < numClues; ++k) {
+			uint64_t bit = uint64_t{ 1 } << k;
+			results.push_back((consistent & bit) != 0);
+			if ((consistent & bit) == 0) {
+				continue;
+			}
+
+			BitSet shouldRemove{ assignments.size() };
+			vector<long long> removedCounts(counts.size(), 0);
+			size_t totalToRemove = mark([&](size_t i) { return (failures[i] & bit) != 0; }, &shouldRemove, removedCounts);
+			if (totalToRemove > 0) {
+				failures.erase(remove_if(failures.begin(), failures.end(), [bit](uint64_t mask) { return (mask & bit) != 0; }),
+					failures.end());
+			}
+			erase(move(shouldRemove), totalToRemove, move(removedCounts), counts);
+		}
+	}
+	return results;
+}
+
+// mark without a BitSet to mark in
+size_t DenseStore::probe(const Expression& clue, vector<long long>& removedCounts) const {
+	ProjectionMemo memo{ clue, assignments.size() };
+	return mark([&](size_t i) { return !memo.evaluate(assignments[i]); }, nullptr, removedCounts);
+}
+
+// return the number of checkpoints
+size_t DenseStore::checkpoints() const {
+	return history.size();
+}
+
+// walk the positions held before the last filter, decoding each from the next erased
+// rank if it was erased and taking it from <assignments> otherwise, so that the
+// Assignments end up in exactly the order they were in before it
+void DenseStore::undo(vector<long long>& counts) {
+	assert(!history.empty());
+
+	auto& checkpoint = history.back();
+	if (!checkpoint.erased.empty()) {
+		size_t total = assignments.size() + checkpoint.erased.size();
+		vector<Assignment> merged;
+		merged.reserve(total);
+		auto kept = assignments.begin();
+		auto erased = checkpoint.erased.cbegin();
+		vector<int> scratch;
+		for (size_t i = 0; i < total; ++i) {
+			if (checkpoint.erasedAt.test(i)) {
+				merged.push_back(decodeRank(*erased++, categories, itemsPer, scratch));
+			}
+			else {
+				merged.push_back(move(*kept++));
+			}
+		}
+		assignments = move(merged);
+
+		size_t numVars = counts.size();
+		for (size_t v = 0; v < numVars; ++v) {
+			counts[v] += checkpoint.removedCounts[v];
+		}
+	}
+	history.pop_back();
+}
+
+// the survivors are held in order of rank, which is the cheapest order in which to add them
+// to a RankSet, as are the erased Assignments of each checkpoint; the checkpoints are adopted
+// oldest first, each keeping its counts as they are
+unique_ptr<AssignmentStore> DenseStore::compact() {
+	size_t total = permutationsCrossSize(categories - 1, itemsPer);
+	RankSet ranks{ total };
+	for (const auto& assign : assignments) {
+		ranks.set(encodeRank(assign, categories, itemsPer));
+	}
+
+	auto ranked = make_unique<RankedStore>(categories, itemsPer, move(ranks));
+	for (auto& checkpoint : history) {
+		RankSet removed{ checkpoint.erased.empty() ? 0 : total };
+		for (auto rank : checkpoint.erased) {
+			removed.set(rank);
+		}
+		ranked->adopt(move(removed), move(checkpoint.removedCounts));
+	}
+	ranked->compact();
+	return ranked;
+}
+
+// a DenseStore
+Storage_e DenseStore::kind() const {
+	return Storage_e::Dense;
+}
+
+// copy <this> into a new DenseStore
+unique_ptr<AssignmentStore> DenseStore::clone() const {
+	return make_unique<DenseStore>(*this);
+}
+
+// each shard of <assignments> is tested by a task of the WorkerPool that marks its own
+// removals and totals its own count deltas, and the deltas are merged once all are done
+template <typename Predicate>
+size_t DenseStore::mark(Predicate fails, BitSet* marks, vector<long long>& removedCounts) const {
+	static_assert(kShardSize % BitSet::kWordBits == 0, "shards must not share words of a BitSet");
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numAssigns = assignments.size();
+	size_t numVars = removedCounts.size();
+	size_t numShards = (numAssigns + kShardSize - 1) / kShardSize;
+	vector<size_t> shardRemoved(numShards, 0);
+	vector<vector<long long>> shardDeltas(numShards);					// left empty by a shard that removes nothing
+
+	pool.run(numShards, [&](size_t shard) {
+		size_t last = min((shard + 1) * kShardSize, numAssigns);
+		for (size_t i = shard * kShardSize; i < last; ++i) {
+			if (fails(i)) {												// FALSE evaluation
+				if (marks) {											//   so should remove this Assignment
+					marks->set(i);
+				}
+				++shardRemoved[shard];
+
+				auto& deltas = shardDeltas[shard];
+				if (deltas.empty()) {
+					deltas.assign(numVars, 0);
+				}
+				auto end = assignments[i].trueEnd();
+				for (auto begin = assignments[i].trueBegin(); begin != end; ++begin) {
+					++deltas[*begin];
+				}
+			}
+		}
+	});
+
+	size_t removed = 0;
+	for (auto shardCount : shardRemoved) {
+		removed += shardCount;
+	}
+	if (removed == 0) {													// nothing to merge
+		return 0;
+	}
+
+	size_t mergeTasks = pool.tasksFor(numVars, kMergeGrain);
+	pool.run(mergeTasks, [&](size_t task) {
+		size_t last = numVars * (task + 1) / mergeTasks;
+		for (size_t v = numVars * task / mergeTasks; v < last; ++v) {
+			for (const auto& deltas : shardDeltas) {
+				if (!deltas.empty()) {
+					removedCounts[v] += deltas[v];
+				}
+			}
+		}
+	});
+	return removed;
+}
+
+// each shard encodes the ranks of its removed Assignments and compacts itself in place, the
+// shards are slid together, and the removed ranks are kept in order as a checkpoint
+void DenseStore::erase(BitSet&& shouldRemove, size_t totalToRemove, vector<long long>&& removedCounts,
+	vector<long long>& counts) {
+
+	assert(totalToRemove < assignments.size());
+	if (totalToRemove == 0) {											// nothing removed, so nothing to change
+		history.push_back(Checkpoint{ BitSet{}, {}, {} });
+		return;
+	}
+
+	size_t numVars = counts.size();
+	for (size_t v = 0; v < numVars; ++v) {								// decrement counts for TRUE variables
+		counts[v] -= removedCounts[v];
+	}
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numAssigns = assignments.size();
+	size_t numShards = (numAssigns + kShardSize - 1) / kShardSize;
+	vector<vector<size_t>> shardErased(numShards);
+	vector<size_t> shardKept(numShards);
+	pool.run(numShards, [&](size_t shard) {
+		auto& erased = shardErased[shard];
+		size_t first = shard * kShardSize;
+		size_t last = min(first + kShardSize, numAssigns);
+		size_t kept = first;
+		for (size_t i = first; i < last; ++i) {
+			if (shouldRemove.test(i)) {
+				erased.push_back(encodeRank(assignments[i], categories, itemsPer));
+			}
+			else {
+				if (kept != i) {
+					assignments[kept] = move(assignments[i]);
+				}
+				++kept;
+			}
+		}
+		shardKept[shard] = kept - first;
+	});
+
+	Checkpoint checkpoint{ move(shouldRemove), {}, move(removedCounts) };
+	checkpoint.erased.reserve(totalToRemove);
+	auto kept = assignments.begin();
+	for (size_t shard = 0; shard < numShards; ++shard) {
+		auto first = assignments.begin() + shard * kShardSize;
+		kept = (first == kept ? kept + shardKept[shard] : move(first, first + shardKept[shard], kept));
+		checkpoint.erased.insert(checkpoint.erased.end(), shardErased[shard].cbegin(), shardErased[shard].cend());
+		vector<size_t>{}.swap(shardErased[shard]);
+	}
+	assignments.erase(kept, assignments.end());
+	history.push_back(move(checkpoint));
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#ifndef EUNOMIA_DENSE_STORE
+#define EUNOMIA_DENSE_STORE
+
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "Assignment.h"											// for Assignment (because it's a template parameter)
+#include "AssignmentStore.h"									// for AssignmentStore
+#include "BitSet.h"												// for BitSet (because it's a template parameter)
+
+class Expression;
+
+/*
+	A DenseStore is a kind of AssignmentStore that materializes every viable Assignment as its own object,
+	all of them held contiguously. A clue is evaluated by running the tree-based evaluator of the clue once
+	for each viable Assignment, through a ProjectionMemo, so that a large clue is evaluated only once for
+	each distinct projection of the viable Assignments onto its variables. The Assignments that a clue
+	eliminates are erased from the container, so that later clues only ever visit the survivors. A batch of
+	clues is evaluated against each Assignment in turn, up to <kFusedClues> of them at a time, so that every
+	Assignment is read once per batch rather than once per clue; which clues are consistent is then settled
+	from the failures recorded for each Assignment, and the Assignments are erased clue by clue without
+	evaluating anything again. Each successful filter keeps only the ranks of the Assignments it erased, in
+	order, along with a BitSet marking where each one stood, so that undoing it decodes them and merges them
+	back into place; the undo history thus takes up a fraction of the room of the Assignments that it
+	records. Erasing leaves the container as large as it ever was, so compacting a DenseStore instead hands
+	back a RankedStore holding the ranks of its survivors and of its checkpoints, which are decoded whenever
+	they are needed.
+*/
+
+class DenseStore : public AssignmentStore {
+	public:
+		// [Constructors]
+		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, each variable that
+		//   forms part of each of <clues> is a variable of a Puzzle with those dimensions
+		// EFFECTS:  constructs <this> holding every possible solution, or only those for which
+		//   every one of <clues> evaluates to TRUE
+		DenseStore(size_t numCategories, size_t itemsPerCategory);
+		DenseStore(size_t numCategories, size_t itemsPerCategory, const std::vector<const Expression*>& clues);
+
+		// [Size Accessor]
+		// EFFECTS:  returns the number of Assignments that remain viable in <this>
+		size_t size() const override;
+
+		// [Count Tallier]
+		// REQUIRES: <counts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <counts>
+		// EFFECTS:  adds to each element of <counts> the number of viable Assignments in <this>
+		//   in which the corresponding variable is TRUE
+		void tally(std::vector<long long>& counts) const override;
+
+		// [Clue Filter]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  removes each viable Assignment for which <clue> evaluates to FALSE, updating
+		//   <counts> so that its elements remain accurate, and returns TRUE; if every viable
+		//   Assignment would be removed, makes no changes whatsoever and returns FALSE
+		bool filter(const Expression& clue, std::vector<long long>& counts) override;
+
+		// [Batch Filter]
+		// REQUIRES: each variable that forms part of each of <clues> is a variable of the Assignments
+		//   of <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  filters <this> by each of <clues> in order exactly as <filter()> would, leaving
+		//   a checkpoint for each successful filter, and returns a list with one element per clue
+		//   that is TRUE if and only if that filter was successful
+		std::vector<bool> filterAll(const std::vector<const Expression*>& clues, std::vector<long long>& counts) override;
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, <removedCounts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <removedCounts>
+		// EFFECTS:  returns the number of viable Assignments for which <clue> evaluates to FALSE and
+		//   adds to each element of <removedCounts> the number of those in which the corresponding
+		//   variable is TRUE, without changing <this>
+		size_t probe(const Expression& clue, std::vector<long long>& removedCounts) const override;
+
+		// [Checkpoint Accessor]
+		// EFFECTS:  returns the number of successful filters of <this> that have not been undone
+		size_t checkpoints() const override;
+
+		// [Filter Undoer]
+		// REQUIRES: <checkpoints()> is positive, each element of <counts> is the number of viable
+		//   Assignments of <this> in which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  restores each Assignment removed by the most recent successful filter of <this>
+		//   that has not been undone, updating <counts> so that its elements remain accurate
+		void undo(std::vector<long long>& counts) override;
+
+		// [Memory Releaser]
+		// MODIFIES: <this>
+		// EFFECTS:  returns a new RankedStore holding the same viable Assignments and checkpoints
+		//   as <this>, each by rank, which is to take the place of <this>
+		std::unique_ptr<AssignmentStore> compact() override;
+
+		// [Kind Accessor]
+		// EFFECTS:  returns Storage_e::Dense
+		Storage_e kind() const override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new DenseStore holding the same viable Assignments as <this>
+		std::unique_ptr<AssignmentStore> clone() const override;
+
+	private:
+		/*
+			A Checkpoint records a successful filter: which of the Assignments held just before
+			it were erased, the ranks of the erased Assignments in their original order, and the
+			amount by which it lowered the count of each variable.
+		*/
+		struct Checkpoint {
+			BitSet erasedAt;
+			std::vector<size_t> erased;
+			std::vector<long long> removedCounts;
+		};
+
+		std::vector<Assignment> assignments;
+		int categories;
+		int itemsPer;
+		std::vector<Checkpoint> history;
+
+		// [Removal Marker]
+		// REQUIRES: <marks> is either null or has one clear bit for each element of <assignments>,
+		//   <removedCounts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <marks>, <removedCounts>
+		// EFFECTS:  returns the number of positions ~i~ in <assignments> for which <fails(i)> is TRUE
+		//   and adds to each element of <removedCounts> the number of those Assignments in which the
+		//   corresponding variable is TRUE, setting the bit of <marks> at each of those positions if
+		//   <marks> is not null
+		template <typename Predicate>
+		size_t mark(Predicate fails, BitSet* marks, std::vector<long long>& removedCounts) const;
+
+		// [Eraser]
+		// REQUIRES: <shouldRemove> has one bit for each element of <assignments>, of which
+		//   <totalToRemove> are set, fewer than all of them; <removedCounts> is as returned by
+		//   <mark()> for <shouldRemove>; each element of <counts> is the number of viable
+		//   Assignments of <this> in which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  erases the Assignments marked in <shouldRemove>, updating <counts> so that its
+		//   elements remain accurate, and keeps a checkpoint of them
+		void erase(BitSet&& shouldRemove, size_t totalToRemove, std::vector<long long>&& removedCounts,
+			std::vector<long long>& counts);
+};
+
+#endif
\ No newline at end of file
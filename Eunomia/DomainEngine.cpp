@@ -0,0 +1,473 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for variableIndex()
+#include "DomainEngine.h"										// for DomainEngine
+#include "Engine.h"												// for Engine
+#include "Expression.h"											// for Expression
+#include "Utility.h"											// for VarStatus_e, variablesNeeded()
+#include <algorithm>											// for sort, unique
+#include <bit>													// for popcount, countr_zero, has_single_bit
+#include <cassert>												// for assert
+#include <memory>												// for unique_ptr, make_unique, shared_ptr
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::vector;
+using std::sort; using std::unique;
+using std::popcount; using std::countr_zero; using std::has_single_bit;
+using std::unique_ptr; using std::make_unique; using std::shared_ptr;
+using std::move;
+
+// the most undecided variables for which a clue is checked by trying every combination of values
+const size_t kMaxOpen = 8;
+
+
+// constructor; every item may belong to every group, and every variable is unknown
+DomainEngine::DomainEngine(size_t numCategories, size_t itemsPerCategory)
+	: categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) },
+	pairings(variablesNeeded(numCategories, itemsPerCategory)),
+	statuses(pairings.size(), VarStatus_e::Unknown), unknowns{ pairings.size() }, changes{},
+	root{ vector<Domain_t>((numCategories - 1) * itemsPerCategory, ~Domain_t{ 0 } >> (64 - itemsPerCategory)),
+		vector<VarStatus_e>(pairings.size(), VarStatus_e::Unknown) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2 && itemsPerCategory <= 64);
+
+	for (int catA = 0; catA < categories; ++catA) {
+		for (int catB = catA + 1; catB < categories; ++catB) {
+			for (int itemA = 0; itemA < itemsPer; ++itemA) {
+				for (int itemB = 0; itemB < itemsPer; ++itemB) {
+					int var = variableIndex(catA, itemA, catB, itemB, categories, itemsPer);
+					pairings[var] = Pairing{ catA, itemA, catB, itemB };
+				}
+			}
+		}
+	}
+}
+
+// return the status recorded after the last consistent clue
+VarStatus_e DomainEngine::getStatus(int varIndex) const {
+	assert(varIndex >= 0 && varIndex < static_cast<int>(statuses.size()));
+	return statuses[varIndex];
+}
+
+// solved once no variable is unknown
+bool DomainEngine::solved() const {
+	return (unknowns == 0);
+}
+
+// keep <clue> only if some solution satisfies it along with every earlier clue; then, for
+// each unknown variable, look for a solution giving it each value not yet witnessed, and
+// force every variable whose status becomes known in <root>, keeping the old <root> and
+// those variables as a checkpoint
+bool DomainEngine::evaluateClue(const Expression& clue) {
+	Constraint added{ shared_ptr<const Expression>{ clue.clone() }, {} };
+	clue.collectVariables(added.support);
+	sort(added.support.begin(), added.support.end());
+	added.support.erase(unique(added.support.begin(), added.support.end()), added.support.end());
+	constraints.push_back(move(added));
+
+	size_t numVars = pairings.size();
+	Assignment scratch{ numVars };
+	Region solution{ root };
+	if (!search(solution, scratch)) {									// no solution left, indicating logical inconsistency
+		constraints.pop_back();
+		return false;
+	}
+
+	vector<bool> seenTrue(numVars, false);
+	vector<bool> seenFalse(numVars, false);
+	witness(solution, seenTrue, seenFalse);
+
+	Checkpoint checkpoint{ root, {} };
+
+	for (size_t v = 0; v < numVars; ++v) {
+		if (statuses[v] != VarStatus_e::Unknown) {
+			continue;
+		}
+
+		for (bool value : { true, false }) {
+			if (value ? seenTrue[v] : seenFalse[v]) {
+				continue;
+			}
+			Region probe{ root };
+			probe.forced[v] = (value ? VarStatus_e::True : VarStatus_e::False);
+			if (search(probe, scratch)) {
+				witness(probe, seenTrue, seenFalse);
+			}
+		}
+
+		if (!seenFalse[v] || !seenTrue[v]) {
+			statuses[v] = (seenTrue[v] ? VarStatus_e::True : VarStatus_e::False);
+			root.forced[v] = statuses[v];
+			changes.push_back(static_cast<int>(v));
+			checkpoint.settled.push_back(static_cast<int>(v));
+			--unknowns;
+		}
+	}
+
+	bool rootConsistent = narrow(root);
+	assert(rootConsistent);
+	history.push_back(move(checkpoint));
+	return true;
+}
+
+// hand over the recorded changes, leaving none behind
+vector<int> DomainEngine::takeChanges() {
+	vector<int> taken;
+	taken.swap(changes);
+	return taken;
+}
+
+// every kept clue has its own checkpoint
+size_t DomainEngine::undoableClues() const {
+	return constraints.size();
+}
+
+// restore the checkpoints of the last <count> clues, most recent first, making every variable
+// that each one settled unknown again, and forget the clues themselves
+void DomainEngine::undoClues(size_t count) {
+	assert(count <= undoableClues());
+
+	for (size_t k = 0; k < count; ++k) {
+		auto& checkpoint = history.back();
+		root = move(checkpoint.root);
+		for (int v : checkpoint.settled) {
+			statuses[v] = VarStatus_e::Unknown;
+			changes.push_back(v);
+			++unknowns;
+		}
+		history.pop_back();
+		constraints.pop_back();
+	}
+}
+
+// copy <this> into a new DomainEngine, sharing the evaluated clues
+unique_ptr<Engine> DomainEngine::clone() const {
+	return make_unique<DomainEngine>(*this);
+}
+
+// domains are laid out Category by Category, starting from Category 1
+size_t DomainEngine::slot(int category, int group) const {
+	assert(category > 0 && category < categories);
+	assert(group >= 0 && group < itemsPer);
+	return static_cast<size_t>(category - 1) * itemsPer + group;
+}
+
+// the lower Category always comes first in <variableIndex()>
+int DomainEngine::pairingIndex(int cat1, int item1, int cat2, int item2) const {
+	assert(cat1 != cat2);
+	if (cat1 < cat2) {
+		return variableIndex(cat1, item1, cat2, item2, categories, itemsPer);
+	}
+	return variableIndex(cat2, item2, cat1, item1, categories, itemsPer);
+}
+
+// a pairing with Category 0 names its group outright, so only one domain matters; any other
+// pairing is possible if some group may hold both items, and certain if some group must
+VarStatus_e DomainEngine::deduce(const vector<Domain_t>& domains, int varIndex) const {
+	const auto& pair = pairings[varIndex];
+	Domain_t bitA = Domain_t{ 1 } << pair.itemA;
+	Domain_t bitB = Domain_t{ 1 } << pair.itemB;
+
+	if (pair.catA == 0) {
+		Domain_t dom = domains[slot(pair.catB, pair.itemA)];
+		if (!(dom & bitB)) {
+			return VarStatus_e::False;
+		}
+		return (dom == bitB ? VarStatus_e::True : VarStatus_e::Unknown);
+	}
+
+	bool possible = false;
+	for (int group = 0; group < itemsPer; ++group) {
+		Domain_t domA = domains[slot(pair.catA, group)];
+		Domain_t domB = domains[slot(pair.catB, group)];
+		if ((domA & bitA) && (domB & bitB)) {
+			if (domA == bitA && domB == bitB) {
+				return VarStatus_e::True;
+			}
+			possible = true;
+		}
+	}
+	return (possible ? VarStatus_e::Unknown : VarStatus_e::False);
+}
+
+// a forced value takes precedence; <narrow()> guarantees that the domains never disagree
+VarStatus_e DomainEngine::deduce(const Region& region, int varIndex) const {
+	if (region.forced[varIndex] != VarStatus_e::Unknown) {
+		return region.forced[varIndex];
+	}
+	return deduce(region.domains, varIndex);
+}
+
+// conflict only with a known opposite value
+bool DomainEngine::force(Region& region, int varIndex, VarStatus_e value, bool& changed) const {
+	assert(value != VarStatus_e::Unknown);
+
+	auto known = deduce(region, varIndex);
+	if (known != VarStatus_e::Unknown) {
+		return (known == value);
+	}
+	region.forced[varIndex] = value;
+	changed = true;
+	return true;
+}
+
+// alternate three passes until nothing changes: first make the domains respect each forced
+// value; then, for each Category, strike the items that already belong to a group from
+// every other group and pin each item that fits only one group to it; finally, for each
+// variable known to be TRUE, rule out every other partner of its two items and make every
+// third-Category item agree on whether it partners both of them
+bool DomainEngine::narrow(Region& region) const {
+	auto& domains = region.domains;
+	size_t numVars = pairings.size();
+
+	bool changed = true;
+	while (changed) {
+		changed = false;
+
+		for (size_t v = 0; v < numVars; ++v) {
+			auto forced = region.forced[v];
+			if (forced == VarStatus_e::Unknown) {
+				continue;
+			}
+			auto deduced = deduce(domains, static_cast<int>(v));
+			if (deduced != VarStatus_e::Unknown) {
+				if (deduced != forced) {
+					return false;
+				}
+				continue;
+			}
+
+			const auto& pair = pairings[v];
+			Domain_t bitA = Domain_t{ 1 } << pair.itemA;
+			Domain_t bitB = Domain_t{ 1 } << pair.itemB;
+			if (pair.catA == 0) {											// the group is known, so only its domain changes
+				auto& dom = domains[slot(pair.catB, pair.itemA)];
+				dom = (forced == VarStatus_e::True ? bitB : dom & ~bitB);
+				changed = true;
+				continue;
+			}
+
+			for (int group = 0; group < itemsPer; ++group) {
+				auto& domA = domains[slot(pair.catA, group)];
+				auto& domB = domains[slot(pair.catB, group)];
+				bool strikeA = false;
+				bool strikeB = false;
+				if (forced == VarStatus_e::True) {							// each item is possible only where the other is
+					strikeA = ((domA & bitA) && !(domB & bitB));
+					strikeB = ((domB & bitB) && !(domA & bitA));
+				}
+				else {														// neither item is possible where the other belongs
+					strikeA = ((domA & bitA) && domB == bitB);
+					strikeB = ((domB & bitB) && domA == bitA);
+				}
+
+				if (strikeA) {
+					domA &= ~bitA;
+				}
+				if (strikeB) {
+					domB &= ~bitB;
+				}
+				if (domA == 0 || domB == 0) {
+					return false;
+				}
+				changed = changed || strikeA || strikeB;
+			}
+		}
+
+		for (int cat = 1; cat < categories; ++cat) {
+			Domain_t pinned = 0;
+			for (int group = 0; group < itemsPer; ++group) {
+				Domain_t dom = domains[slot(cat, group)];
+				if (dom == 0 || (has_single_bit(dom) && (pinned & dom))) {		// empty, or two groups claim the same item
+					return false;
+				}
+				if (has_single_bit(dom)) {
+					pinned |= dom;
+				}
+			}
+
+			for (int group = 0; group < itemsPer; ++group) {
+				auto& dom = domains[slot(cat, group)];
+				if (!has_single_bit(dom) && (dom & pinned)) {
+					dom &= ~pinned;
+					if (dom == 0) {
+						return false;
+					}
+					changed = true;
+				}
+			}
+
+			for (int item = 0; item < itemsPer; ++item) {
+				Domain_t bit = Domain_t{ 1 } << item;
+				int fits = 0;
+				int lastGroup = 0;
+				for (int group = 0; group < itemsPer; ++group) {
+					if (domains[slot(cat, group)] & bit) {
+						++fits;
+						lastGroup = group;
+					}
+				}
+
+				if (fits == 0) {
+					return false;
+				}
+				auto& dom = domains[slot(cat, lastGroup)];
+				if (fits == 1 && dom != bit) {
+					dom = bit;
+					changed = true;
+				}
+			}
+		}
+
+		for (size_t v = 0; v < numVars; ++v) {
+			if (deduce(region, static_cast<int>(v)) != VarStatus_e::True) {
+				continue;
+			}
+
+			const auto& pair = pairings[v];
+			for (int other = 0; other < itemsPer; ++other) {
+				if (other != pair.itemB && !force(region, pairingIndex(pair.catA, pair.itemA, pair.catB, other), VarStatus_e::False, changed)) {
+					return false;
+				}
+				if (other != pair.itemA && !force(region, pairingIndex(pair.catA, other, pair.catB, pair.itemB), VarStatus_e::False, changed)) {
+					return false;
+				}
+			}
+
+			for (int cat = 0; cat < categories; ++cat) {
+				if (cat == pair.catA || cat == pair.catB) {
+					continue;
+				}
+				for (int item = 0; item < itemsPer; ++item) {
+					int viaA = pairingIndex(pair.catA, pair.itemA, cat, item);
+					int viaB = pairingIndex(pair.catB, pair.itemB, cat, item);
+					auto knownA = deduce(region, viaA);
+					auto knownB = deduce(region, viaB);
+					if (knownA != VarStatus_e::Unknown && !force(region, viaB, knownA, changed)) {
+						return false;
+					}
+					if (knownB != VarStatus_e::Unknown && !force(region, viaA, knownB, changed)) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+// fill <scratch> with the decided variables of each clue; a clue with few enough undecided
+// variables is tried under every combination of their values, and fails if none satisfies
+// it; an undecided variable with the same value in every satisfying combination is forced
+bool DomainEngine::enforce(Region& region, Assignment& scratch, bool& changed) const {
+	vector<int> open;
+	for (const auto& constraint : constraints) {
+		open.clear();
+		for (int var : constraint.support) {
+			switch (deduce(region, var)) {
+				case VarStatus_e::True:
+					scratch.setTrue(var);
+					break;
+				case VarStatus_e::False:
+					scratch.setFalse(var);
+					break;
+				case VarStatus_e::Unknown:
+					open.push_back(var);
+					break;
+				default:
+					throw;										// this will never be reached; cases are exhaustive for VarStatus_e
+			}
+		}
+		if (open.size() > kMaxOpen) {							// too many combinations to try; check again deeper in the search
+			continue;
+		}
+
+		size_t numOpen = open.size();
+		size_t combinations = size_t{ 1 } << numOpen;
+		size_t alwaysTrue = combinations - 1;					// bit ~i~ is set while <open[i]> is TRUE in every satisfying combination
+		size_t alwaysFalse = combinations - 1;					//   ...or FALSE in every satisfying combination
+		bool satisfiable = false;
+		for (size_t combo = 0; combo < combinations; ++combo) {
+			for (size_t i = 0; i < numOpen; ++i) {
+				if (combo & (size_t{ 1 } << i)) {
+					scratch.setTrue(open[i]);
+				}
+				else {
+					scratch.setFalse(open[i]);
+				}
+			}
+			if (constraint.clue->evaluate(scratch)) {
+				satisfiable = true;
+				alwaysTrue &= combo;
+				alwaysFalse &= ~combo;
+			}
+		}
+		if (!satisfiable) {
+			return false;
+		}
+
+		for (size_t i = 0; i < numOpen; ++i) {
+			size_t bit = size_t{ 1 } << i;
+			if (alwaysTrue & bit) {
+				region.forced[open[i]] = VarStatus_e::True;
+				changed = true;
+			}
+			else if (alwaysFalse & bit) {
+				region.forced[open[i]] = VarStatus_e::False;
+				changed = true;
+			}
+		}
+	}
+	return true;
+}
+
+// narrow and enforce until neither has anything left to do; if every domain is then down to
+// one item, <region> is a solution, and otherwise try each item of the undecided domain with
+// the fewest items in turn
+bool DomainEngine::search(Region& region, Assignment& scratch) const {
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		if (!narrow(region) || !enforce(region, scratch, changed)) {
+			return false;
+		}
+	}
+
+	size_t numDomains = region.domains.size();
+	size_t best = numDomains;
+	int bestWidth = itemsPer + 1;
+	for (size_t s = 0; s < numDomains; ++s) {
+		int width = popcount(region.domains[s]);
+		if (width > 1 && width < bestWidth) {
+			best = s;
+			bestWidth = width;
+		}
+	}
+	if (best == numDomains) {									// every domain is decided, and every clue was fully checked
+		return true;
+	}
+
+	for (Domain_t options = region.domains[best]; options != 0; options &= options - 1) {
+		Region next{ region };
+		next.domains[best] = Domain_t{ 1 } << countr_zero(options);
+		if (search(next, scratch)) {
+			region = move(next);
+			return true;
+		}
+	}
+	return false;
+}
+
+// every variable is decided by the domains of a single solution
+void DomainEngine::witness(const Region& solution, vector<bool>& seenTrue, vector<bool>& seenFalse) const {
+	size_t numVars = pairings.size();
+	for (size_t v = 0; v < numVars; ++v) {
+		if (deduce(solution.domains, static_cast<int>(v)) == VarStatus_e::True) {
+			seenTrue[v] = true;
+		}
+		else {
+			seenFalse[v] = true;
+		}
+	}
+}
\ No newline at end of file
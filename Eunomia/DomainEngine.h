@@ -0,0 +1,208 @@
+#ifndef EUNOMIA_DOMAIN_ENGINE
+#define EUNOMIA_DOMAIN_ENGINE
+
+#include <cstdint>												// for uint64_t
+#include <memory>												// for unique_ptr, shared_ptr
+#include <vector>												// for vector
+#include "Engine.h"												// for Engine
+#include "Utility.h"											// for VarStatus_e
+
+class Assignment;
+class Expression;
+
+/*
+	A DomainEngine is a kind of Engine that never enumerates the possible solutions of its Puzzle, and can
+	therefore handle Puzzles far too large for a LogicEngine. Instead, a possible solution is described by
+	the group to which each item of each Category belongs, where the groups are named by the items of
+	Category 0; a set of such solutions is described by a domain for each pair of a Category and a group,
+	which is the set of items of that Category that may still belong to that group. The domains of a single
+	Category are kept consistent with the rule that every item belongs to exactly one group.
+
+	A DomainEngine keeps a copy of every clue that it has evaluated. Each clue is checked against a set of
+	domains as soon as few enough of its variables remain undecided, by trying every combination of values
+	for those variables: if none makes the clue TRUE, no solution described by the domains can satisfy it,
+	and if every combination that does agrees on the value of some variable, that variable is forced to
+	that value. Forced values narrow the domains in turn, and the two are alternated until neither changes.
+	Possible solutions are found by a depth-first search that repeatedly narrows the smallest undecided
+	domain to a single item, pruning as soon as a domain empties or a clue cannot be satisfied.
+
+	The statuses of variables are exact. After each clue, the DomainEngine searches for one solution that
+	satisfies every clue and, for each variable still "unknown," for a solution in which that variable has
+	whichever value has not yet been witnessed; every solution found witnesses the values of all variables
+	at once. Every variable whose status becomes known is forced in the region from which every later search
+	starts. Each clue keeps a checkpoint of that region as it stood before the clue, along with the variables
+	whose statuses the clue settled, so undoing a clue is a matter of restoring both and forgetting the clue.
+
+	A DomainEngine probes a clue by evaluating it on a copy of itself. Since it never enumerates the possible
+	solutions, it cannot say how many of them a probed clue would leave.
+*/
+
+class DomainEngine : public Engine {
+	public:
+		// [Constructor]
+		// REQUIRES: <numCategories> is at least 2, <itemsPerCategory> is at least 2 and
+		//   no more than 64
+		DomainEngine(size_t numCategories, size_t itemsPerCategory);
+
+		// [Status Accessor]
+		// REQUIRES: <varIndex> is non-negative and less than the total number of variables
+		//   implied by the dimensions used to construct <this>
+		// EFFECTS:  returns the status of the <varIndex>th variable based on the logic
+		//   peformed thus far
+		VarStatus_e getStatus(int varIndex) const override;
+
+		// [Solved Checker]
+		// EFFECTS:  returns TRUE if the status of every variable is either "guaranteed to
+		//   be true" or "guaranteed to be false," and returns FALSE otherwise
+		bool solved() const override;
+
+		// [Clue Evaluator]
+		// REQUIRES: each variable that forms part of <clue> is within the scope of <this>
+		// MODIFIES: <this>
+		// EFFECTS:  restricts the possible solutions to those for which <clue> evaluates to
+		//   TRUE and updates the statuses of variables accordingly; if <clue> was an inconsistent
+		//   clue, returns FALSE and makes no changes whatsoever; returns TRUE otherwise
+		bool evaluateClue(const Expression& clue) override;
+
+		// [Change Collector]
+		// MODIFIES: <this>
+		// EFFECTS:  returns the index of each variable whose status has changed since <this> was
+		//   constructed or since the last call to <takeChanges()>, in the order in which they
+		//   changed, and forgets them
+		std::vector<int> takeChanges() override;
+
+		// [Undo Depth Accessor]
+		// EFFECTS:  returns the number of consistent clues evaluated by <this> that have not been undone
+		size_t undoableClues() const override;
+
+		// [Clue Undoer]
+		// REQUIRES: <count> is no greater than <undoableClues()>
+		// MODIFIES: <this>
+		// EFFECTS:  returns <this> to the state it was in before the last <count> consistent clues
+		//   that have not been undone were evaluated, recording each variable whose status changes
+		void undoClues(size_t count) override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new DomainEngine that is an independent copy of <this>
+		std::unique_ptr<Engine> clone() const override;
+
+	private:
+		using Domain_t = std::uint64_t;
+
+		/*
+			A Pairing names the two items, from two different Categories, whose membership
+			in the same group is represented by a single variable.
+		*/
+		struct Pairing {
+			int catA;
+			int itemA;
+			int catB;
+			int itemB;
+		};
+
+		/*
+			A Constraint is a clue evaluated by a DomainEngine, along with the distinct
+			variables that form part of it. Clues are never modified once evaluated, so
+			copies of a DomainEngine share them.
+		*/
+		struct Constraint {
+			std::shared_ptr<const Expression> clue;
+			std::vector<int> support;
+		};
+
+		/*
+			A Region is a set of possible solutions, described by a domain for each pair of
+			a Category (other than Category 0) and a group, together with the values to which
+			individual variables have been forced.
+		*/
+		struct Region {
+			std::vector<Domain_t> domains;
+			std::vector<VarStatus_e> forced;
+		};
+
+		/*
+			A Checkpoint records what evaluating a consistent clue did besides keeping it: the
+			region from which every search started just before it, and the variables whose
+			statuses it settled.
+		*/
+		struct Checkpoint {
+			Region root;
+			std::vector<int> settled;
+		};
+
+		int categories;
+		int itemsPer;
+		std::vector<Pairing> pairings;
+		std::vector<Constraint> constraints;
+		std::vector<VarStatus_e> statuses;
+		size_t unknowns;
+		std::vector<int> changes;
+		Region root;
+		std::vector<Checkpoint> history;
+
+		// [Domain Locator]
+		// REQUIRES: <category> is positive and less than <categories>, <group> is non-negative
+		//   and less than <itemsPer>
+		// EFFECTS:  returns the position in a list of domains of the domain for <category>
+		//   and <group>
+		size_t slot(int category, int group) const;
+
+		// [Pairing Locator]
+		// REQUIRES: <cat1> and <cat2> are distinct, non-negative, and less than <categories>,
+		//   <item1> and <item2> are non-negative and less than <itemsPer>
+		// EFFECTS:  returns the index of the variable pairing item <item1> of <cat1> with item
+		//   <item2> of <cat2>, in whichever order the two Categories come
+		int pairingIndex(int cat1, int item1, int cat2, int item2) const;
+
+		// [Variable Deducers]
+		// REQUIRES: <varIndex> indexes an element of <pairings>
+		// EFFECTS:  returns "guaranteed to be true" or "guaranteed to be false" if the <varIndex>th
+		//   variable has that value in every solution described by <domains> (or, for the second
+		//   overload, to which it has been forced in <region>), and returns "unknown" otherwise
+		VarStatus_e deduce(const std::vector<Domain_t>& domains, int varIndex) const;
+		VarStatus_e deduce(const Region& region, int varIndex) const;
+
+		// [Variable Forcer]
+		// REQUIRES: <varIndex> indexes an element of <pairings>, <value> is not "unknown"
+		// MODIFIES: <region>, <changed>
+		// EFFECTS:  returns FALSE if the <varIndex>th variable is already known to have the value
+		//   opposite <value> in <region>; otherwise forces it to <value> if it was unknown, setting
+		//   <changed>, and returns TRUE
+		bool force(Region& region, int varIndex, VarStatus_e value, bool& changed) const;
+
+		// [Region Narrower]
+		// MODIFIES: <region>
+		// EFFECTS:  narrows <region> until no item is possible for two groups if it already
+		//   belongs to one, no item is possible for only one group without belonging to it, no
+		//   domain admits a solution that contradicts a forced value, and the variables known
+		//   to be TRUE are closed under the rules that each item has exactly one partner in each
+		//   other Category and that partners share their partners; returns FALSE if that leaves
+		//   no solution in <region>, and returns TRUE otherwise
+		bool narrow(Region& region) const;
+
+		// [Constraint Enforcer]
+		// REQUIRES: <scratch> has one variable for each element of <pairings>
+		// MODIFIES: <region>, <scratch>, <changed>
+		// EFFECTS:  checks each clue of <this> that has few enough undecided variables in <region>,
+		//   forcing each of those variables that has the same value in every combination that
+		//   satisfies the clue and setting <changed> if any is forced; returns FALSE if some clue
+		//   is certainly unsatisfiable in <region>, and returns TRUE otherwise
+		bool enforce(Region& region, Assignment& scratch, bool& changed) const;
+
+		// [Solution Searcher]
+		// REQUIRES: <scratch> has one variable for each element of <pairings>
+		// MODIFIES: <region>, <scratch>
+		// EFFECTS:  searches <region> for a solution that satisfies every clue of <this>; if
+		//   one is found, narrows <region> to exactly that solution and returns TRUE, and
+		//   otherwise returns FALSE
+		bool search(Region& region, Assignment& scratch) const;
+
+		// [Witness Recorder]
+		// REQUIRES: <solution> describes exactly one solution, <seenTrue> and <seenFalse> have
+		//   one element for each element of <pairings>
+		// MODIFIES: <seenTrue>, <seenFalse>
+		// EFFECTS:  marks the value of each variable in <solution> as witnessed
+		void witness(const Region& solution, std::vector<bool>& seenTrue, std::vector<bool>& seenFalse) const;
+};
+
+#endif
\ No newline at end of file
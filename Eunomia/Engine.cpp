@@ -0,0 +1,100 @@
+#include "DomainEngine.h"										// for DomainEngine
+#include "Engine.h"												// for Engine
+#include "LogicEngine.h"										// for LogicEngine
+#include "ShapedLogicEngine.h"									// for ShapedLogicEngine
+#include "Utility.h"											// for ProbeResult, StatusReport, kUncounted
+#include "WorkerPool.h"											// for WorkerPool
+#include <cassert>												// for assert
+#include <memory>												// for unique_ptr, make_unique
+#include <vector>												// for vector
+
+using std::unique_ptr; using std::make_unique;
+using std::vector;
+
+// the largest number of possible solutions that a LogicEngine is asked to enumerate
+const size_t kMaxEnumerated = size_t{ 1 } << 21;
+
+// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2
+// EFFECTS:  returns TRUE if a Puzzle with the given dimensions has no more than
+//   <kMaxEnumerated> possible solutions, and returns FALSE otherwise
+bool enumerable(size_t numCategories, size_t itemsPerCategory);
+
+
+// polymorphic destructor
+Engine::~Engine() {}
+
+// nothing is counted unless a derived class counts it
+size_t Engine::countSurvivors() const {
+	return kUncounted;
+}
+
+// evaluate the clues one at a time
+vector<bool> Engine::evaluateClues(const vector<const Expression*>& clues) {
+	vector<bool> results;
+	results.reserve(clues.size());
+	for (auto clue : clues) {
+		results.push_back(evaluateClue(*clue));
+	}
+	return results;
+}
+
+// evaluate each clue on a clone of its own, one clone per task of the WorkerPool, and read
+// the changes and the survivors off the clone; the changes still pending on <this> are
+// dropped from each clone first so that only those made by the clue are reported
+vector<ProbeResult> Engine::probeClues(const vector<const Expression*>& clues) const {
+	vector<ProbeResult> results(clues.size());
+	WorkerPool::getInstance().run(clues.size(), [&](size_t k) {
+		auto copy = clone();
+		copy->takeChanges();
+
+		auto& result = results[k];
+		result.consistent = copy->evaluateClue(*clues[k]);
+		result.survivors = (result.consistent ? copy->countSurvivors() : 0);
+		for (auto v : copy->takeChanges()) {
+			result.changes.push_back(StatusReport{ v, copy->getStatus(v) });
+		}
+	});
+	return results;
+}
+
+// multiply out (<itemsPerCategory>!)^(<numCategories> - 1), bailing out as soon as the
+// running product exceeds <kMaxEnumerated> so that nothing can overflow
+bool enumerable(size_t numCategories, size_t itemsPerCategory) {
+	size_t perBlock = 1;
+	for (size_t i = 2; i <= itemsPerCategory; ++i) {
+		perBlock *= i;
+		if (perBlock > kMaxEnumerated) {
+			return false;
+		}
+	}
+
+	size_t total = 1;
+	for (size_t b = 1; b < numCategories; ++b) {
+		total *= perBlock;
+		if (total > kMaxEnumerated) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// use a compile-time shape when there is one, enumerate when feasible, and otherwise fall
+// back to domains and search
+unique_ptr<Engine> makeEngine(size_t numCategories, size_t itemsPerCategory) {
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+
+	if (numCategories == 3 && itemsPerCategory == 4) {
+		return make_unique<ShapedLogicEngine<3, 4>>();
+	}
+	if (numCategories == 4 && itemsPerCategory == 4) {
+		return make_unique<ShapedLogicEngine<4, 4>>();
+	}
+	if (numCategories == 4 && itemsPerCategory == 5) {
+		return make_unique<ShapedLogicEngine<4, 5>>();
+	}
+	if (enumerable(numCategories, itemsPerCategory)) {
+		return make_unique<LogicEngine>(numCategories, itemsPerCategory);
+	}
+	return make_unique<DomainEngine>(numCategories, itemsPerCategory);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#ifndef EUNOMIA_ENGINE
+#define EUNOMIA_ENGINE
+
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "Utility.h"											// for VarStatus_e, ProbeResult
+
+class Expression;
+
+/*
+	An Engine is an abstract evaluative computer that tracks the evaluation of a logic Puzzle against one or
+	more clues. The logic Puzzle that an Engine is responsible for handling is set at construction and cannot
+	thereafter be changed. The number of variables that an Engine treats is equal to the total number of
+	inter-category combinations of items in that logic Puzzle.
+
+	Every Engine honors the same contract. Evaluating a clue discards every possible solution of the Puzzle
+	for which the clue is FALSE, unless that would discard every remaining possible solution, in which case
+	the clue is inconsistent and the Engine is left untouched. The status of each variable is exact: it is
+	"guaranteed to be true" or "guaranteed to be false" only if every remaining possible solution agrees.
+	Derived classes differ only in how they represent the remaining possible solutions, and so in which
+	Puzzles they can handle in reasonable time and memory.
+
+	Evaluating a clue only ever discards possible solutions, so it only ever changes the status of a variable
+	from "unknown" to one of the guaranteed statuses. Every consistent clue can later be undone, most recent
+	first, which restores exactly the possible solutions that the clue discarded and so may return statuses
+	to "unknown." Every Engine records each change of status as it happens, so that a caller can learn which
+	statuses changed without asking after every variable.
+
+	An Engine can also be asked what evaluating each of many hypothetical clues would do, without evaluating
+	any of them: each hypothesis is weighed on its own against the current state, independently of the
+	others, and the Engine is left exactly as it was. Engines that enumerate the possible solutions also
+	report how many of them remain, and so how many each hypothesis would leave.
+
+	An Engine can be copied polymorphically through its cloner, which yields an independent Engine of the
+	same kind in the same state.
+*/
+
+class Engine {
+	public:
+		// [Destructor]
+		// EFFECTS:  virtually destructs <this>
+		virtual ~Engine();
+
+		// [Status Accessor]
+		// REQUIRES: <varIndex> is non-negative and less than the total number of variables
+		//   of the Puzzle handled by <this>
+		// EFFECTS:  returns the status of the <varIndex>th variable based on the logic
+		//   peformed thus far
+		virtual VarStatus_e getStatus(int varIndex) const = 0;
+
+		// [Solved Checker]
+		// EFFECTS:  returns TRUE if the status of every variable is either "guaranteed to
+		//   be true" or "guaranteed to be false," and returns FALSE otherwise
+		virtual bool solved() const = 0;
+
+		// [Survivor Counter]
+		// EFFECTS:  returns the number of possible solutions that remain, or <kUncounted> if <this>
+		//   does not enumerate them
+		virtual size_t countSurvivors() const;
+
+		// [Clue Evaluator]
+		// REQUIRES: each variable that forms part of <clue> is within the scope of <this>
+		// MODIFIES: <this>
+		// EFFECTS:  eliminates the possible solutions for which <clue> evaluates to FALSE and
+		//   updates the statuses of variables accordingly; if <clue> was an inconsistent clue
+		//   (meaning that it somehow contradicts at least one clue previously evaluated by
+		//   <this>), returns FALSE and makes no changes whatsoever; returns TRUE otherwise
+		virtual bool evaluateClue(const Expression& clue) = 0;
+
+		// [Batch Clue Evaluator]
+		// REQUIRES: each variable that forms part of each of <clues> is within the scope of <this>
+		// MODIFIES: <this>
+		// EFFECTS:  evaluates each of <clues> in order exactly as <evaluateClue()> would, and returns
+		//   a list with one element per clue that is TRUE if and only if that clue was consistent
+		virtual std::vector<bool> evaluateClues(const std::vector<const Expression*>& clues);
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of each of <clues> is within the scope of <this>
+		// EFFECTS:  returns a list with one element per clue describing what <evaluateClue()> would
+		//   do if it were handed that clue next, without changing <this>; the clues are weighed
+		//   independently of each other, in parallel on the WorkerPool
+		virtual std::vector<ProbeResult> probeClues(const std::vector<const Expression*>& clues) const;
+
+		// [Change Collector]
+		// MODIFIES: <this>
+		// EFFECTS:  returns the index of each variable whose status has changed since <this> was
+		//   constructed or since the last call to <takeChanges()>, in the order in which they
+		//   changed, and forgets them; no variable is listed twice unless a clue was undone in between
+		virtual std::vector<int> takeChanges() = 0;
+
+		// [Undo Depth Accessor]
+		// EFFECTS:  returns the number of consistent clues evaluated by <this> that have not been undone
+		virtual size_t undoableClues() const = 0;
+
+		// [Clue Undoer]
+		// REQUIRES: <count> is no greater than <undoableClues()>
+		// MODIFIES: <this>
+		// EFFECTS:  returns <this> to the state it was in before the last <count> consistent clues
+		//   that have not been undone were evaluated, recording each variable whose status changes
+		virtual void undoClues(size_t count) = 0;
+
+		// [Cloner]
+		// EFFECTS:  returns a new Engine of the same kind as <this> in the same state
+		virtual std::unique_ptr<Engine> clone() const = 0;
+};
+
+// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2
+// EFFECTS:  returns a new Engine for a Puzzle with the given dimensions: a ShapedLogicEngine
+//   if one is instantiated for those dimensions, otherwise a LogicEngine if every possible
+//   solution of such a Puzzle can reasonably be enumerated, and a DomainEngine otherwise
+std::unique_ptr<Engine> makeEngine(size_t numCategories, size_t itemsPerCategory);
+
+#endif
\ No newline at end of file
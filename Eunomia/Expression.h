@@ -2,8 +2,12 @@
 #define EUNOMIA_EXPRESSION
 
 #include <iosfwd>												// for ostream
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "Utility.h"											// for VarStatus_e, ExpressionNode
 
 class Assignment;
+class BitSet;
 
 /*
 	An Expression is any nonzero number of variables, possibly negated, grouped together and joined by a
@@ -14,6 +18,23 @@ class Assignment;
 	a TRUE evaluation subsequently results in a FALSE evaluation; negating an Expression twice is a
 	no-op.
 
+	An Expression can also be evaluated against many assignments at once when those assignments are laid
+	out column-major: one BitSet per variable, whose ~i~th bit is that variable's assigned value in the ~i~th
+	assignment. The result is itself a BitSet holding the evaluation under each of the assignments, which
+	is computed a full word of assignments at a time.
+
+	An Expression can also be evaluated against a partial assignment, in which each variable is known to be
+	TRUE, known to be FALSE, or unknown. The result follows three-valued (Kleene) logic: it is TRUE or FALSE
+	if every way of filling in the unknown variables would give that result by the rules of the operators
+	alone, and unknown otherwise. For instance, an "and" with a FALSE side is FALSE whatever the other side
+	is, and the other side is never looked at. A TRUE result means that the Expression already follows from
+	what is known, and a FALSE one that it contradicts it.
+
+	An Expression can be deep-copied through a polymorphic cloner, and can report the IDs of the variables
+	that form part of it; together these let an evaluator hold on to a clue and revisit it later. An
+	Expression can also be laid out flat as a list of ExpressionNodes, for evaluators that would rather
+	walk a list than a tree.
+
 	When an Expression is printed, each variable that is comprises the Expression is converted into its
 	string representation, and these string representations are separated either by parentheses to
 	indicate groupings or by characters indicating the various Boolean operators.
@@ -36,6 +57,38 @@ class Expression {
 		//   and returns the evaluation, either TRUE or FALSE
 		virtual bool evaluate(const Assignment& assign) const = 0;
 
+		// [Column Evaluator]
+		// REQUIRES: each variable that forms part of <this> indexes an element of <columns>, and
+		//   each of those elements has the same size
+		// EFFECTS:  treats the ~i~th bit of each column as the assigned value of that column's
+		//   variable in the ~i~th of a set of assignments, and returns a BitSet whose ~i~th bit is
+		//   the evaluation of <this> under the ~i~th assignment
+		virtual BitSet evaluate(const std::vector<BitSet>& columns) const = 0;
+
+		// [Partial Evaluator]
+		// REQUIRES: each variable that forms part of <this> indexes an element of <statuses>
+		// EFFECTS:  treats each element of <statuses> as what is known of the assigned value of its
+		//   variable, and returns the three-valued evaluation of <this>: TRUE or FALSE if that is the
+		//   evaluation however the unknown variables are assigned by the rules of the operators, and
+		//   unknown otherwise
+		virtual VarStatus_e evaluate(const std::vector<VarStatus_e>& statuses) const = 0;
+
+		// [Cloner]
+		// EFFECTS:  returns a new Expression that is a deep copy of <this>
+		virtual std::unique_ptr<Expression> clone() const = 0;
+
+		// [Variable Collector]
+		// MODIFIES: <vars>
+		// EFFECTS:  appends to <vars> the ID of each variable that forms part of <this>, once
+		//   for every time that the variable appears
+		virtual void collectVariables(std::vector<int>& vars) const = 0;
+
+		// [Flattener]
+		// MODIFIES: <nodes>
+		// EFFECTS:  appends the nodes of <this> to <nodes>, each operator after both of its operands,
+		//   and returns the index in <nodes> of the node for <this> itself, which is the last one
+		virtual size_t flatten(std::vector<ExpressionNode>& nodes) const = 0;
+
 		friend std::ostream& operator<<(std::ostream& os, const Expression& expr);
 
 	protected:
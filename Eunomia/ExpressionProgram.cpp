@@ -0,0 +1,138 @@
+#include "Assignment.h"											// for Assignment
+#include "Expression.h"											// for Expression
+#include "ExpressionProgram.h"									// for ExpressionProgram
+#include "Utility.h"											// for ExpressionNode, Operator_e
+#include <algorithm>											// for max
+#include <cassert>												// for assert
+#include <cstdint>												// for uint32_t
+#include <vector>												// for vector
+
+using std::uint32_t;
+using std::max;
+using std::vector;
+
+
+// constructor; the clue is flattened, compiled from its root, and then each jump is threaded
+// through any jumps of the same kind that it lands on, which leave the running value as it is
+ExpressionProgram::ExpressionProgram(const Expression& clue)
+	: maxHeld{ 0 } {
+
+	vector<ExpressionNode> nodes;
+	size_t root = clue.flatten(nodes);
+	emit(nodes, root, 0);
+
+	for (auto& instr : code) {
+		if (instr.op == Opcode_e::JumpIfFalse || instr.op == Opcode_e::JumpIfTrue) {
+			while (instr.operand < code.size() && code[instr.operand].op == instr.op) {
+				instr.operand = code[instr.operand].operand;
+			}
+		}
+	}
+}
+
+// values are held aside on the stack unless the program needs more room than that
+bool ExpressionProgram::evaluate(const Assignment& assign) const {
+	if (maxHeld <= kInlineHeld) {
+		char held[kInlineHeld];
+		return run(assign, held);
+	}
+	vector<char> held(maxHeld);
+	return run(assign, held.data());
+}
+
+// return the number of instructions
+size_t ExpressionProgram::size() const {
+	return code.size();
+}
+
+// return the most values held at once
+size_t ExpressionProgram::heldCount() const {
+	return maxHeld;
+}
+
+// a variable is a single load, with its negation folded in; a conjunction, a disjunction, or an
+// implication jumps past its right-hand operand once its left-hand one decides it (the left-hand
+// value of an implication is negated first, so that it is already the result if it is TRUE);
+// an exclusive-or holds its left-hand value aside, and a biconditional is a negated one
+void ExpressionProgram::emit(const vector<ExpressionNode>& nodes, size_t node, size_t held) {
+	assert(node < nodes.size());
+
+	const auto& expr = nodes[node];
+	if (expr.isVariable) {
+		assert(expr.varIndex >= 0);
+		code.push_back(Instruction{ expr.negated ? Opcode_e::LoadNot : Opcode_e::Load, static_cast<uint32_t>(expr.varIndex) });
+		return;
+	}
+
+	bool negate = expr.negated;
+	emit(nodes, expr.left, held);
+	switch (expr.op) {
+		case Operator_e::And:
+		case Operator_e::Or:
+		case Operator_e::Implies: {
+			if (expr.op == Operator_e::Implies) {
+				code.push_back(Instruction{ Opcode_e::Not, 0 });
+			}
+			size_t jump = code.size();
+			code.push_back(Instruction{ expr.op == Operator_e::And ? Opcode_e::JumpIfFalse : Opcode_e::JumpIfTrue, 0 });
+			emit(nodes, expr.right, held);
+			code[jump].operand = static_cast<uint32_t>(code.size());
+			break;
+		}
+		case Operator_e::Xor:
+		case Operator_e::Iff:
+			code.push_back(Instruction{ Opcode_e::Hold, 0 });
+			maxHeld = max(maxHeld, held + 1);
+			emit(nodes, expr.right, held + 1);
+			code.push_back(Instruction{ Opcode_e::Xor, 0 });
+			negate = (expr.negated != (expr.op == Operator_e::Iff));
+			break;
+		default:
+			throw;												// this will never be reached; cases are exhaustive for Operator_e
+	}
+	if (negate) {
+		code.push_back(Instruction{ Opcode_e::Not, 0 });
+	}
+}
+
+// step through the instructions, jumping forward where the running value says to; the values
+// held aside are taken back in the reverse order to that in which they were held
+bool ExpressionProgram::run(const Assignment& assign, char* held) const {
+	bool value = false;
+	size_t top = 0;
+	size_t numInstrs = code.size();
+	for (size_t pc = 0; pc < numInstrs; ++pc) {
+		const auto& instr = code[pc];
+		switch (instr.op) {
+			case Opcode_e::Load:
+				value = ((assign.getWord(instr.operand / Assignment::kWordBits) >> (instr.operand % Assignment::kWordBits)) & 1) != 0;
+				break;
+			case Opcode_e::LoadNot:
+				value = ((assign.getWord(instr.operand / Assignment::kWordBits) >> (instr.operand % Assignment::kWordBits)) & 1) == 0;
+				break;
+			case Opcode_e::Not:
+				value = !value;
+				break;
+			case Opcode_e::JumpIfFalse:
+				if (!value) {
+					pc = instr.operand - 1;
+				}
+				break;
+			case Opcode_e::JumpIfTrue:
+				if (value) {
+					pc = instr.operand - 1;
+				}
+				break;
+			case Opcode_e::Hold:
+				held[top++] = value;
+				break;
+			case Opcode_e::Xor:
+				value = ((held[--top] != 0) != value);
+				break;
+			default:
+				throw;											// this will never be reached; cases are exhaustive for Opcode_e
+		}
+	}
+	assert(top == 0);
+	return value;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef EUNOMIA_EXPRESSION_PROGRAM
+#define EUNOMIA_EXPRESSION_PROGRAM
+
+#include <cstdint>												// for uint8_t, uint32_t
+#include <vector>												// for vector
+#include "Utility.h"											// for ExpressionNode
+
+class Assignment;
+class Expression;
+
+/*
+	An ExpressionProgram is a single clue compiled into a flat list of instructions, to be evaluated against
+	many Assignments without walking the clue itself. The program keeps a single running value: a variable
+	is loaded into it, possibly negated, and an operator whose result is already decided by its left-hand
+	operand jumps straight past the code for its right-hand one, just as the clue short-circuits; only an
+	exclusive-or (or a biconditional) needs both of its operands, so its left-hand value is held aside
+	while the right-hand one is worked out. A jump that lands on another jump of the same kind is
+	redirected to wherever that one leads, so a run of conjunctions or disjunctions that fails early
+	leaves it in a single jump.
+
+	Evaluating an ExpressionProgram always gives the same result as evaluating the clue from which it was
+	compiled. The clue need not outlive the ExpressionProgram, and any number of threads can evaluate
+	through the same ExpressionProgram at once.
+*/
+
+class ExpressionProgram {
+	public:
+		static constexpr size_t kInlineHeld = 32;
+
+		// [Constructor]
+		// EFFECTS:  constructs <this> by compiling <clue>
+		explicit ExpressionProgram(const Expression& clue);
+
+		// [Evaluator]
+		// REQUIRES: each variable that forms part of the clue of <this> is within the scope of <assign>
+		// EFFECTS:  returns the evaluation of the clue of <this> under <assign>
+		bool evaluate(const Assignment& assign) const;
+
+		// [Program Accessors]
+		// EFFECTS:  returns the number of instructions of <this>, or the greatest number of values
+		//   that <this> ever holds aside at once
+		size_t size() const;
+		size_t heldCount() const;
+
+	private:
+		enum class Opcode_e : std::uint8_t { Load, LoadNot, Not, JumpIfFalse, JumpIfTrue, Hold, Xor };
+
+		struct Instruction {
+			Opcode_e op;
+			std::uint32_t operand;										// the variable for a load, the target for a jump
+		};
+
+		std::vector<Instruction> code;
+		size_t maxHeld;
+
+		// REQUIRES: <node> is an index of <nodes>, which lists the nodes of an Expression as
+		//   <Expression::flatten()> does; <held> values are already held aside
+		// MODIFIES: <code>, <maxHeld>
+		// EFFECTS:  appends the instructions that leave the value of the <node>th node in the
+		//   running value, holding aside no more values on completion than before
+		void emit(const std::vector<ExpressionNode>& nodes, size_t node, size_t held);
+
+		// REQUIRES: <held> has room for <maxHeld> values
+		// EFFECTS:  returns the evaluation of the clue of <this> under <assign>, holding values
+		//   aside in <held>
+		bool run(const Assignment& assign, char* held) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Assignment.h"											// for Assignment
+#include "Expression.h"											// for Expression
+#include "IncrementalEvaluator.h"								// for IncrementalEvaluator
+#include "Utility.h"											// for ExpressionNode, Operator_e
+#include <cassert>												// for assert
+#include <vector>												// for vector
+
+using std::vector;
+
+
+// constructor; each clue is flattened after the last, and each of its nodes is linked to the
+// operator above it and, for a variable, listed under that variable
+IncrementalEvaluator::IncrementalEvaluator(const vector<const Expression*>& clues, size_t numVars)
+	: watchers(numVars) {
+
+	for (auto clue : clues) {
+		assert(clue);
+		roots.push_back(clue->flatten(nodes));
+	}
+
+	size_t numNodes = nodes.size();
+	parents.assign(numNodes, kNoParent);
+	values.assign(numNodes, 0);
+	for (size_t n = 0; n < numNodes; ++n) {
+		const auto& node = nodes[n];
+		if (node.isVariable) {
+			assert(node.varIndex >= 0 && node.varIndex < static_cast<int>(numVars));
+			watchers[node.varIndex].push_back(n);
+		}
+		else {
+			parents[node.left] = n;
+			parents[node.right] = n;
+		}
+	}
+}
+
+// every operand comes before its operator, so one pass in order suffices
+void IncrementalEvaluator::reset(const Assignment& assign) {
+	size_t numNodes = nodes.size();
+	for (size_t n = 0; n < numNodes; ++n) {
+		values[n] = evaluateNode(n, assign);
+	}
+}
+
+// from each node for a changed variable, climb towards the root of its clue only as long as
+// the value keeps changing; a node reached twice is simply evaluated again
+void IncrementalEvaluator::update(const Assignment& assign, const vector<int>& changed) {
+	for (auto var : changed) {
+		for (auto leaf : watchers[var]) {
+			size_t n = leaf;
+			char value = evaluateNode(n, assign);
+			while (value != values[n]) {
+				values[n] = value;
+				n = parents[n];
+				if (n == kNoParent) {
+					break;
+				}
+				value = evaluateNode(n, assign);
+			}
+		}
+	}
+}
+
+// the kept value of the root of the clue
+bool IncrementalEvaluator::value(size_t clue) const {
+	assert(clue < roots.size());
+	return values[roots[clue]] != 0;
+}
+
+// read a variable from <assign>, or combine the kept values of both operands, then negate
+// if needed
+bool IncrementalEvaluator::evaluateNode(size_t node, const Assignment& assign) const {
+	const auto& expr = nodes[node];
+	if (expr.isVariable) {
+		return assign.getAssignedValue(expr.varIndex) != expr.negated;
+	}
+
+	bool left = values[expr.left] != 0;
+	bool right = values[expr.right] != 0;
+	bool result;
+	switch (expr.op) {
+		case Operator_e::And:
+			result = left && right;
+			break;
+		case Operator_e::Or:
+			result = left || right;
+			break;
+		case Operator_e::Implies:
+			result = !left || right;
+			break;
+		case Operator_e::Xor:
+			result = left != right;
+			break;
+		case Operator_e::Iff:
+			result = left == right;
+			break;
+		default:
+			throw;												// this will never be reached; cases are exhaustive for Operator_e
+	}
+	return result != expr.negated;
+}
\ No newline at end of file
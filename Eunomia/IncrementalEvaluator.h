@@ -0,0 +1,65 @@
+#ifndef EUNOMIA_INCREMENTAL_EVALUATOR
+#define EUNOMIA_INCREMENTAL_EVALUATOR
+
+#include <vector>												// for vector
+#include "Utility.h"											// for ExpressionNode
+
+class Assignment;
+class Expression;
+
+/*
+	An IncrementalEvaluator evaluates a fixed list of clues against a sequence of Assignments, each of which
+	differs from the one before it in only a few variables. The clues are laid out flat as ExpressionNodes,
+	and the value of every node of every clue under the most recent Assignment is kept. When the Assignment
+	changes, only the nodes for the changed variables are evaluated again, and a new value is passed up to
+	the operator above it only while it actually changes that operator's value; a clue that does not
+	mention a changed variable is never looked at.
+
+	An IncrementalEvaluator does not hold on to the clues themselves, so they need not outlive it. Each
+	IncrementalEvaluator keeps its own values, so one is needed per thread.
+*/
+
+class IncrementalEvaluator {
+	public:
+		// [Constructor]
+		// REQUIRES: no element of <clues> is a null pointer, each variable that forms part of each
+		//   of <clues> is less than <numVars>
+		// EFFECTS:  constructs <this> over <clues>, without any Assignment yet
+		IncrementalEvaluator(const std::vector<const Expression*>& clues, size_t numVars);
+
+		// [Resetter]
+		// REQUIRES: each variable that forms part of each clue of <this> is within the scope of <assign>
+		// MODIFIES: <this>
+		// EFFECTS:  evaluates every node of every clue of <this> against <assign> from scratch
+		void reset(const Assignment& assign);
+
+		// [Updater]
+		// REQUIRES: <reset()> has been called, and <assign> differs from the Assignment given to the
+		//   most recent call to <reset()> or <update()> in the variables of <changed> alone
+		// MODIFIES: <this>
+		// EFFECTS:  brings the value of every node of every clue of <this> up to date with <assign>,
+		//   evaluating only the nodes whose values can have changed
+		void update(const Assignment& assign, const std::vector<int>& changed);
+
+		// [Value Accessor]
+		// REQUIRES: <clue> is less than the number of clues of <this>, <reset()> has been called
+		// EFFECTS:  returns the evaluation of the <clue>th clue of <this> under the most recent
+		//   Assignment
+		bool value(size_t clue) const;
+
+	private:
+		static constexpr size_t kNoParent = static_cast<size_t>(-1);
+
+		std::vector<ExpressionNode> nodes;								// every clue's nodes, one clue after another
+		std::vector<size_t> parents;									// parents[i] = the operator over node i, or kNoParent
+		std::vector<size_t> roots;										// roots[k] = the node for the whole of the kth clue
+		std::vector<std::vector<size_t>> watchers;						// watchers[v] = the nodes for variable v
+		std::vector<char> values;
+
+		// REQUIRES: <node> is an index of <nodes>; if it is an operator, the values of both of its
+		//   operands are up to date
+		// EFFECTS:  returns the value of the <node>th node under <assign>
+		bool evaluateNode(size_t node, const Assignment& assign) const;
+};
+
+#endif
\ No newline at end of file
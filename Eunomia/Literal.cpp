@@ -1,12 +1,17 @@
 #include "Assignment.h"											// for Assignment
+#include "BitSet.h"												// for BitSet
 #include "Literal.h"											// for Literal
-#include "Utility.h"											// for constant char symbols
+#include "Utility.h"											// for constant char symbols, VarStatus_e, ExpressionNode
 #include <cassert>												// for assert
 #include <iostream>												// for ostream
+#include <memory>												// for unique_ptr, make_unique
 #include <string>												// for string
+#include <vector>												// for vector
 
 using std::ostream;
 using std::string;
+using std::vector;
+using std::unique_ptr; using std::make_unique;
 
 
 // constructor
@@ -30,6 +35,44 @@ bool Literal::evaluate(const Assignment& assign) const {
 	return (assignedValue != negated);										// only (assign=T, negated=F) and (assign=F, negated=T) are TRUE
 }
 
+// copy the column of the underlying variable, flipping every bit if negated
+BitSet Literal::evaluate(const vector<BitSet>& columns) const {
+	assert(varID < static_cast<int>(columns.size()));
+
+	BitSet result{ columns[varID] };
+	if (negated) {
+		result.flip();
+	}
+	return result;
+}
+
+// look up the status of the underlying variable, flipping a known one if negated
+VarStatus_e Literal::evaluate(const vector<VarStatus_e>& statuses) const {
+	assert(varID < static_cast<int>(statuses.size()));
+
+	VarStatus_e status = statuses[varID];
+	if (status == VarStatus_e::Unknown || !negated) {
+		return status;
+	}
+	return (status == VarStatus_e::True ? VarStatus_e::False : VarStatus_e::True);
+}
+
+// copy <this> into a new Literal
+unique_ptr<Expression> Literal::clone() const {
+	return make_unique<Literal>(*this);
+}
+
+// the only variable is the underlying one
+void Literal::collectVariables(vector<int>& vars) const {
+	vars.push_back(varID);
+}
+
+// a single node for the underlying variable
+size_t Literal::flatten(vector<ExpressionNode>& nodes) const {
+	nodes.push_back(ExpressionNode{ true, negated, varID, Operator_e::And, 0, 0 });
+	return nodes.size() - 1;
+}
+
 // print: negation symbol if negated, followed by the string representation (no newline)
 void Literal::print(std::ostream& os) const {
 	if (negated) {
@@ -2,10 +2,14 @@
 #define EUNOMIA_LITERAL
 
 #include <iosfwd>												// for ostream
+#include <memory>												// for unique_ptr
 #include <string>												// for string
+#include <vector>												// for vector
 #include "Expression.h"											// for Expression
+#include "Utility.h"											// for VarStatus_e
 
 class Assignment;
+class BitSet;
 
 /*
 	A Literal is a kind of Expression that consists of a single variable that may or may not be negated.
@@ -39,6 +43,38 @@ class Literal : public Expression {
 		//   and returns the evaluation, either TRUE or FALSE
 		bool evaluate(const Assignment& assign) const override;
 
+		// [Column Evaluator]
+		// REQUIRES: each variable that forms part of <this> indexes an element of <columns>, and
+		//   each of those elements has the same size
+		// EFFECTS:  treats the ~i~th bit of each column as the assigned value of that column's
+		//   variable in the ~i~th of a set of assignments, and returns a BitSet whose ~i~th bit is
+		//   the evaluation of <this> under the ~i~th assignment
+		BitSet evaluate(const std::vector<BitSet>& columns) const override;
+
+		// [Partial Evaluator]
+		// REQUIRES: each variable that forms part of <this> indexes an element of <statuses>
+		// EFFECTS:  treats each element of <statuses> as what is known of the assigned value of its
+		//   variable, and returns the three-valued evaluation of <this>: TRUE or FALSE if that is the
+		//   evaluation however the unknown variables are assigned by the rules of the operators, and
+		//   unknown otherwise
+		VarStatus_e evaluate(const std::vector<VarStatus_e>& statuses) const override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new Literal that is a deep copy of <this>
+		std::unique_ptr<Expression> clone() const override;
+
+		// [Variable Collector]
+		// MODIFIES: <vars>
+		// EFFECTS:  appends to <vars> the ID of each variable that forms part of <this>, once
+		//   for every time that the variable appears
+		void collectVariables(std::vector<int>& vars) const override;
+
+		// [Flattener]
+		// MODIFIES: <nodes>
+		// EFFECTS:  appends the nodes of <this> to <nodes>, each operator after both of its operands,
+		//   and returns the index in <nodes> of the node for <this> itself, which is the last one
+		size_t flatten(std::vector<ExpressionNode>& nodes) const override;
+
 	protected:
 		// [Printer]
 		// MODIFIES: <os>
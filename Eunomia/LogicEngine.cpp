@@ -1,266 +1,363 @@
-#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for AssignmentStore, enumerateSurvivors(), permutationsCrossSize(), orderBySelectivity()
+#include "DenseStore.h"											// for DenseStore
+#include "Engine.h"												// for Engine
 #include "Expression.h"											// for Expression
 #include "LogicEngine.h"										// for LogicEngine
-#include "Utility.h"											// for VarStatus_e, variables()
-#include <algorithm>											// for count_if, remove_if, next_permutation, copy
+#include "RankedStore.h"										// for RankedStore
+#include "SlicedStore.h"										// for SlicedStore
+#include "StreamedStore.h"										// for StreamedStore
+#include "Utility.h"											// for VarStatus_e, Storage_e, ProbeResult, StatusReport, variables()
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for find, fill
 #include <cassert>												// for assert
-#include <cmath>												// for pow
-#include <iterator>												// for back_inserter
+#include <memory>												// for unique_ptr, make_unique, shared_ptr
 #include <numeric>												// for iota
-#include <unordered_map>										// for unordered_map
-#include <utility>												// move
+#include <utility>												// for move
 #include <vector>												// for vector
 
-using std::vector; using std::unordered_map;
-using std::count_if; using std::remove_if; using std::copy;
-using std::pow;
-using std::next_permutation;
+using std::vector;
+using std::find; using std::fill;
 using std::iota;
-using std::back_inserter;
+using std::unique_ptr; using std::make_unique; using std::shared_ptr;
 using std::move;
 
-using PermutationList_t = vector<vector<int>>;
-
-// REQUIRES: <num> is non-negative, <cumulative> is greater than 0
-// EFFECTS:  returns <num>! * <cumulative> tail-recursively
-constexpr int factorial(int num, int cumulative = 1);
+// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, <memoryCap> is positive,
+//   each variable that forms part of each of <clues> is a variable of a puzzle with the given
+//   dimensions
+// EFFECTS:  returns a new AssignmentStore of the kind named by <storage> holding every
+//   possible solution to a puzzle with the given dimensions for which each of <clues> is TRUE,
+//   having evaluated the most selective of <clues> first
+unique_ptr<AssignmentStore> makeStore(Storage_e storage, size_t numCategories, size_t itemsPerCategory,
+	size_t memoryCap, const vector<const Expression*>& clues);
+
+
+// build the right kind of AssignmentStore; the order of the clues matters only to how soon
+// each possible solution is thrown out, so the ones that throw out the most go first
+unique_ptr<AssignmentStore> makeStore(Storage_e storage, size_t numCategories, size_t itemsPerCategory,
+	size_t memoryCap, const vector<const Expression*>& clues) {
+
+	auto ordered = orderBySelectivity(static_cast<int>(numCategories), static_cast<int>(itemsPerCategory), clues);
+	switch (storage) {
+		case Storage_e::Dense:
+			return make_unique<DenseStore>(numCategories, itemsPerCategory, ordered);
+		case Storage_e::Sliced:
+			return make_unique<SlicedStore>(numCategories, itemsPerCategory, ordered);
+		case Storage_e::Ranked:
+			return make_unique<RankedStore>(numCategories, itemsPerCategory, ordered);
+		case Storage_e::Streamed:
+			return make_unique<StreamedStore>(numCategories, itemsPerCategory, memoryCap, ordered);
+		default:
+			throw;												// this will never be reached; cases are exhaustive for Storage_e
+	}
+}
 
-// REQUIRES: <axisIdx> is in the range [0, <categories>), <categories> is at least
-//   2, <itemsPer> is at least 2, <cumulative> is non-negative
-// EFFECTS:  returns the index of the variable corresponding to the intersection of
-//   item 0 in category <axisIdx> and item 0 in category 1 assuming that the variable
-//   at the intersection of item <itemsPer> in category <axisIdx> + 1 and item <itemsPer>
-//   in category <categories> is <cumulative>
-constexpr int sectionStart(int axisIdx, int categories, int itemsPer, int cumulative = 0);
+// constructor; the AssignmentStore is not built until the first clue arrives, and
+// until then every possible solution survives
+LogicEngine::LogicEngine(size_t numCategories, size_t itemsPerCategory, Storage_e storage, size_t memoryCap)
+	: categories{ numCategories }, itemsPer{ itemsPerCategory }, storage{ storage }, memoryCap{ memoryCap },
+	store{ nullptr }, peak{ 0 },
+	batch{}, variables(variablesNeeded(numCategories, itemsPerCategory), 0),
+	statuses(variables.size(), VarStatus_e::Unknown), unknowns{ variables.size() }, changes{} {
+	
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+	assert(memoryCap > 0);
+}
 
-// REQUIRES: <num> is positive
-// EFFECTS:  returns a list of all possible permutations of <num> items indexed 0 through
-//   <num> - 1
-PermutationList_t permutations(int num);
+// constructor with an initial batch of clues
+LogicEngine::LogicEngine(size_t numCategories, size_t itemsPerCategory, const vector<const Expression*>& clues,
+	Storage_e storage, size_t memoryCap)
+	: LogicEngine{ numCategories, itemsPerCategory, storage, memoryCap } {
 
-// REQUIRES: <blockSize> is at least 2
-// EFFECTS:  returns the Cartesian product of <blocks> lists of all possible permutations of
-//   <blockSize> items indexed 0 through <blockSize> - 1
-PermutationList_t permutationsCross(int blocks, int blockSize);
+	evaluateClues(clues);
+}
 
-// REQUIRES: <permutation> is non-empty, <categories> and <itemsPer> are both at least 2
-// EFFECTS:  returns a list of variable indices corresponding to the items of <permutation>,
-//   where each ~n~th value is the index of an item from a category that all belong to the
-//   same group
-vector<int> getVariables(const vector<int>& permutation, int categories, int itemsPer);
+// copy constructor
+LogicEngine::LogicEngine(const LogicEngine& other)
+	: categories{ other.categories }, itemsPer{ other.itemsPer }, storage{ other.storage },
+	memoryCap{ other.memoryCap }, store{ other.store ? other.store->clone() : nullptr }, peak{ other.peak },
+	batch{ other.batch },
+	variables{ other.variables }, statuses{ other.statuses }, unknowns{ other.unknowns },
+	changes{ other.changes } {}
+
+// copy assignment operator
+LogicEngine& LogicEngine::operator=(const LogicEngine& other) {
+	if (this != &other) {
+		categories = other.categories;
+		itemsPer = other.itemsPer;
+		storage = other.storage;
+		memoryCap = other.memoryCap;
+		store = other.store ? other.store->clone() : nullptr;
+		peak = other.peak;
+		batch = other.batch;
+		variables = other.variables;
+		statuses = other.statuses;
+		unknowns = other.unknowns;
+		changes = other.changes;
+	}
+	return *this;
+}
 
+// return the status worked out after the last consistent clue; every variable
+// is unknown until the first clue, since every variable is TRUE in some possible
+// solutions and FALSE in others
+VarStatus_e LogicEngine::getStatus(int varIndex) const {
+	assert(varIndex >= 0 && varIndex < static_cast<int>(statuses.size()));
+	return statuses[varIndex];
+}
 
-// return <num>! * <cumulative>
-constexpr int factorial(int num, int cumulative) {
-	assert(num >= 0);
-	assert(cumulative > 0);
+// solved once no variable is unknown
+bool LogicEngine::solved() const {
+	return (unknowns == 0);
+}
 
-	if (num == 0) {
-		return cumulative;
+// every possible solution remains until the first clue
+size_t LogicEngine::countSurvivors() const {
+	if (!store) {
+		return permutationsCrossSize(static_cast<int>(categories) - 1, static_cast<int>(itemsPer));
 	}
-	return factorial(num - 1, cumulative * num);
+	return store->size();
 }
 
-// return the index of the first variable in the row-block where items from category <axisIdx>
-// label the individual cell rows
-constexpr int sectionStart(int axisIdx, int categories, int itemsPer, int cumulative) {
-	assert(axisIdx >= 0 && axisIdx < categories);
-	assert(categories >= 2);
-	assert(itemsPer >= 2);
-	assert(cumulative >= 0);
+// until <store> is built, it will be built as the kind chosen at construction
+Storage_e LogicEngine::heldAs() const {
+	return (store ? store->kind() : storage);
+}
 
-	if (axisIdx == 0) {
-		return cumulative;
+// have <store> remove every Assignment for which <clue> evaluates to FALSE,
+// keeping the counts in <variables> accurate, then bring the statuses up to
+// date; <store> itself refuses to remove every Assignment, so this returns
+// FALSE for an inconsistent clue, as it does without consulting <store> at all
+// for a clue that the statuses alone already contradict
+bool LogicEngine::evaluateClue(const Expression& clue) {
+	if (!store) {
+		return evaluateClues(vector<const Expression*>{ &clue }).front();
+	}
+	if (clue.evaluate(statuses) == VarStatus_e::False) {
+		return false;
 	}
-	int toAdd = static_cast<int>(pow(itemsPer, 2) * (categories - axisIdx));
-	return sectionStart(axisIdx - 1, categories, itemsPer, cumulative + toAdd);
+	if (!store->filter(clue, variables)) {
+		return false;
+	}
+	watchSurvivors();
+	refreshStatuses();
+	return true;
 }
 
-// return a list of all possible permutations of <num> items, using indices from 0 to <num> - 1
-// to represent the items; use dynamic programming to avoid expensive recalculations
-PermutationList_t permutations(int num) {
-	assert(num > 0);
-	static unordered_map<int, PermutationList_t> precalcs{};				// for dynamic programming
-
-	auto iter = precalcs.find(num);											// find if permutations already calculated
-	if (iter != precalcs.cend()) {
-		return iter->second;
+// the first batch of clues is handed to a new AssignmentStore so that only its survivors
+// are ever held; if nothing survives, a counting pass finds the first clue that leaves
+// nothing, which is rejected just as <evaluateClue()> would have rejected it, and the
+// AssignmentStore is built again without it; a copy of each clue of the batch that was
+// kept is held on to, since nothing else can undo it; once built, each later batch is
+// handed to the AssignmentStore whole, and the statuses are brought up to date once,
+// after the last clue
+vector<bool> LogicEngine::evaluateClues(const vector<const Expression*>& clues) {
+	if (store) {
+		auto results = store->filterAll(clues, variables);
+		watchSurvivors();
+		refreshStatuses();
+		return results;
 	}
 
-	vector<int> items(num);													// list of items to be permuted
-	iota(items.begin(), items.end(), 0);									// fill in ascending order
-
-	PermutationList_t perms{};												// list of permutations
-	perms.reserve(factorial(num));
-	do {
-		perms.emplace_back(items.cbegin(), items.cend());					// add current permutation as new item in list
-	} while (next_permutation(items.begin(), items.end()));					//   as long as there is a next permutation
+	vector<bool> results(clues.size(), true);
+	vector<const Expression*> applied{ clues };
+	vector<size_t> origins(clues.size());						// origins[k] = index in <clues> of applied[k]
+	iota(origins.begin(), origins.end(), 0);
+
+	while (!applied.empty()) {
+		auto built = makeStore(storage, categories, itemsPer, memoryCap, applied);
+		if (built->size() > 0) {
+			store = move(built);
+			store->tally(variables);							// count the TRUE variables of every survivor
+			peak = store->size();
+			refreshStatuses();
+			for (auto clue : applied) {
+				batch.push_back(shared_ptr<const Expression>{ clue->clone() });
+			}
+			return results;
+		}
+		built.reset();
 
-	precalcs[num] = perms;													// store calculation for later use
-	return perms;
+		auto prefixes = enumerateSurvivors(categories, itemsPer, applied, [](size_t, const Assignment&) {});
+		auto culprit = find(prefixes.cbegin(), prefixes.cend(), size_t{ 0 }) - prefixes.cbegin();
+		results[origins[culprit]] = false;
+		applied.erase(applied.begin() + culprit);
+		origins.erase(origins.begin() + culprit);
+	}
+	return results;
 }
 
-// return the Cartesian product of <blocks> permutations of <blockSize> items, using dynamic
-// programming to avoid expensive recalculations
-PermutationList_t permutationsCross(int blocks, int blockSize) {
-	assert(blockSize >= 2);
-	unordered_map<int, unordered_map<int, PermutationList_t>> precalcs;				// for dynamic programming; block->blockSize->list
-
-	if (blocks == 1) {																// recursive base case
-		return permutations(blockSize);
+// each task of the WorkerPool probes <store> with one clue and works out, from the counts
+// that the clue would leave, the statuses of the variables that are still unknown, just as
+// <refreshStatuses()> would; a clue that the statuses alone already settle needs no probe,
+// since it either removes nothing or removes everything; without a <store> the clues have to
+// be evaluated for real, on copies of <this>
+vector<ProbeResult> LogicEngine::probeClues(const vector<const Expression*>& clues) const {
+	if (!store) {
+		return Engine::probeClues(clues);
 	}
 
-	auto iter = precalcs.find(blocks);
-	if (iter != precalcs.cend()) {													// find first based on block count
-		auto iter2 = iter->second.find(blockSize);									//   then based on block size
-		if (iter2 != iter->second.cend()) {
-			return iter2->second;
+	vector<ProbeResult> results(clues.size());
+	WorkerPool::getInstance().run(clues.size(), [&](size_t k) {
+		auto& result = results[k];
+		VarStatus_e known = clues[k]->evaluate(statuses);
+		if (known != VarStatus_e::Unknown) {
+			result.consistent = (known == VarStatus_e::True);
+			result.survivors = (result.consistent ? store->size() : 0);
+			return;
 		}
-	}
 
-	auto myPermutations = permutations(blockSize);
-	auto oneLessPermutations = permutationsCross(blocks - 1, blockSize);			// recursively build list of permutations for rest
-	PermutationList_t cartesianPerms{};
-	cartesianPerms.reserve(myPermutations.size() * oneLessPermutations.size());
+		size_t numVars = variables.size();
+		vector<long long> removedCounts(numVars, 0);
+		size_t removed = store->probe(*clues[k], removedCounts);
 
-	for (const auto& perm : myPermutations) {
-		for (const auto& otherPerm : oneLessPermutations) {
-			cartesianPerms.emplace_back(perm.cbegin(), perm.cend());								// start with this block of permutations
-			copy(otherPerm.cbegin(), otherPerm.cend(), back_inserter(cartesianPerms.back()));		//   then add rest to back
+		result.consistent = (removed < store->size());
+		result.survivors = (result.consistent ? store->size() - removed : 0);
+		if (!result.consistent || removed == 0) {
+			return;
 		}
-	}
-
-	precalcs[blocks][blockSize] = cartesianPerms;									// store for later
-	return cartesianPerms;
-}
 
-// translate each item in <permutations> into a variable index, where [0,1,1,0] would correspond
-// to two groups: one has Cat0Item0 and Cat1Item1, and the second has Cat0Item1 and Cat1Item0
-vector<int> getVariables(const vector<int>& permutation, int categories, int itemsPer) {
-	assert(!permutation.empty());
-	assert(categories >= 2);
-	assert(itemsPer >= 2);
-
-	vector<int> variables;
-	variables.reserve(itemsPer * categories * (categories - 1) / 2);			// categories CHOOSE 2 big cells, itemsPer variables each
-	
-	size_t permSize = permutation.size();
-	for (size_t i = 0; i < permSize; ++i) {
-		int cat = i / itemsPer;
-		int item = i % itemsPer;
-
-		int var = (categories - 1) * itemsPer * item +							// calculate the index of the variable for the item intersecion
-			itemsPer * cat +
-			permutation[i];
-		variables.emplace_back(var);
-	}
+		long long allCount = static_cast<long long>(result.survivors);
+		for (size_t v = 0; v < numVars; ++v) {
+			if (statuses[v] != VarStatus_e::Unknown) {
+				continue;
+			}
 
-	for (int cat = 1; cat < categories; ++cat) {														// get each intracategory match variable
-		for (int item = 0; item < itemsPer; ++item) {
-			for (int otherCat = cat + 1; otherCat < categories; ++otherCat) {
-				int var = sectionStart(categories - otherCat, categories, itemsPer) +					// shift to first cell of row-block
-					permutation[itemsPer * (otherCat - 1) + item] * itemsPer * (otherCat - 1) +			// shift to first cell or row-block row
-					itemsPer * (cat - 1) +																// shift to first cell of blocks intersection
-					permutation[itemsPer * (cat - 1) + item];											// shift to cell of intersection
-				variables.emplace_back(var);
+			long long count = variables[v] - removedCounts[v];
+			if (count == 0) {
+				result.changes.push_back(StatusReport{ static_cast<int>(v), VarStatus_e::False });
+			}
+			else if (count == allCount) {
+				result.changes.push_back(StatusReport{ static_cast<int>(v), VarStatus_e::True });
 			}
 		}
-	}
-	return variables;
+	});
+	return results;
 }
 
-// constructor
-LogicEngine::LogicEngine(size_t numCategories, size_t itemsPerCategory)
-	: variables(variablesNeeded(numCategories, itemsPerCategory), 0) {
-	
-	assert(numCategories >= 2);
-	assert(itemsPerCategory >= 2);
-
-	auto perms = permutationsCross(numCategories - 1, itemsPerCategory);
-	assignments.reserve(perms.size());
-
-	size_t vars = variablesNeeded(numCategories, itemsPerCategory);;
-	for (const auto& perm : perms) {					// for each permutation = possible solution
-		size_t num = perm.size();
-		Assignment assign{ vars };
+// hand over the recorded changes, leaving none behind
+vector<int> LogicEngine::takeChanges() {
+	vector<int> taken;
+	taken.swap(changes);
+	return taken;
+}
 
-		auto vars = getVariables(perm, numCategories, itemsPerCategory);
-		for (auto varIdx : vars) {						// for each of the variables in that solution
-			assign.setTrue(varIdx);						//   set to TRUE in the Assignment
-			++variables[varIdx];						//   increment the TRUE count
-		}
-		assignments.push_back(move(assign));			// add to list of viable Assignments
-	}
+// the clues of the first batch plus the filters of <store>
+size_t LogicEngine::undoableClues() const {
+	return batch.size() + (store ? store->checkpoints() : 0);
 }
 
-// return VarStatus_e::True if the count of the variable at index <varIndex>
-// in <variables> is the same as the number of Assignments remaining in
-// <assignments>, return VarStatus_e::False if the count of the variable at
-// index <varIndex> in <variables> is 0, and return VarStatus_e::Unknown
-// otherwise
-VarStatus_e LogicEngine::getStatus(int varIndex) const {
-	assert(varIndex >= 0 && varIndex < static_cast<int>(variables.size()));
+// undo the filters of <store>, most recent first; only if that is not enough is the first
+// batch cut short, and <store> built again from whatever is left of it
+void LogicEngine::undoClues(size_t count) {
+	assert(count <= undoableClues());
+	if (count == 0) {
+		return;
+	}
 
-	if (variables[varIndex] == 0) {
-		return VarStatus_e::False;
+	size_t filtered = (store ? store->checkpoints() : 0);
+	for (size_t k = 0; k < count && k < filtered; ++k) {
+		store->undo(variables);
 	}
-	else if (variables[varIndex] == static_cast<long long>(assignments.size())) {
-		return VarStatus_e::True;
+	if (store) {
+		watchSurvivors();
 	}
-	else {
-		return VarStatus_e::Unknown;
+
+	if (count > filtered) {
+		batch.resize(batch.size() - (count - filtered));
+		store.reset();
+		peak = 0;
+		fill(variables.begin(), variables.end(), 0);
+		if (!batch.empty()) {
+			vector<const Expression*> clues;
+			for (const auto& clue : batch) {
+				clues.push_back(clue.get());
+			}
+			store = makeStore(storage, categories, itemsPer, memoryCap, clues);
+			store->tally(variables);
+			peak = store->size();
+		}
 	}
+	recomputeStatuses();
 }
 
-// return TRUE if the count of every variable in <variables> is either 0 or
-// the same as the number of Assignments remaining in <assignments>, and
-// return FALSE otherwise
-bool LogicEngine::solved() const {
-	long long allCount = static_cast<long long>(assignments.size());
-	int statused = count_if(variables.cbegin(), variables.cend(),
-		[allCount](auto num)->bool {
-			return (num == 0 || num == allCount);
+// compact once the survivors have fallen to 1/<kCompactFactor> of their peak, adopting the
+// AssignmentStore handed back in place of <store> if there is one; the peak starts out at
+// what <store> held when it was built, since nothing was ever held for the rest, and starts
+// over from the survivors after each compaction, so that the same memory is never released
+// twice over
+void LogicEngine::watchSurvivors() {
+	assert(store);
+
+	size_t live = store->size();
+	if (live > peak) {
+		peak = live;
+	}
+	else if (live * AssignmentStore::kCompactFactor <= peak) {
+		if (auto replacement = store->compact()) {
+			store = move(replacement);
 		}
-	);
+		peak = live;
+	}
+}
 
-	return (statused == static_cast<int>(variables.size()));
+// copy <this> into a new LogicEngine
+unique_ptr<Engine> LogicEngine::clone() const {
+	return make_unique<LogicEngine>(*this);
 }
 
-// evaluate <clue> against every Assignment remaining in <assignments> and
-// remove those for which <clue> evaluates to FALSE; for each such removed
-// Assignment, decrement the counts of all variables set to TRUE by 1;
-// return TRUE if <clue> is consistent (i.e. doesn't evaluate to FALSE for
-// all active Assignments) and return FALSE otherwise
-bool LogicEngine::evaluateClue(const Expression& clue) {
-	vector<bool> shouldRemove(assignments.size(), false);				// TRUE if assignments[i] causes FALSE evaluation
-	int totalToRemove = 0;
-
-	size_t numAssigns = assignments.size();
-	for (size_t i = 0; i < numAssigns; ++i) {
-		if (!clue.evaluate(assignments[i])) {							// FALSE evaluation
-			shouldRemove[i] = true;										//   so should remove this Assignment
-			++totalToRemove;
+// a variable is "guaranteed to be false" if it is TRUE in no remaining Assignment and
+// "guaranteed to be true" if it is TRUE in all of them; a variable that is already one
+// or the other can only change again when a clue is undone, so only the unknown ones
+// are looked at
+void LogicEngine::refreshStatuses() {
+	assert(store);
+
+	long long allCount = static_cast<long long>(store->size());
+	int numVars = static_cast<int>(variables.size());
+	for (int v = 0; v < numVars; ++v) {
+		if (statuses[v] != VarStatus_e::Unknown) {
+			continue;
 		}
-	}
 
-	if (totalToRemove == numAssigns) {									// would remove everything, indicating logical inconsistency
-		return false;
+		if (variables[v] == 0) {
+			statuses[v] = VarStatus_e::False;
+		}
+		else if (variables[v] == allCount) {
+			statuses[v] = VarStatus_e::True;
+		}
+		else {
+			continue;
+		}
+		changes.push_back(v);
+		--unknowns;
 	}
+}
 
-	for (size_t i = 0; i < numAssigns; ++i) {
-		if (shouldRemove[i]) {
-			auto end = assignments[i].trueEnd();
-			for (auto begin = assignments[i].trueBegin(); begin != end; ++begin) {				// decrement counts for TRUE variables
-				--variables[*begin];
-			}
+// undoing a clue can make a known variable unknown again, so every variable is looked at;
+// without a <store>, nothing is known
+void LogicEngine::recomputeStatuses() {
+	long long allCount = static_cast<long long>(store ? store->size() : 0);
+	int numVars = static_cast<int>(variables.size());
+	for (int v = 0; v < numVars; ++v) {
+		auto status = VarStatus_e::Unknown;
+		if (store && variables[v] == 0) {
+			status = VarStatus_e::False;
+		}
+		else if (store && variables[v] == allCount) {
+			status = VarStatus_e::True;
 		}
-	}
 
-	int index = 0;
-	assignments.erase(remove_if(assignments.begin(), assignments.end(),
-		[&index, &shouldRemove](const auto&)->bool {					// ignore the Assignment; it's not important
-			return (shouldRemove[index++]);								// remove if should, reference-incrementing index
-		}),
-	assignments.end());
-	return true;
+		if (status == statuses[v]) {
+			continue;
+		}
+		if (statuses[v] == VarStatus_e::Unknown) {
+			--unknowns;
+		}
+		else if (status == VarStatus_e::Unknown) {
+			++unknowns;
+		}
+		statuses[v] = status;
+		changes.push_back(v);
+	}
 }
\ No newline at end of file
@@ -1,30 +1,37 @@
 #ifndef EUNOMIA_LOGIC_ENGINE
 #define EUNOMIA_LOGIC_ENGINE
 
+#include <memory>												// for unique_ptr, shared_ptr
 #include <vector>												// for vector
-#include "Assignment.h"											// for Assignment (because it's a template parameter)
+#include "AssignmentStore.h"									// for AssignmentStore (because it's a template parameter)
+#include "Engine.h"												// for Engine
+#include "Utility.h"											// for Storage_e, kStreamMemoryCap (because they're default arguments), VarStatus_e, ProbeResult
 
 class Expression;
-enum class VarStatus_e;
 
 /*
-	A LogicEngine is an evaluative computer that tracks the evaluation of a logic Puzzle against one or
-	more clues. The logic Puzzle that the LogicEngine is responsible for handling is set at construction
-	and cannot thereafter be changed. The number of variables that the LogicEngine treats is equal to the
-	total number of inter-category combinations of items in that logic Puzzle.
+	A LogicEngine is a kind of Engine, an evaluative computer that tracks the evaluation of a logic Puzzle
+	against one or more clues. The logic Puzzle that the LogicEngine is responsible for handling is set at
+	construction and cannot thereafter be changed. The number of variables that the LogicEngine treats is
+	equal to the total number of inter-category combinations of items in that logic Puzzle.
 
-	At construction, a LogicEngine generates a finite set of possible Boolean Assignments of all the
-	variables for which it is responsible. These Assignments correspond to the sum total of all possible
-	solutions to the logic Puzzle. Notably, because of the rules of logic Puzzles, a logic Puzzle with
-	~N~ variables has significantly fewer than ~2^N~ possible solutions.
+	A LogicEngine works with a finite set of possible Boolean Assignments of all the variables for which it
+	is responsible. These Assignments correspond to the sum total of all possible solutions to the logic
+	Puzzle. Notably, because of the rules of logic Puzzles, a logic Puzzle with ~N~ variables has
+	significantly fewer than ~2^N~ possible solutions. The Assignments are not generated until the first
+	clue (or batch of clues) arrives, and those that the first batch eliminates are never held at all.
+	How they are held is chosen at construction through a Storage_e and delegated to an AssignmentStore,
+	which the LogicEngine has compact once few of the Assignments it was built with survive; the choice
+	affects only speed and memory, never the results.
 
 	The primary action that a LogicEngine can perform is to evaluate a clue. A clue is a Boolean Expression
 	consisting of variables that the LogicEngine is responsible for handling. When a LogicEngine evaluates
 	a clue, it considers all active Assignments and eliminates those that do not cause the clue to evaluate
-	to TRUE. These Assignments are irrecoverably discarded and never again considered. It is not possible to
-	undo an evaluation of a clue. However, if a clue is evaluated that eliminates all possible Assignments,
-	and is thus an inconsistent clue, the eliminations will be rolled back and the LogicEngine will be in a
-	state as if the clue were never evaluated.
+	to TRUE. These Assignments are no longer considered, but the evaluation can be undone, and they will
+	be restored. If a clue is evaluated that eliminates all possible Assignments, and is thus an
+	inconsistent clue, the eliminations will be rolled back and the LogicEngine will be in a state as if
+	the clue were never evaluated. A clue can also be probed, which reports what evaluating it would
+	change without changing anything.
 
 	As the LogicEngine eliminates possible Assignments, it keeps track of the status of each variable it is
 	responsible for. The status of a variable is either "guaranteed to be true" (meaning that the variable
@@ -36,23 +43,49 @@ enum class VarStatus_e;
 	variable has a non-unknown status, or "unsolved") can be determined through an inquiry.
 */
 
-class LogicEngine {
+class LogicEngine : public Engine {
 	public:
-		// [Constructor]
-		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2
-		LogicEngine(size_t numCategories, size_t itemsPerCategory);
+		// [Constructors]
+		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, <memoryCap> is
+		//   positive, each variable that forms part of each of <clues> is within the scope of
+		//   <this>; <memoryCap> is ignored unless <storage> is Storage_e::Streamed
+		// EFFECTS:  constructs <this> with no clues evaluated, or as if <clues> were then passed
+		//   to <evaluateClues()>
+		LogicEngine(size_t numCategories, size_t itemsPerCategory, Storage_e storage = Storage_e::Dense,
+			size_t memoryCap = kStreamMemoryCap);
+		LogicEngine(size_t numCategories, size_t itemsPerCategory, const std::vector<const Expression*>& clues,
+			Storage_e storage = Storage_e::Dense, size_t memoryCap = kStreamMemoryCap);
+
+		// [Copy Constructor and Assignment Operator]
+		// EFFECTS:  makes <this> an independent copy of <other>, including all of the Assignments
+		//   of <other> that remain viable
+		LogicEngine(const LogicEngine& other);
+		LogicEngine& operator=(const LogicEngine& other);
+
+		// [Move Constructor and Assignment Operator]
+		LogicEngine(LogicEngine&& other) = default;
+		LogicEngine& operator=(LogicEngine&& other) = default;
 
 		// [Status Accessor]
 		// REQUIRES: <varIndex> is non-negative and less than the total number of variables
 		//   implied by the <puzzle> used to construct <this>
 		// EFFECTS:  returns the status of the <varIndex>th variable based on the logic
 		//   peformed thus far
-		VarStatus_e getStatus(int varIndex) const;
+		VarStatus_e getStatus(int varIndex) const override;
 
 		// [Solved Checker]
 		// EFFECTS:  returns TRUE if the status of every variable is either "guaranteed to
 		//   be true" or "guaranteed to be false," and returns FALSE otherwise
-		bool solved() const;
+		bool solved() const override;
+
+		// [Survivor Counter]
+		// EFFECTS:  returns the number of possible solutions that remain
+		size_t countSurvivors() const override;
+
+		// [Storage Accessor]
+		// EFFECTS:  returns the kind of AssignmentStore that holds the viable Assignments of <this>,
+		//   which is the kind chosen at construction unless compacting has since replaced it
+		Storage_e heldAs() const;
 
 		// [Clue Evaluator]
 		// REQUIRES: each variable that forms part of <clue> is within the scope of <this>,
@@ -64,11 +97,83 @@ class LogicEngine {
 		//   eliminated; if <clue> was an inconsistent clue (meaning that it somehow contradcits
 		//   at least one clue previously evaluated by <this>), returns FALSE and makes no
 		//   changes whatsoever; returns TRUE otherwise
-		bool evaluateClue(const Expression& clue);
+		bool evaluateClue(const Expression& clue) override;
+
+		// [Batch Clue Evaluator]
+		// REQUIRES: each variable that forms part of each of <clues> is within the scope of <this>
+		// MODIFIES: <this>
+		// EFFECTS:  evaluates each of <clues> in order exactly as <evaluateClue()> would, and returns
+		//   a list with one element per clue that is TRUE if and only if that clue was consistent;
+		//   if no clue has yet been evaluated by <this>, all of <clues> are applied while the
+		//   Assignments are generated, those that look the most selective first, and otherwise they
+		//   are filtered as one batch; the statuses are worked out once, after the last clue, so
+		//   changes are recorded in order of index
+		std::vector<bool> evaluateClues(const std::vector<const Expression*>& clues) override;
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of each of <clues> is within the scope of <this>
+		// EFFECTS:  returns a list with one element per clue describing what <evaluateClue()> would
+		//   do if it were handed that clue next, without changing <this>; the clues are weighed
+		//   independently of each other, in parallel on the WorkerPool, each against the same
+		//   viable Assignments, none of which is copied; until the first clue arrives, each clue is
+		//   instead evaluated on a copy of <this>
+		std::vector<ProbeResult> probeClues(const std::vector<const Expression*>& clues) const override;
+
+		// [Change Collector]
+		// MODIFIES: <this>
+		// EFFECTS:  returns the index of each variable whose status has changed since <this> was
+		//   constructed or since the last call to <takeChanges()>, in the order in which they
+		//   changed, and forgets them
+		std::vector<int> takeChanges() override;
+
+		// [Undo Depth Accessor]
+		// EFFECTS:  returns the number of consistent clues evaluated by <this> that have not been undone
+		size_t undoableClues() const override;
+
+		// [Clue Undoer]
+		// REQUIRES: <count> is no greater than <undoableClues()>
+		// MODIFIES: <this>
+		// EFFECTS:  returns <this> to the state it was in before the last <count> consistent clues
+		//   that have not been undone were evaluated, recording each variable whose status changes;
+		//   undoing a clue of the first batch regenerates the Assignments from the rest of that batch
+		void undoClues(size_t count) override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new LogicEngine that is an independent copy of <this>
+		std::unique_ptr<Engine> clone() const override;
 
 	private:
-		std::vector<Assignment> assignments;
+		size_t categories;
+		size_t itemsPer;
+		Storage_e storage;
+		size_t memoryCap;
+		std::unique_ptr<AssignmentStore> store;
+		size_t peak;											// the most survivors since <store> was built or last compacted
+		std::vector<std::shared_ptr<const Expression>> batch;
 		std::vector<long long> variables;
+		std::vector<VarStatus_e> statuses;
+		size_t unknowns;
+		std::vector<int> changes;
+
+		// REQUIRES: <store> is not null, <variables> is accurate for <store>
+		// MODIFIES: <this>
+		// EFFECTS:  updates the status of each variable whose status is still "unknown" from its
+		//   count in <variables>, appending the index of each one that changes to <changes>
+		void refreshStatuses();
+
+		// REQUIRES: <store> is not null and has just been filtered or undone
+		// MODIFIES: <this>
+		// EFFECTS:  has <store> compact once its survivors have fallen to no more than a small
+		//   fraction of <peak>, replacing <store> with whatever it hands back, and then lowers
+		//   <peak> to them; otherwise raises <peak> to them if they exceed it
+		void watchSurvivors();
+
+		// REQUIRES: <variables> is accurate for <store>, or all zero if <store> is null
+		// MODIFIES: <this>
+		// EFFECTS:  works out the status of every variable afresh from its count in <variables>,
+		//   or as "unknown" if <store> is null, appending the index of each one that changes to
+		//   <changes>
+		void recomputeStatuses();
 };
 
 #endif
\ No newline at end of file
@@ -2,13 +2,15 @@
 #include "Model.h"												// for Model
 #include "Parser.h"												// for Parser
 #include "Puzzle.h"												// for Puzzle
-#include "Utility.h"											// for VarStatus_e, EunomiaException
+#include "Utility.h"											// for VarStatus_e, EunomiaException, PuzzleId_t, etc.
 #include "View.h"												// for View
 #include <algorithm>											// for find_if, remove_if
 #include <memory>												// for unique_ptr
+#include <span>													// for span
 #include <string>												// for string
 #include <utility>												// for move
 
+using std::span;
 using std::string;
 using std::unique_ptr;
 using std::find_if; using std::remove_if;
@@ -39,8 +41,9 @@ struct ViewHasName {
 };
 
 
-// constructor
-Model::Model() {}
+// constructor; ids start just past <kNoPuzzle>
+Model::Model()
+	: nextId{ kNoPuzzle + 1 } {}
 
 // return function-static Singleton instace
 Model& Model::getInstance() {
@@ -64,13 +67,21 @@ bool Model::nameIsUsed(const std::string& name) const {
 }
 
 // make sure that <puzzle> has a unique name, then add the <puzzle>/<parser>
-// pair to the Puzzle map indexed on <puzzle>'s name
+// pair to the Puzzle map indexed on <puzzle>'s name under a new id, and
+// subscribe any View already waiting on that name
 void Model::openPuzzle(const Puzzle& puzzle, const Parser& parser) {
 	auto found = puzzles.find(puzzle.getName());
 	if (found != puzzles.end()) {
 		throw EunomiaException{ kDuplicatePuzzleMsg };
 	}
-	puzzles.emplace(puzzle.getName(), PuzzleInfo{ puzzle, parser });
+
+	PuzzleId_t id = nextId++;
+	puzzles.emplace(puzzle.getName(), PuzzleInfo{ puzzle, parser, id });
+	for (const auto& view : views) {
+		if (view->getPuzzle() == puzzle.getName()) {
+			view->subscribe(id);
+		}
+	}
 }
 
 // make sure that there's a Puzzle with the name <puzzleName>, then remove
@@ -94,12 +105,14 @@ bool ViewHasName::operator()(const unique_ptr<View>& view) const {
 	return (view->getName() == target);
 }
 
-// make sure that <view> has a unique name, then add it to the Views list
+// make sure that <view> has a unique name, then subscribe it to its Puzzle's
+// id (if that Puzzle is open) and add it to the Views list
 void Model::attachView(std::unique_ptr<View>&& view) {
 	auto found = find_if(views.cbegin(), views.cend(), ViewHasName{ view->getName() });
 	if (found != views.cend()) {
 		throw EunomiaException{ kDuplicateViewMsg };
 	}
+	view->subscribe(idOf(view->getPuzzle()));
 	views.push_back(move(view));
 }
 
@@ -131,17 +144,32 @@ void Model::detachPuzzleViews(const string& puzzleName) {
 	}
 }
 
-// forward data to all Views
+// forward data to all Views as a batch of one
 void Model::reportStatus(const string& puzzleName, int varIndex, VarStatus_e status) {
+	StatusReport report{ varIndex, status };
+	reportStatuses(puzzleName, span<const StatusReport>{ &report, 1 });
+}
+
+// look up the id once, then forward the whole batch to all Views; a Puzzle that
+// isn't open has no subscribers
+void Model::reportStatuses(const string& puzzleName, span<const StatusReport> reports) {
+	PuzzleId_t id = idOf(puzzleName);
+	if (id == kNoPuzzle || reports.empty()) {
+		return;
+	}
 	for (const auto& view : views) {
-		view->reportStatus(puzzleName, varIndex, status);
+		view->reportStatuses(id, reports);
 	}
 }
 
-// forward data to all Views
+// look up the id once, then forward data to all Views
 void Model::reportItem(const string& puzzleName, int category, int item, const string& itemStr) {
+	PuzzleId_t id = idOf(puzzleName);
+	if (id == kNoPuzzle) {
+		return;
+	}
 	for (const auto& view : views) {
-		view->reportItem(puzzleName, category, item, itemStr);
+		view->reportItem(id, category, item, itemStr);
 	}
 }
 
@@ -157,6 +185,15 @@ bool Model::assess(const string& puzzleName, const string& clue) {
 	return found->second.puzzle.applyClue(*parsedClue);
 }
 
+// make sure there's a Puzzle with the name <puzzleName>, then have it undo its clues
+size_t Model::undo(const string& puzzleName, size_t count) {
+	auto found = puzzles.find(puzzleName);
+	if (found == puzzles.cend()) {
+		throw EunomiaException{ kNonexistPuzzleMsg };
+	}
+	return found->second.puzzle.undoClues(count);
+}
+
 // print all Views to the standard output stream
 void Model::displayAll() const {
 	for (const auto& view : views) {
@@ -187,4 +224,10 @@ void Model::displayPuzzleViews(const string& puzzleName) const {
 			view->display();
 		}
 	}
+}
+
+// find the Puzzle by name
+PuzzleId_t Model::idOf(const string& puzzleName) const {
+	auto found = puzzles.find(puzzleName);
+	return (found == puzzles.cend() ? kNoPuzzle : found->second.id);
 }
\ No newline at end of file
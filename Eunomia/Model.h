@@ -2,13 +2,14 @@
 #define EUNOMIA_MODEL
 
 #include <memory>												// for unique_ptr (because it's a template parameter)
+#include <span>													// for span
 #include <string>												// for string
 #include <vector>												// for vector
 #include <unordered_map>										// for unordered_map
 #include "Parser.h"												// for Parser (because it's a using'd member variable)
 #include "Puzzle.h"												// for Puzzle (because it's a using'd member variable)
+#include "Utility.h"											// for VarStatus_e, PuzzleId_t, StatusReport
 
-enum class VarStatus_e;
 class View;
 
 /*
@@ -31,9 +32,13 @@ class View;
 
 	Data is reported to the Model by Puzzles, and the data is forwarded to all of the active Views, which may handle
 	the information in some specific fashion. The Model does not keep track of whether or not data has changed since
-	the last time it was reported.
+	the last time it was reported. Each opened Puzzle is given a compact id, never reused, and each View is subscribed
+	to the id of the open Puzzle whose name it was constructed with, whether the View is attached before or after
+	that Puzzle is opened. The name of the reporting Puzzle is looked up once per report, and the Views are then
+	told only the id. Statuses are reported in batches, each delivered to every View in a single call.
 
 	Clues are applied to Puzzles through the Model, which will first parse the clue using the appopriate Parser.
+	The most recent clues applied to a Puzzle can also be undone through the Model.
 */
 
 class Model {
@@ -79,6 +84,7 @@ class Model {
 		// EFFECTS:  forwards the reported information to each of the active Views, which may or
 		//   may not further handle the information in some way
 		void reportStatus(const std::string& puzzleName, int varIndex, VarStatus_e status);
+		void reportStatuses(const std::string& puzzleName, std::span<const StatusReport> reports);
 		void reportItem(const std::string& puzzleName, int category, int item, const std::string& itemStr);
 
 		// [Clue Assessor]
@@ -89,6 +95,14 @@ class Model {
 		//   name <puzzleName>, throws a EunomiaException
 		bool assess(const std::string& puzzleName, const std::string& clue);
 
+		// [Clue Undoer]
+		// MODIFIES: the active Puzzle with the name <puzzleName>
+		// EFFECTS:  undoes the last <count> consistent clues applied to the Puzzle with name
+		//   <puzzleName> that have not yet been undone, or all of them if there are fewer, and
+		//   returns the number undone; if no active Puzzle exists with the name <puzzleName>,
+		//   throws a EunomiaException
+		size_t undo(const std::string& puzzleName, size_t count);
+
 		// [Displayers]
 		// MODIFIES: standard output
 		// EFFECTS:  prints all the active Views, the active View with the name <viewName>, or
@@ -100,13 +114,19 @@ class Model {
 		void displayPuzzleViews(const std::string& puzzleName) const;
 
 	private:
-		using PuzzleInfo = struct { Puzzle puzzle; Parser parser; };
+		using PuzzleInfo = struct { Puzzle puzzle; Parser parser; PuzzleId_t id; };
 
 		std::unordered_map<std::string, PuzzleInfo> puzzles;
 		std::vector<std::unique_ptr<View>> views;
+		PuzzleId_t nextId;
 
 		// [Constructor]
 		Model();
+
+		// [Id Accessor]
+		// EFFECTS:  returns the id of the active Puzzle with the name <puzzleName>, or
+		//   <kNoPuzzle> if there is no such Puzzle
+		PuzzleId_t idOf(const std::string& puzzleName) const;
 };
 
 #endif
\ No newline at end of file
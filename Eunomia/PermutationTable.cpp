@@ -0,0 +1,195 @@
+#include "PermutationTable.h"									// for PermutationTable
+#include <algorithm>											// for next_permutation, swap, min
+#include <array>												// for array
+#include <cassert>												// for assert
+#include <cstdint>												// for int8_t
+#include <memory>												// for unique_ptr
+#include <mutex>												// for mutex, lock_guard
+#include <numeric>												// for iota
+#include <unordered_map>										// for unordered_map
+#include <vector>												// for vector
+
+using std::int8_t;
+using std::array; using std::vector; using std::unordered_map;
+using std::next_permutation; using std::swap; using std::min;
+using std::iota;
+using std::unique_ptr;
+using std::mutex; using std::lock_guard;
+
+// REQUIRES: <items> is non-negative
+// EFFECTS:  returns <items>!, the number of permutations of <items> items
+constexpr size_t permutationCount(int items);
+
+// REQUIRES: <Items> is positive
+// EFFECTS:  returns every permutation of <Items> items in lexicographic order, back to back;
+//   the table for one fewer item must be available at compile time
+template <int Items>
+constexpr array<int8_t, permutationCount(Items) * Items> generateTable();
+
+// REQUIRES: <items> is positive
+// MODIFIES: <entries>
+// EFFECTS:  appends every permutation of <items> items in lexicographic order, back to back,
+//   to <entries>
+void generateTable(int items, vector<int8_t>& entries);
+
+// REQUIRES: <items> is positive
+// MODIFIES: <steps>
+// EFFECTS:  appends every permutation of <items> items to <steps> in minimal-change order, each
+//   as its index in lexicographic order and the position of the swap that reaches it
+void generateGrayOrder(int items, vector<PermutationTable::GrayStep>& steps);
+
+// the tables of every size up to <kMaxStaticPermutationSize>, generated by the compiler
+template <int Items>
+constexpr auto kStaticTable = generateTable<Items>();
+
+
+// return <items>!
+constexpr size_t permutationCount(int items) {
+	return (items <= 1) ? 1 : items * permutationCount(items - 1);
+}
+
+// build on the table for one fewer item, which keeps the work done by the compiler down to a
+// single write per entry: in lexicographic order, the permutations that start with ~f~ are
+// ~f~ followed by each shorter permutation in order, with every item from ~f~ up shifted by one
+template <int Items>
+constexpr array<int8_t, permutationCount(Items) * Items> generateTable() {
+	array<int8_t, permutationCount(Items) * Items> table{};
+	if constexpr (Items > 1) {
+		const auto& shorter = kStaticTable<Items - 1>;
+		size_t shorterRows = permutationCount(Items - 1);
+
+		size_t at = 0;
+		for (int first = 0; first < Items; ++first) {
+			for (size_t row = 0; row < shorterRows; ++row) {
+				table[at++] = static_cast<int8_t>(first);
+				for (int i = 0; i < Items - 1; ++i) {
+					int8_t item = shorter[row * (Items - 1) + i];
+					table[at++] = static_cast<int8_t>(item >= first ? item + 1 : item);
+				}
+			}
+		}
+	}
+	return table;
+}
+
+// the same as the compile-time generator, but into a buffer sized at runtime
+void generateTable(int items, vector<int8_t>& entries) {
+	vector<int8_t> perm(items);
+	iota(perm.begin(), perm.end(), int8_t{ 0 });
+
+	entries.reserve(entries.size() + permutationCount(items) * items);
+	do {
+		entries.insert(entries.end(), perm.cbegin(), perm.cend());
+	} while (next_permutation(perm.begin(), perm.end()));
+}
+
+// Even's version of Steinhaus-Johnson-Trotter: each item looks left or right, and the largest
+// item that looks at a smaller neighbour swaps with it, after which every larger item turns
+// around; the index of each permutation is its Lehmer code, read off one entry at a time
+void generateGrayOrder(int items, vector<PermutationTable::GrayStep>& steps) {
+	vector<int> perm(items);
+	vector<int> looks(items, -1);										// looks[item] = -1 if looking left, +1 if right
+	iota(perm.begin(), perm.end(), 0);
+
+	steps.reserve(steps.size() + permutationCount(items));
+	steps.push_back(PermutationTable::GrayStep{ 0, 0 });
+	while (true) {
+		int mobile = -1;
+		int at = -1;
+		for (int i = 0; i < items; ++i) {
+			int j = i + looks[perm[i]];
+			if (j >= 0 && j < items && perm[j] < perm[i] && perm[i] > mobile) {
+				mobile = perm[i];
+				at = i;
+			}
+		}
+		if (mobile < 0) {
+			return;
+		}
+
+		int other = at + looks[mobile];
+		swap(perm[at], perm[other]);
+		for (int item = mobile + 1; item < items; ++item) {
+			looks[item] = -looks[item];
+		}
+
+		size_t row = 0;
+		for (int i = 0; i < items; ++i) {
+			int smallerAfter = 0;
+			for (int j = i + 1; j < items; ++j) {
+				smallerAfter += (perm[j] < perm[i]);
+			}
+			row = row * (items - i) + smallerAfter;
+		}
+		steps.push_back(PermutationTable::GrayStep{ row, min(at, other) });
+	}
+}
+
+// hand out the compile-time tables directly; generate any larger table once, under a lock
+// so that two threads never generate the same table, and keep it for the rest of the process
+const PermutationTable& PermutationTable::of(int items) {
+	assert(items > 0);
+
+	static const PermutationTable staticTables[kMaxStaticPermutationSize] = {
+		{ 1, kStaticTable<1>.data() },
+		{ 2, kStaticTable<2>.data() },
+		{ 3, kStaticTable<3>.data() },
+		{ 4, kStaticTable<4>.data() },
+		{ 5, kStaticTable<5>.data() },
+		{ 6, kStaticTable<6>.data() },
+		{ 7, kStaticTable<7>.data() },
+		{ 8, kStaticTable<8>.data() }
+	};
+	if (items <= kMaxStaticPermutationSize) {
+		return staticTables[items - 1];
+	}
+
+	static mutex guard;
+	static unordered_map<int, unique_ptr<PermutationTable>> generatedTables;
+	lock_guard<mutex> lock{ guard };
+
+	auto& table = generatedTables[items];
+	if (!table) {
+		table.reset(new PermutationTable{ items });
+	}
+	return *table;
+}
+
+// constructor over a compile-time table
+PermutationTable::PermutationTable(int items, const int8_t* entries)
+	: items{ items }, rows{ permutationCount(items) }, generated{}, entries{ entries } {
+
+	assert(items > 0);
+	generateGrayOrder(items, gray);
+}
+
+// constructor that generates its own table
+PermutationTable::PermutationTable(int items)
+	: items{ items }, rows{ permutationCount(items) }, generated{}, entries{ nullptr } {
+
+	assert(items > 0);
+	generateTable(items, generated);
+	entries = generated.data();
+	generateGrayOrder(items, gray);
+}
+
+// return the number of items
+int PermutationTable::width() const {
+	return items;
+}
+
+// return the number of permutations
+size_t PermutationTable::count() const {
+	return rows;
+}
+
+// each permutation is <items> entries long
+const int8_t* PermutationTable::operator[](size_t index) const {
+	assert(index < rows);
+	return entries + index * items;
+}
+
+// return the minimal-change order
+const vector<PermutationTable::GrayStep>& PermutationTable::grayOrder() const {
+	return gray;
+}
\ No newline at end of file
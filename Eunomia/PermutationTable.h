@@ -0,0 +1,82 @@
+#ifndef EUNOMIA_PERMUTATION_TABLE
+#define EUNOMIA_PERMUTATION_TABLE
+
+#include <cstdint>												// for int8_t
+#include <vector>												// for vector
+
+/*
+	A PermutationTable is a read-only list of every permutation of a given number of items, indexed 0
+	through one less than that number, in lexicographic order. The permutations are stored back to back in
+	a single contiguous buffer of one-byte entries, so that the ~r~th permutation is simply the ~r~th run of
+	entries. Because lexicographic order is also the order of Lehmer codes, the ~r~th permutation is the one
+	whose Lehmer code is ~r~.
+
+	There is exactly one PermutationTable for each number of items, and it is shared read-only by everything
+	that asks for it for the lifetime of the process; PermutationTables therefore cannot be copied. The
+	tables for up to <kMaxStaticPermutationSize> items are generated at compile time. A table for more items
+	is generated the first time that it is asked for, and it may be asked for from several threads at once.
+
+	Each PermutationTable also lists its permutations in minimal-change (Steinhaus-Johnson-Trotter) order,
+	starting from the identity, in which each permutation differs from the one before it by a single swap
+	of two neighbouring entries. Stepping through the table in that order lets whatever depends on the
+	permutation be updated for two entries at a time instead of being rebuilt.
+*/
+
+class PermutationTable {
+	public:
+		static constexpr int kMaxStaticPermutationSize = 8;
+
+		/*
+			A GrayStep is one step of the minimal-change order: the index in the table of the permutation
+			reached, and the position of the first of the two neighbouring entries swapped to reach it
+			from the permutation of the step before.
+		*/
+		struct GrayStep {
+			size_t row;
+			int swap;
+		};
+
+		// [Table Accessor]
+		// REQUIRES: <items> is positive and small enough that all <items>! of its permutations
+		//   fit in memory
+		// EFFECTS:  returns the PermutationTable of every permutation of <items> items
+		static const PermutationTable& of(int items);
+
+		// [Copy Constructor and Assignment Operator]
+		PermutationTable(const PermutationTable& other) = delete;
+		PermutationTable& operator=(const PermutationTable& other) = delete;
+
+		// [Size Accessors]
+		// EFFECTS:  returns the number of items in each permutation of <this>, or the number of
+		//   permutations in <this>
+		int width() const;
+		size_t count() const;
+
+		// [Permutation Accessor]
+		// REQUIRES: <index> is less than <count()>
+		// EFFECTS:  returns a pointer to the first of the <width()> entries of the <index>th
+		//   permutation of <this>
+		const std::int8_t* operator[](size_t index) const;
+
+		// [Gray Order Accessor]
+		// EFFECTS:  returns every permutation of <this> as a list of <count()> GraySteps in
+		//   minimal-change order, the first of which is the identity and swaps nothing
+		const std::vector<GrayStep>& grayOrder() const;
+
+	private:
+		int items;
+		size_t rows;
+		std::vector<std::int8_t> generated;
+		const std::int8_t* entries;
+		std::vector<GrayStep> gray;
+
+		// [Constructors]
+		// REQUIRES: <items> is positive; <entries> holds every permutation of <items> items in
+		//   lexicographic order and outlives <this>
+		// EFFECTS:  constructs <this> over the entries generated at compile time, or generates
+		//   the entries of <this> itself
+		PermutationTable(int items, const std::int8_t* entries);
+		explicit PermutationTable(int items);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "Assignment.h"											// for Assignment
+#include "BitSet.h"												// for BitSet
+#include "Expression.h"											// for Expression
+#include "ExpressionProgram.h"									// for ExpressionProgram
+#include "ProjectionMemo.h"										// for ProjectionMemo
+#include "Utility.h"											// for ExpressionNode
+#include <algorithm>											// for sort, unique, max
+#include <atomic>												// for atomic, memory_order_relaxed
+#include <cassert>												// for assert
+#include <cstdint>												// for uint64_t
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::uint64_t;
+using std::vector;
+using std::sort; using std::unique; using std::max;
+using std::move;
+using std::atomic; using std::memory_order_relaxed;
+
+// the multiplier that spreads the keys over the slots (Fibonacci hashing)
+constexpr uint64_t kSpread = 0x9e3779b97f4a7c15;
+
+// kLowPatterns[p] = the word whose bit ~t~ is bit <p> of ~t~, for the bits of a key that vary
+// within a single word of a truth table
+constexpr BitSet::word_t kLowPatterns[] = {
+	0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc, 0xf0f0f0f0f0f0f0f0,
+	0xff00ff00ff00ff00, 0xffff0000ffff0000, 0xffffffff00000000
+};
+
+
+// constructor; the support, the size of the clue, and the number of Assignments expected
+// decide between a truth table, remembered evaluations, and neither
+ProjectionMemo::ProjectionMemo(const Expression& clue, size_t expected)
+	: program{ clue } {
+
+	clue.collectVariables(support);
+	sort(support.begin(), support.end());
+	support.erase(unique(support.begin(), support.end()), support.end());
+
+	size_t budget = kTableFactor * max(expected, size_t{ 1 });
+	if (support.size() <= kMaxTableSupport && (size_t{ 1 } << support.size()) <= budget) {
+		compile(clue);
+		return;
+	}
+
+	vector<ExpressionNode> nodes;
+	clue.flatten(nodes);
+	if (nodes.size() >= kMinNodes && support.size() <= kMaxSupport && expected >= kSlots) {
+		slots.reset(new atomic<uint64_t>[kSlots]);
+		for (size_t s = 0; s < kSlots; ++s) {
+			slots[s].store(0, memory_order_relaxed);
+		}
+	}
+}
+
+// read the projection's bit of the truth table, or look the projection up in its slot, and on
+// a miss evaluate the clue and fill the slot; the slot is only ever replaced whole, so a
+// racing thread sees either key or neither
+bool ProjectionMemo::evaluate(const Assignment& assign) const {
+	if (table.size() > 0) {
+		return table.test(project(assign));
+	}
+	if (!slots) {
+		return program.evaluate(assign);
+	}
+
+	uint64_t key = project(assign);
+	auto& slot = slots[(key * kSpread) >> (64 - kSlotBits)];
+	uint64_t held = slot.load(memory_order_relaxed);
+	if ((held & 1) != 0 && (held >> 2) == key) {
+		return (held & 2) != 0;
+	}
+
+	bool value = program.evaluate(assign);
+	slot.store((key << 2) | (uint64_t{ value } << 1) | 1, memory_order_relaxed);
+	return value;
+}
+
+// compiled only if the truth table was made
+bool ProjectionMemo::compiled() const {
+	return table.size() > 0;
+}
+
+// memoized only if the slots were made
+bool ProjectionMemo::memoized() const {
+	return static_cast<bool>(slots);
+}
+
+// return the number of distinct variables
+size_t ProjectionMemo::supportSize() const {
+	return support.size();
+}
+
+// read each variable of the support in turn; the support is sorted, so neighbouring variables
+// usually share a word of <assign>, which is fetched only once
+uint64_t ProjectionMemo::project(const Assignment& assign) const {
+	uint64_t key = 0;
+	size_t wordIndex = static_cast<size_t>(-1);
+	Assignment::word_t word = 0;
+	for (auto var : support) {
+		size_t w = static_cast<size_t>(var) / Assignment::kWordBits;
+		if (w != wordIndex) {
+			wordIndex = w;
+			word = assign.getWord(w);
+		}
+		key = (key << 1) | ((word >> (var % Assignment::kWordBits)) & 1);
+	}
+	return key;
+}
+
+// the column of the ~i~th variable of the support holds bit ~k-1-i~ of every key, where ~k~ is
+// the size of the support, just as <project()> packs it; a bit that changes within a word of
+// the table repeats a fixed pattern, and any other bit sets or clears whole words; the columns
+// of variables outside the support are left empty, since the clue never reads them
+void ProjectionMemo::compile(const Expression& clue) {
+	assert(!support.empty() && support.size() <= kMaxTableSupport);
+
+	size_t k = support.size();
+	size_t keys = size_t{ 1 } << k;
+	vector<BitSet> columns(static_cast<size_t>(support.back()) + 1);
+	for (size_t i = 0; i < k; ++i) {
+		size_t bit = k - 1 - i;
+		BitSet column{ keys };
+		size_t numWords = column.wordCount();
+		for (size_t w = 0; w < numWords; ++w) {
+			BitSet::word_t word = (bit < 6)
+				? kLowPatterns[bit]
+				: ((w >> (bit - 6)) & 1 ? ~BitSet::word_t{ 0 } : 0);
+			if (keys < BitSet::kWordBits) {								// a table shorter than a word keeps its tail clear
+				word &= (BitSet::word_t{ 1 } << keys) - 1;
+			}
+			column.getWord(w) = word;
+		}
+		columns[support[i]] = move(column);
+	}
+	table = clue.evaluate(columns);
+}
\ No newline at end of file
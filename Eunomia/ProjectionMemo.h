@@ -0,0 +1,87 @@
+#ifndef EUNOMIA_PROJECTION_MEMO
+#define EUNOMIA_PROJECTION_MEMO
+
+#include <atomic>												// for atomic
+#include <cstdint>												// for uint64_t
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "BitSet.h"												// for BitSet
+#include "ExpressionProgram.h"									// for ExpressionProgram
+
+class Assignment;
+class Expression;
+
+/*
+	A ProjectionMemo evaluates a single clue against many Assignments, evaluating it only once for each
+	projection of them onto its support: the variables that form part of the clue. Two Assignments that
+	agree on every variable of the support get the same evaluation, however much else they differ, and the
+	possible solutions of a Puzzle that agree on a few dozen variables number in the thousands. The
+	projection of an Assignment is packed into a key of one bit per variable of the support.
+
+	A clue whose support is small, of no more than <kMaxTableSupport> variables, is compiled up front into
+	a truth table with one bit per key, as long as the table is not much larger than the number of
+	Assignments that the ProjectionMemo is expected to see; the table is built by evaluating the clue once,
+	a word of keys at a time, against columns that enumerate every key. Evaluating such a clue then takes
+	no more than packing the key and reading one bit, however large the clue is.
+
+	Any other clue that is large enough that reading its support is cheaper than evaluating it, with at
+	least <kMinNodes> nodes, and whose support fits in a key, of no more than <kMaxSupport> variables, has
+	its evaluations remembered as it goes instead, in a table of <kSlots> slots into which each key is
+	hashed, so long as enough Assignments are expected to fill it; a key that meets another in its slot
+	simply replaces it, so the table never grows and a miss only ever costs an evaluation. Every other
+	clue is evaluated afresh each time. Wherever a clue is evaluated, it is evaluated through the
+	ExpressionProgram into which it was compiled at construction, so the clue need not outlive the
+	ProjectionMemo.
+
+	Any number of threads can evaluate through the same ProjectionMemo at once, since a truth table is
+	never written after construction, each slot is read and written whole, and every evaluation written
+	for a key is the same.
+*/
+
+class ProjectionMemo {
+	public:
+		static constexpr size_t kMaxTableSupport = 20;
+		static constexpr size_t kTableFactor = 64;
+		static constexpr size_t kMaxSupport = 62;
+		static constexpr size_t kMinNodes = 7;
+		static constexpr size_t kSlotBits = 12;
+		static constexpr size_t kSlots = size_t{ 1 } << kSlotBits;
+
+		// [Constructor]
+		// EFFECTS:  constructs <this> over <clue> for about <expected> Assignments, compiling the truth
+		//   table of <clue> if it is to have one, and otherwise with nothing yet remembered
+		ProjectionMemo(const Expression& clue, size_t expected);
+
+		// [Evaluator]
+		// REQUIRES: each variable that forms part of the clue of <this> is within the scope of <assign>
+		// MODIFIES: <this>
+		// EFFECTS:  returns the evaluation of the clue of <this> under <assign>, remembering it for
+		//   every Assignment with the same projection if the clue is memoized
+		bool evaluate(const Assignment& assign) const;
+
+		// [Memo Accessors]
+		// EFFECTS:  returns TRUE if the clue of <this> was compiled into a truth table and FALSE
+		//   otherwise, returns TRUE if its evaluations are remembered as they are made and FALSE
+		//   otherwise, or returns the number of variables in its support
+		bool compiled() const;
+		bool memoized() const;
+		size_t supportSize() const;
+
+	private:
+		ExpressionProgram program;
+		std::vector<int> support;										// the distinct variables of the clue, in ascending order
+		BitSet table;													// bit ~key~ = the evaluation for ~key~; empty if not compiled
+		std::unique_ptr<std::atomic<std::uint64_t>[]> slots;			// key << 2 | evaluation << 1 | 1, or 0 if empty; null if not memoized
+
+		// REQUIRES: each variable of <support> is within the scope of <assign>
+		// EFFECTS:  returns the projection of <assign> onto <support>, one bit per variable in order
+		std::uint64_t project(const Assignment& assign) const;
+
+		// REQUIRES: <support> is the support of <clue>, is non-empty, and has no more than
+		//   <kMaxTableSupport> variables
+		// MODIFIES: <table>
+		// EFFECTS:  fills <table> with the evaluation of <clue> for every key
+		void compile(const Expression& clue);
+};
+
+#endif
\ No newline at end of file
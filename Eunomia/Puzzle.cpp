@@ -1,16 +1,17 @@
 #include "Category.h"											// for Category
+#include "Engine.h"												// for Engine
 #include "Expression.h"											// for Expression
 #include "Model.h"												// for Model
 #include "Puzzle.h"												// for Puzzle
-#include "Utility.h"											// for variables()
-#include <algorithm>											// for count_if
+#include "Utility.h"											// for variables(), StatusReport, ProbeResult
+#include <algorithm>											// for count_if, min
 #include <cassert>												// for assert
 #include <vector>												// for vector
 #include <string>												// for string
 
 using std::string;
 using std::vector;
-using std::count_if;
+using std::count_if; using std::min;
 
 
 // constructor
@@ -96,10 +97,7 @@ void Puzzle::broadcastState() const {
 		}
 	}
 
-	size_t vars = numVariables();
-	for (size_t i = 0; i < vars; ++i) {
-		model.reportStatus(name, i, logic.getStatus(i));
-	}
+	reportStatuses();
 }
 
 // index <items> are return appropriate Category
@@ -118,22 +116,71 @@ typename Puzzle::iterator_t Puzzle::end() const {
 	return iterator_t{ items.cend() };
 }
 
-// apply <clue> via the internal LogicEngine and return the result of the
-// application, then report variable statues to <Model>
+// apply <clue> via the internal Engine and return the result of the
+// application, then report the changed variable statuses to <Model>
 bool Puzzle::applyClue(const Expression& clue) {
-	bool retVal = logic.evaluateClue(clue);
+	bool retVal = ownLogic().evaluateClue(clue);
+	reportChanges();
+	return retVal;
+}
 
-	auto& model = Model::getInstance();
-	size_t vars = numVariables();
-	for (size_t i = 0; i < vars; ++i) {
-		model.reportStatus(name, i, logic.getStatus(i));
+// apply <clues> via the internal Engine in one batch, so that an Engine that
+// has not yet seen a clue can apply them all while it enumerates, then report
+// the changed variable statuses to <Model> once
+vector<bool> Puzzle::applyClues(const vector<const Expression*>& clues) {
+	auto retVal = ownLogic().evaluateClues(clues);
+	reportChanges();
+	return retVal;
+}
+
+// undo no more clues than the internal Engine can, then report the changed
+// variable statuses to <Model> once; undoing nothing leaves the Engine shared
+size_t Puzzle::undoClues(size_t count) {
+	size_t undone = min(count, logic->undoableClues());
+	if (undone > 0) {
+		ownLogic().undoClues(undone);
+		reportChanges();
 	}
+	return undone;
+}
 
-	return retVal;
+// ask the internal Engine what each of <clues> would do; nothing changes, so
+// nothing is reported to <Model>
+vector<ProbeResult> Puzzle::probeClues(const vector<const Expression*>& clues) const {
+	return logic->probeClues(clues);
+}
+
+// report the status of each variable to <Model> in a single batch
+void Puzzle::reportStatuses() const {
+	int vars = static_cast<int>(numVariables());
+	vector<StatusReport> reports;
+	reports.reserve(vars);
+	for (int i = 0; i < vars; ++i) {
+		reports.push_back(StatusReport{ i, logic->getStatus(i) });
+	}
+	Model::getInstance().reportStatuses(name, reports);
+}
+
+// clone the internal Engine before the first change to it while it is shared
+// with a copy of <this>
+Engine& Puzzle::ownLogic() {
+	if (logic.use_count() > 1) {
+		logic = logic->clone();
+	}
+	return *logic;
+}
+
+// report only what the internal Engine says has changed, in a single batch
+void Puzzle::reportChanges() {
+	vector<StatusReport> reports;
+	for (auto varIndex : logic->takeChanges()) {
+		reports.push_back(StatusReport{ varIndex, logic->getStatus(varIndex) });
+	}
+	Model::getInstance().reportStatuses(name, reports);
 }
 
-// leverage the internal LogicEngine to determine if <this> has been solved
+// leverage the internal Engine to determine if <this> has been solved
 // or not
 bool Puzzle::solved() const {
-	return logic.solved();
+	return logic->solved();
 }
\ No newline at end of file
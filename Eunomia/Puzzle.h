@@ -2,10 +2,12 @@
 #define EUNOMIA_PUZZLE
 
 #include <iterator>												// for distance
+#include <memory>												// for shared_ptr
 #include <string>												// for string
 #include <vector>												// for vector
 #include "Category.h"											// for Category
-#include "LogicEngine.h"										// for LogicEngine
+#include "Engine.h"												// for Engine, makeEngine()
+#include "Utility.h"											// for ProbeResult
 
 class Expression;
 
@@ -24,6 +26,20 @@ class Expression;
 	may be in the same group, probably with other items) needed to represent the Puzzle. Additionally,
 	the Categories that make up the Puzzle are accessible either via an indexer or by range iteration.
 
+	A Puzzle delegates its logic to an Engine chosen at construction: a Puzzle of one of the common shapes
+	uses the ShapedLogicEngine compiled for that shape, any other Puzzle small enough to have every
+	possible solution enumerated uses a LogicEngine, and any larger Puzzle uses a DomainEngine. All of
+	them report exactly the same statuses, so the choice is invisible except in speed and memory.
+
+	The Engine of a Puzzle is shared, copy-on-write: copying a Puzzle copies only a reference to its Engine,
+	and a Puzzle clones its Engine only when it is about to apply or undo a clue while a copy still holds
+	that Engine, so that the copies of a Puzzle kept by the Model and its callers cost no more than one
+	Engine until they diverge. Beyond that, Puzzles of the same shape share only the PermutationTable from
+	which their possible solutions are enumerated.
+
+	A Puzzle can also be asked what applying each of many clues would do without applying any of them, so
+	that a clue can be weighed before it is committed.
+
 	A Puzzle can be told, at any time, to broadcast its current state to the Model. When it does so, it
 	reports the names of every item and the status of every variable.
 */
@@ -36,12 +52,22 @@ class Puzzle {
 		//   has the same size
 		template <typename FwdIter>
 		Puzzle(const std::string& name, const std::string& desc, FwdIter catBegin, FwdIter catEnd)
-			: logic{ std::distance(catBegin, catEnd), catBegin->size() }, items(catBegin, catEnd),
+			: logic{ makeEngine(std::distance(catBegin, catEnd), catBegin->size()) }, items(catBegin, catEnd),
 			name{ name }, description{ desc } {
 		
 			assertConstruction();
 		}
 
+		// [Copy Constructor and Assignment Operator]
+		// EFFECTS:  makes <this> an independent copy of <other>, including the logic performed
+		//   by <other> thus far; the two share that logic until either of them changes it
+		Puzzle(const Puzzle& other) = default;
+		Puzzle& operator=(const Puzzle& other) = default;
+
+		// [Move Constructor and Assignment Operator]
+		Puzzle(Puzzle&& other) = default;
+		Puzzle& operator=(Puzzle&& other) = default;
+
 		// [Name and Description Accessors]
 		// EFFECTS:  returns <this>'s name or description
 		const std::string& getName() const;
@@ -116,6 +142,30 @@ class Puzzle {
 		//   and returns TRUE; otherwise, returns FALSE
 		bool applyClue(const Expression& clue);
 
+		// [Batch Clue Applier]
+		// REQUIRES: each variable that forms part of each of <clues> is a variable that is part
+		//   of <this>
+		// MODIFIES: <this>, <Model> Singleton instance
+		// EFFECTS:  applies each of <clues> to <this> in order exactly as <applyClue()> would, but
+		//   broadcasts the status updates to the <Model> only once, after the last clue; returns
+		//   a list with one element per clue that is TRUE if and only if that clue was consistent
+		std::vector<bool> applyClues(const std::vector<const Expression*>& clues);
+
+		// [Clue Undoer]
+		// MODIFIES: <this>, <Model> Singleton instance
+		// EFFECTS:  undoes the last <count> consistent clues applied to <this> that have not yet been
+		//   undone, or all of them if there are fewer, then broadcasts any status updates to the
+		//   <Model>; returns the number of clues undone
+		size_t undoClues(size_t count);
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of each of <clues> is a variable that is part
+		//   of <this>
+		// EFFECTS:  returns a list with one element per clue describing what <applyClue()> would
+		//   do if it were handed that clue next, without changing <this> or reporting anything to
+		//   the <Model>; the clues are weighed independently of each other, in parallel
+		std::vector<ProbeResult> probeClues(const std::vector<const Expression*>& clues) const;
+
 		// [Solved Checker]
 		// EFFECTS:  returns TRUE if and only if every variable of <this> has a status of "guaranteed
 		//   to be true" or "guaranteed to be false," indicating whether or not <this> has been totally
@@ -123,7 +173,7 @@ class Puzzle {
 		bool solved() const;
 
 	private:
-		LogicEngine logic;
+		std::shared_ptr<Engine> logic;
 		std::vector<Category> items;
 		std::string name;
 		std::string description;
@@ -131,6 +181,20 @@ class Puzzle {
 		// EFFECTS:  asserts if any of the preconditions of the constructor do not hold true, and
 		//   does nothing otherwise; this function has no effect when not built in debug mode
 		void assertConstruction() const;
+
+		// MODIFIES: <Model> Singleton instance
+		// EFFECTS:  reports the status of every variable of <this> to the Model
+		void reportStatuses() const;
+
+		// MODIFIES: <this>
+		// EFFECTS:  replaces <logic> with a clone if anything else holds it too, then returns it
+		Engine& ownLogic();
+
+		// REQUIRES: nothing else holds <logic>
+		// MODIFIES: <this>, <Model> Singleton instance
+		// EFFECTS:  reports to the Model the status of each variable of <this> whose status has
+		//   changed since the last report of changes
+		void reportChanges();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "RankSet.h"											// for RankSet
+#include <algorithm>											// for lower_bound, binary_search, min
+#include <bit>													// for countr_zero, popcount
+#include <cassert>												// for assert
+#include <cstdint>												// for uint16_t
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::uint16_t;
+using std::vector;
+using std::lower_bound; using std::binary_search; using std::min;
+using std::countr_zero; using std::popcount;
+using std::move;
+
+
+// constructor; a full chunk is a single run and an empty one an empty array
+RankSet::RankSet(size_t length, bool value)
+	: chunks((length + kChunkSize - 1) / kChunkSize), length{ length } {
+
+	size_t numChunks = chunks.size();
+	for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+		auto& container = chunks[chunk];
+		if (value) {
+			size_t chunkLen = chunkLength(chunk);
+			container.kind = Kind_e::Runs;
+			container.cardinality = static_cast<uint16_t>(chunkLen);
+			container.values = { uint16_t{ 0 }, static_cast<uint16_t>(chunkLen - 1) };
+		}
+		else {
+			container.kind = Kind_e::Array;
+			container.cardinality = 0;
+		}
+	}
+}
+
+// return the number of ranks in the range
+size_t RankSet::size() const {
+	return length;
+}
+
+// return the number of chunks
+size_t RankSet::chunkCount() const {
+	return chunks.size();
+}
+
+// sum the cardinalities of every chunk
+size_t RankSet::count() const {
+	size_t total = 0;
+	for (const auto& container : chunks) {
+		total += container.cardinality;
+	}
+	return total;
+}
+
+// search the array, read the bit, or find the run that would hold the rank
+bool RankSet::test(size_t rank) const {
+	assert(rank < length);
+
+	const auto& container = chunks[rank / kChunkSize];
+	auto offset = static_cast<uint16_t>(rank % kChunkSize);
+	switch (container.kind) {
+		case Kind_e::Array:
+			return binary_search(container.values.cbegin(), container.values.cend(), offset);
+		case Kind_e::Bitmap:
+			return (container.words[offset / kWordBits] >> (offset % kWordBits)) & 1;
+		case Kind_e::Runs:
+			for (size_t r = 0; r < container.values.size() && container.values[r] <= offset; r += 2) {
+				if (offset <= container.values[r + 1]) {
+					return true;
+				}
+			}
+			return false;
+		default:
+			throw;												// this will never be reached; cases are exhaustive for Kind_e
+	}
+}
+
+// insert into the array until it would outgrow a bitmap; a list of runs is turned into a
+// bitmap or an array first, since a new rank can split or join runs
+void RankSet::set(size_t rank) {
+	assert(rank < length);
+
+	auto& container = chunks[rank / kChunkSize];
+	auto offset = static_cast<uint16_t>(rank % kChunkSize);
+	if (container.kind == Kind_e::Runs) {
+		Chunk_t bits;
+		load(container, bits);
+		store(container, bits);
+	}
+
+	if (container.kind == Kind_e::Array) {
+		auto& values = container.values;
+		auto at = (values.empty() || values.back() < offset)					// ranks usually come in order
+			? values.end()
+			: lower_bound(values.begin(), values.end(), offset);
+		if (at != values.end() && *at == offset) {
+			return;
+		}
+		if (container.cardinality < kArrayMax) {
+			values.insert(at, offset);
+			++container.cardinality;
+			return;
+		}
+		Chunk_t bits;
+		load(container, bits);
+		container.kind = Kind_e::Bitmap;
+		container.words.assign(bits.cbegin(), bits.cend());
+		vector<uint16_t>{}.swap(container.values);
+	}
+
+	word_t& word = container.words[offset / kWordBits];
+	word_t bit = word_t{ 1 } << (offset % kWordBits);
+	if ((word & bit) == 0) {
+		word |= bit;
+		++container.cardinality;
+	}
+}
+
+// keep what both hold; a chunk that <this> leaves empty stays empty
+RankSet& RankSet::operator&=(const RankSet& rhs) {
+	return combine(rhs,
+		[](const Container& mine, const Container&) { return mine.cardinality == 0; },
+		[](word_t mine, word_t theirs) { return mine & theirs; }
+	);
+}
+
+// add what <rhs> holds; a chunk that <rhs> leaves empty is unchanged
+RankSet& RankSet::operator|=(const RankSet& rhs) {
+	return combine(rhs,
+		[](const Container&, const Container& theirs) { return theirs.cardinality == 0; },
+		[](word_t mine, word_t theirs) { return mine | theirs; }
+	);
+}
+
+// remove what <rhs> holds; a chunk that either leaves empty is unchanged
+RankSet& RankSet::andNot(const RankSet& rhs) {
+	return combine(rhs,
+		[](const Container& mine, const Container& theirs) { return mine.cardinality == 0 || theirs.cardinality == 0; },
+		[](word_t mine, word_t theirs) { return mine & ~theirs; }
+	);
+}
+
+// weigh each chunk as an array at two bytes per rank, a bitmap at a fixed size, and a list
+// of runs at four bytes per run, then rebuild it as the smallest; ties go to the array or
+// the bitmap, which are the cheaper to add to
+void RankSet::optimize() {
+	for (auto& container : chunks) {
+		Chunk_t bits;
+		load(container, bits);
+
+		size_t runs = 0;
+		word_t carry = 0;											// the last bit of the previous word
+		for (auto word : bits) {
+			runs += popcount(word & ~((word << 1) | carry));		// a set bit whose predecessor is clear starts a run
+			carry = word >> (kWordBits - 1);
+		}
+
+		size_t arrayBytes = container.cardinality * sizeof(uint16_t);
+		size_t bitmapBytes = kChunkWords * sizeof(word_t);
+		size_t runBytes = runs * 2 * sizeof(uint16_t);
+		if (runBytes < min(arrayBytes, bitmapBytes)) {
+			vector<uint16_t> values;
+			values.reserve(runs * 2);
+			for (size_t offset = 0; offset < kChunkSize; ++offset) {
+				if ((bits[offset / kWordBits] >> (offset % kWordBits)) & 1) {
+					if (offset == 0 || !((bits[(offset - 1) / kWordBits] >> ((offset - 1) % kWordBits)) & 1)) {
+						values.push_back(static_cast<uint16_t>(offset));
+						values.push_back(static_cast<uint16_t>(offset));
+					}
+					else {
+						values.back() = static_cast<uint16_t>(offset);
+					}
+				}
+			}
+			container.kind = Kind_e::Runs;
+			container.values = move(values);
+			vector<word_t>{}.swap(container.words);
+		}
+		else {
+			store(container, bits);
+		}
+	}
+}
+
+// compare chunk by chunk as bitmaps, since equal chunks can be held differently
+bool RankSet::operator==(const RankSet& rhs) const {
+	if (length != rhs.length) {
+		return false;
+	}
+
+	size_t numChunks = chunks.size();
+	for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+		if (chunks[chunk].cardinality != rhs.chunks[chunk].cardinality) {
+			return false;
+		}
+		Chunk_t mine;
+		Chunk_t theirs;
+		load(chunks[chunk], mine);
+		load(rhs.chunks[chunk], theirs);
+		if (mine != theirs) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// inequality operator
+bool RankSet::operator!=(const RankSet& rhs) const {
+	return !(*this == rhs);
+}
+
+// every chunk is full-length but the last
+size_t RankSet::chunkLength(size_t chunk) const {
+	assert(chunk < chunks.size());
+	return min(kChunkSize, length - chunk * kChunkSize);
+}
+
+// set the bit of each offset of the array or of each run, or copy the bitmap
+void RankSet::load(const Container& container, Chunk_t& bits) {
+	bits.fill(0);
+	switch (container.kind) {
+		case Kind_e::Array:
+			for (auto offset : container.values) {
+				bits[offset / kWordBits] |= word_t{ 1 } << (offset % kWordBits);
+			}
+			break;
+		case Kind_e::Bitmap:
+			for (size_t w = 0; w < kChunkWords; ++w) {
+				bits[w] = container.words[w];
+			}
+			break;
+		case Kind_e::Runs:
+			for (size_t r = 0; r < container.values.size(); r += 2) {
+				for (size_t offset = container.values[r]; offset <= container.values[r + 1]; ++offset) {
+					bits[offset / kWordBits] |= word_t{ 1 } << (offset % kWordBits);
+				}
+			}
+			break;
+	}
+}
+
+// count the bits, then build whichever of the two is smaller from scratch, so that the
+// container holds no more memory than it needs
+void RankSet::store(Container& container, const Chunk_t& bits) {
+	size_t cardinality = 0;
+	for (auto word : bits) {
+		cardinality += popcount(word);
+	}
+
+	container.cardinality = static_cast<uint16_t>(cardinality);
+	if (cardinality <= kArrayMax) {
+		vector<uint16_t> values;
+		values.reserve(cardinality);
+		for (size_t w = 0; w < kChunkWords; ++w) {
+			for (word_t word = bits[w]; word != 0; word &= word - 1) {
+				values.push_back(static_cast<uint16_t>(w * kWordBits + countr_zero(word)));
+			}
+		}
+		container.kind = Kind_e::Array;
+		container.values = move(values);
+		vector<word_t>{}.swap(container.words);
+	}
+	else {
+		container.kind = Kind_e::Bitmap;
+		container.words.assign(bits.cbegin(), bits.cend());
+		vector<uint16_t>{}.swap(container.values);
+	}
+}
+
+// unpack both chunks into bitmaps, combine them a word at a time, and pack the result
+template <typename Skip, typename Combine>
+RankSet& RankSet::combine(const RankSet& rhs, Skip skip, Combine op) {
+	assert(rhs.length == length);
+
+	size_t numChunks = chunks.size();
+	for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+		auto& mine = chunks[chunk];
+		const auto& theirs = rhs.chunks[chunk];
+		if (skip(mine, theirs)) {
+			continue;
+		}
+
+		Chunk_t bits;
+		Chunk_t other;
+		load(mine, bits);
+		load(theirs, other);
+		for (size_t w = 0; w < kChunkWords; ++w) {
+			bits[w] = op(bits[w], other[w]);
+		}
+		store(mine, bits);
+	}
+	return *this;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef EUNOMIA_RANK_SET
+#define EUNOMIA_RANK_SET
+
+#include <array>												// for array
+#include <bit>													// for countr_zero
+#include <cstdint>												// for uint8_t, uint16_t, uint64_t
+#include <vector>												// for vector
+
+/*
+	A RankSet is a compressed set of ranks drawn from a fixed-length range that starts at zero, whose length
+	is set at construction and cannot thereafter be changed. Individual ranks can be tested and added, the
+	ranks of the set can be visited in order, and the number of them can be counted.
+
+	The range is split into chunks of <kChunkSize> consecutive ranks, and each chunk holds its own ranks in
+	whichever of three containers suits them: a sorted array of their offsets into the chunk while there are
+	no more than <kArrayMax> of them, a bitmap with one bit per rank of the chunk when there are more, or a
+	list of runs of consecutive ranks, each given by its first and last offset. Adding ranks and combining
+	RankSets settle on an array or a bitmap by the number of ranks alone; only optimizing turns a chunk into
+	runs, where runs are the smallest of the three. An empty chunk is an empty array, so a sparse RankSet
+	costs little more than its ranks, and a full one, held as one run per chunk, next to nothing.
+
+	RankSets are meant to be combined in bulk: intersection, union, and difference are applied chunk by
+	chunk, skipping any chunk that the other RankSet leaves empty. Combining two RankSets requires that both
+	have the same length. Since every chunk is a container of its own, adding ranks to different chunks of
+	the same RankSet from different threads at once is safe.
+*/
+
+class RankSet {
+	public:
+		using word_t = std::uint64_t;
+
+		static constexpr size_t kChunkBits = 12;
+		static constexpr size_t kChunkSize = size_t{ 1 } << kChunkBits;
+		static constexpr size_t kWordBits = 64;
+		static constexpr size_t kChunkWords = kChunkSize / kWordBits;
+		static constexpr size_t kArrayMax = kChunkWords * sizeof(word_t) / sizeof(std::uint16_t);
+
+		// [Constructor]
+		// EFFECTS:  creates a RankSet over the ranks [0, <length>), holding all of them if <value> is
+		//   TRUE and none of them otherwise
+		explicit RankSet(size_t length = 0, bool value = false);
+
+		// [Size Accessors]
+		// EFFECTS:  returns the number of ranks in the range of <this>, or the number of chunks into
+		//   which that range is split
+		size_t size() const;
+		size_t chunkCount() const;
+
+		// [Counter]
+		// EFFECTS:  returns the number of ranks held by <this>
+		size_t count() const;
+
+		// [Rank Accessor]
+		// REQUIRES: <rank> is less than <size()>
+		// EFFECTS:  returns TRUE if <this> holds <rank> and FALSE otherwise
+		bool test(size_t rank) const;
+
+		// [Rank Adder]
+		// REQUIRES: <rank> is less than <size()>
+		// MODIFIES: <this>
+		// EFFECTS:  adds <rank> to <this>, if it is not already there; adding ranks in ascending order
+		//   is the cheapest
+		void set(size_t rank);
+
+		// [Chunk Visitor]
+		// REQUIRES: <chunk> is less than <chunkCount()>
+		// EFFECTS:  calls <visit> with each rank held by <this> in the <chunk>th chunk, in ascending order
+		template <typename Visitor>
+		void visitChunk(size_t chunk, Visitor visit) const;
+
+		// [Combiners]
+		// REQUIRES: <rhs> has the same size as <this>
+		// MODIFIES: <this>
+		// EFFECTS:  keeps only the ranks of <this> that <rhs> also holds, adds every rank that <rhs>
+		//   holds, or removes every rank that <rhs> holds, then returns <this>
+		RankSet& operator&=(const RankSet& rhs);
+		RankSet& operator|=(const RankSet& rhs);
+		RankSet& andNot(const RankSet& rhs);
+
+		// [Optimizer]
+		// MODIFIES: <this>
+		// EFFECTS:  holds each chunk of <this> in the smallest of the three containers, releasing any
+		//   memory that the chunk no longer needs, without changing the ranks held
+		void optimize();
+
+		// [Equality Operators]
+		// EFFECTS:  returns TRUE if <this> and <rhs> have the same size and hold the same ranks, however
+		//   they hold them, and returns FALSE otherwise; returns the opposite for the inequality operator
+		bool operator==(const RankSet& rhs) const;
+		bool operator!=(const RankSet& rhs) const;
+
+	private:
+		enum class Kind_e : std::uint8_t { Array, Bitmap, Runs };
+
+		/*
+			A Container holds the ranks of one chunk as offsets from the first rank of the chunk:
+			in order in <values> if it is an array, as bits of <words> if it is a bitmap, and as the
+			first and last offset of each run, one after the other, in <values> if it is a list of
+			runs. Whichever of the two it does not use is left empty.
+		*/
+		struct Container {
+			Kind_e kind;
+			std::uint16_t cardinality;
+			std::vector<std::uint16_t> values;
+			std::vector<word_t> words;
+		};
+		using Chunk_t = std::array<word_t, kChunkWords>;
+
+		std::vector<Container> chunks;
+		size_t length;
+
+		// REQUIRES: <chunk> is less than <chunkCount()>
+		// EFFECTS:  returns the number of ranks in the range of the <chunk>th chunk of <this>, which is
+		//   <kChunkSize> for every chunk but possibly the last
+		size_t chunkLength(size_t chunk) const;
+
+		// MODIFIES: <bits>
+		// EFFECTS:  overwrites <bits> with the bitmap of the ranks held by <container>
+		static void load(const Container& container, Chunk_t& bits);
+
+		// MODIFIES: <container>
+		// EFFECTS:  makes <container> an array of the offsets set in <bits> if there are no more than
+		//   <kArrayMax> of them, and a bitmap of <bits> otherwise
+		static void store(Container& container, const Chunk_t& bits);
+
+		// REQUIRES: <rhs> has the same size as <this>
+		// MODIFIES: <this>
+		// EFFECTS:  replaces each word of the bitmap of each chunk of <this> with the result of <op> on
+		//   it and the same word of the same chunk of <rhs>, skipping every chunk for which <skip> is
+		//   TRUE given the two Containers; returns <this>
+		template <typename Skip, typename Combine>
+		RankSet& combine(const RankSet& rhs, Skip skip, Combine op);
+};
+
+// step through the array, the set bits of the bitmap, or each run in turn
+template <typename Visitor>
+void RankSet::visitChunk(size_t chunk, Visitor visit) const {
+	const auto& container = chunks[chunk];
+	size_t base = chunk * kChunkSize;
+	switch (container.kind) {
+		case Kind_e::Array:
+			for (auto offset : container.values) {
+				visit(base + offset);
+			}
+			break;
+		case Kind_e::Bitmap:
+			for (size_t w = 0; w < kChunkWords; ++w) {
+				for (word_t word = container.words[w]; word != 0; word &= word - 1) {
+					visit(base + w * kWordBits + std::countr_zero(word));
+				}
+			}
+			break;
+		case Kind_e::Runs:
+			for (size_t r = 0; r < container.values.size(); r += 2) {
+				for (size_t offset = container.values[r]; offset <= container.values[r + 1]; ++offset) {
+					visit(base + offset);
+				}
+			}
+			break;
+	}
+}
+
+#endif
\ No newline at end of file
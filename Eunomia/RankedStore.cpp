@@ -0,0 +1,243 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for permutationsCrossSize(), decodeRank(), enumerateSurvivorSlices()
+#include "Expression.h"											// for Expression
+#include "ProjectionMemo.h"										// for ProjectionMemo
+#include "RankSet.h"											// for RankSet
+#include "RankedStore.h"										// for RankedStore
+#include "Utility.h"											// for Storage_e
+#include "WorkerPool.h"											// for WorkerPool
+#include <cassert>												// for assert
+#include <memory>												// for unique_ptr, make_unique
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::vector;
+using std::unique_ptr; using std::make_unique;
+using std::move;
+
+// the fewest chunks of <survivors> worth handing to one task of the WorkerPool when tallying,
+// and the fewest variables worth handing to one when merging the count deltas of the shards
+constexpr size_t kTallyGrain = 1;
+constexpr size_t kMergeGrain = 16;
+
+
+// constructor; every rank starts out surviving
+RankedStore::RankedStore(size_t numCategories, size_t itemsPerCategory)
+	: survivors{ permutationsCrossSize(numCategories - 1, itemsPerCategory), true },
+	categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+	live = survivors.size();
+}
+
+// constructor with an initial batch of clues; only the surviving ranks start out in
+// <survivors>; the slices gather their surviving ranks in parallel, and the ranks are added
+// afterwards, in order, because neighbouring slices can share a chunk of <survivors>
+RankedStore::RankedStore(size_t numCategories, size_t itemsPerCategory, const vector<const Expression*>& clues)
+	: survivors{ permutationsCrossSize(numCategories - 1, itemsPerCategory) }, live{ 0 },
+	categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+
+	vector<vector<size_t>> sliceRanks(survivorSlices(categories, itemsPer));
+	enumerateSurvivorSlices(categories, itemsPer, clues,
+		[&sliceRanks](size_t slice, size_t rank, const Assignment&) {
+			sliceRanks[slice].push_back(rank);
+		}
+	);
+
+	for (auto& ranks : sliceRanks) {
+		for (auto rank : ranks) {
+			survivors.set(rank);
+		}
+		live += ranks.size();
+		vector<size_t>{}.swap(ranks);
+	}
+}
+
+// constructor from the surviving ranks of another AssignmentStore
+RankedStore::RankedStore(size_t numCategories, size_t itemsPerCategory, RankSet&& ranks)
+	: survivors{ move(ranks) }, categories{ static_cast<int>(numCategories) },
+	itemsPer{ static_cast<int>(itemsPerCategory) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+	assert(survivors.size() == permutationsCrossSize(numCategories - 1, itemsPerCategory));
+	live = survivors.count();
+	assert(live > 0);
+}
+
+// return the number of surviving ranks
+size_t RankedStore::size() const {
+	return live;
+}
+
+// decode each surviving rank and count its TRUE variables; each task of the WorkerPool
+// takes a run of chunks of <survivors> and counts into counts of its own, which are added
+// into <counts> once every task has finished
+void RankedStore::tally(vector<long long>& counts) const {
+	auto& pool = WorkerPool::getInstance();
+	size_t numChunks = survivors.chunkCount();
+	size_t tasks = pool.tasksFor(numChunks, kTallyGrain);
+	vector<vector<long long>> taskCounts(tasks, vector<long long>(counts.size(), 0));
+	pool.run(tasks, [&](size_t task) {
+		auto& mine = taskCounts[task];
+		vector<int> scratch;
+		size_t last = numChunks * (task + 1) / tasks;
+		for (size_t chunk = numChunks * task / tasks; chunk < last; ++chunk) {
+			survivors.visitChunk(chunk, [&](size_t rank) {
+				auto assign = decodeRank(rank, categories, itemsPer, scratch);
+				auto end = assign.trueEnd();
+				for (auto begin = assign.trueBegin(); begin != end; ++begin) {
+					++mine[*begin];
+				}
+			});
+		}
+	});
+
+	size_t numVars = counts.size();
+	for (const auto& mine : taskCounts) {
+		for (size_t v = 0; v < numVars; ++v) {
+			counts[v] += mine[v];
+		}
+	}
+}
+
+// mark the ranks for which <clue> is FALSE in a RankSet of their own, as <probe()> would,
+// and remove them from <survivors> only if something survives; the marked ranks and the
+// totals are kept as a checkpoint
+bool RankedStore::filter(const Expression& clue, vector<long long>& counts) {
+	size_t numVars = counts.size();
+	RankSet cleared{ survivors.size() };
+	vector<long long> removedCounts(numVars, 0);
+
+	size_t removed = mark(clue, &cleared, removedCounts);
+	if (removed == live) {												// would remove everything, indicating logical inconsistency
+		return false;
+	}
+	if (removed == 0) {													// nothing removed, so nothing to change
+		history.push_back(Checkpoint{ RankSet{}, {} });
+		return true;
+	}
+
+	for (size_t v = 0; v < numVars; ++v) {
+		counts[v] -= removedCounts[v];
+	}
+	survivors.andNot(cleared);
+	history.push_back(Checkpoint{ move(cleared), move(removedCounts) });
+	live -= removed;
+	return true;
+}
+
+// mark without a RankSet to mark in
+size_t RankedStore::probe(const Expression& clue, vector<long long>& removedCounts) const {
+	return mark(clue, nullptr, removedCounts);
+}
+
+// return the number of checkpoints
+size_t RankedStore::checkpoints() const {
+	return history.size();
+}
+
+// add the cleared ranks back and add back their counts
+void RankedStore::undo(vector<long long>& counts) {
+	assert(!history.empty());
+
+	auto& checkpoint = history.back();
+	if (checkpoint.removed.size() > 0) {
+		survivors |= checkpoint.removed;
+		live += checkpoint.removed.count();
+
+		size_t numVars = counts.size();
+		for (size_t v = 0; v < numVars; ++v) {
+			counts[v] += checkpoint.removedCounts[v];
+		}
+	}
+	history.pop_back();
+}
+
+// the checkpoint is kept as it would have been by <filter()>
+void RankedStore::adopt(RankSet&& removed, vector<long long>&& removedCounts) {
+	assert(removed.size() == 0 || removed.size() == survivors.size());
+	assert(removed.size() == 0 || !removedCounts.empty());
+	history.push_back(Checkpoint{ move(removed), move(removedCounts) });
+}
+
+// repack everything that has been combined or added to since it was last packed
+unique_ptr<AssignmentStore> RankedStore::compact() {
+	survivors.optimize();
+	for (auto& checkpoint : history) {
+		checkpoint.removed.optimize();
+	}
+	return nullptr;
+}
+
+// a RankedStore
+Storage_e RankedStore::kind() const {
+	return Storage_e::Ranked;
+}
+
+// copy <this> into a new RankedStore
+unique_ptr<AssignmentStore> RankedStore::clone() const {
+	return make_unique<RankedStore>(*this);
+}
+
+// decode and evaluate each surviving rank; each shard, a single chunk of <survivors>, is
+// handled by a task of the WorkerPool with totals of its own, which are merged once all
+// are done; since each shard only adds ranks to its own chunk of <marks>, the shards never
+// touch the same container
+size_t RankedStore::mark(const Expression& clue, RankSet* marks, vector<long long>& removedCounts) const {
+	static_assert(kShardSize == RankSet::kChunkSize, "each shard must be one chunk of a RankSet");
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numVars = removedCounts.size();
+	size_t numShards = survivors.chunkCount();
+	vector<size_t> shardRemoved(numShards, 0);
+	vector<vector<long long>> shardCounts(numShards);					// left empty by a shard that removes nothing
+	ProjectionMemo memo{ clue, live };
+
+	pool.run(numShards, [&](size_t shard) {
+		vector<int> scratch;
+		survivors.visitChunk(shard, [&](size_t rank) {
+			auto assign = decodeRank(rank, categories, itemsPer, scratch);
+			if (!memo.evaluate(assign)) {								// FALSE evaluation, so remove this rank
+				if (marks) {
+					marks->set(rank);
+				}
+				++shardRemoved[shard];
+
+				auto& shardCount = shardCounts[shard];
+				if (shardCount.empty()) {
+					shardCount.assign(numVars, 0);
+				}
+				auto end = assign.trueEnd();
+				for (auto begin = assign.trueBegin(); begin != end; ++begin) {
+					++shardCount[*begin];
+				}
+			}
+		});
+	});
+
+	size_t removed = 0;
+	for (auto shardCount : shardRemoved) {
+		removed += shardCount;
+	}
+	if (removed == 0) {													// nothing to merge
+		return 0;
+	}
+
+	size_t mergeTasks = pool.tasksFor(numVars, kMergeGrain);
+	pool.run(mergeTasks, [&](size_t task) {
+		size_t last = numVars * (task + 1) / mergeTasks;
+		for (size_t v = numVars * task / mergeTasks; v < last; ++v) {
+			for (const auto& shardCount : shardCounts) {
+				if (!shardCount.empty()) {
+					removedCounts[v] += shardCount[v];
+				}
+			}
+		}
+	});
+	return removed;
+}
\ No newline at end of file
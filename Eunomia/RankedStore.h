@@ -0,0 +1,141 @@
+#ifndef EUNOMIA_RANKED_STORE
+#define EUNOMIA_RANKED_STORE
+
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "AssignmentStore.h"									// for AssignmentStore
+#include "RankSet.h"											// for RankSet
+
+class Expression;
+
+/*
+	A RankedStore is a kind of AssignmentStore that never stores an Assignment at all. Each possible solution
+	is identified by its rank, which is its index in the Cartesian product of per-Category permutations; the
+	rank is a mixed-radix number with one Lehmer-coded digit per permutation, so any rank can be decoded back
+	into its permutations, and from there into an Assignment, on demand. The only state kept is a RankSet
+	of the surviving ranks, which makes construction nearly free: every rank starts out surviving, and a
+	RankSet holds a full range in a handful of runs. As clues fix items, the survivors cluster into a few
+	stretches of the range, and each chunk of the RankSet is held as a short array, a bitmap, or a list of
+	runs, whichever suits it, so memory use falls with the survivors rather than staying at one bit per
+	possible solution.
+
+	A clue is evaluated by decoding each surviving rank into a transient Assignment and running the tree-
+	based evaluator of the clue on it through a ProjectionMemo, as a DenseStore does, one task of the
+	WorkerPool per chunk. Each successful filter keeps a RankSet of the ranks it cleared, so undoing it is
+	a chunk-by-chunk union into the survivors. Compacting a RankedStore repacks the survivors and every
+	checkpoint into the smallest containers for each chunk. A RankedStore can also be built from the ranks
+	of the survivors and checkpoints of another kind of AssignmentStore, which is how the others compact
+	themselves.
+*/
+
+class RankedStore : public AssignmentStore {
+	public:
+		// [Constructors]
+		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, each variable that
+		//   forms part of each of <clues> is a variable of a Puzzle with those dimensions
+		// EFFECTS:  constructs <this> holding every possible solution, or only those for which
+		//   every one of <clues> evaluates to TRUE
+		RankedStore(size_t numCategories, size_t itemsPerCategory);
+		RankedStore(size_t numCategories, size_t itemsPerCategory, const std::vector<const Expression*>& clues);
+
+		// [Adopting Constructor]
+		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, <ranks> is over
+		//   the ranks of every possible solution of a Puzzle with those dimensions and holds at
+		//   least one of them
+		// EFFECTS:  constructs <this> holding the possible solutions whose ranks <ranks> holds,
+		//   with no checkpoints
+		RankedStore(size_t numCategories, size_t itemsPerCategory, RankSet&& ranks);
+
+		// [Size Accessor]
+		// EFFECTS:  returns the number of Assignments that remain viable in <this>
+		size_t size() const override;
+
+		// [Count Tallier]
+		// REQUIRES: <counts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <counts>
+		// EFFECTS:  adds to each element of <counts> the number of viable Assignments in <this>
+		//   in which the corresponding variable is TRUE
+		void tally(std::vector<long long>& counts) const override;
+
+		// [Clue Filter]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  removes each viable Assignment for which <clue> evaluates to FALSE, updating
+		//   <counts> so that its elements remain accurate, and returns TRUE; if every viable
+		//   Assignment would be removed, makes no changes whatsoever and returns FALSE
+		bool filter(const Expression& clue, std::vector<long long>& counts) override;
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, <removedCounts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <removedCounts>
+		// EFFECTS:  returns the number of viable Assignments for which <clue> evaluates to FALSE and
+		//   adds to each element of <removedCounts> the number of those in which the corresponding
+		//   variable is TRUE, without changing <this>
+		size_t probe(const Expression& clue, std::vector<long long>& removedCounts) const override;
+
+		// [Checkpoint Accessor]
+		// EFFECTS:  returns the number of successful filters of <this> that have not been undone
+		size_t checkpoints() const override;
+
+		// [Filter Undoer]
+		// REQUIRES: <checkpoints()> is positive, each element of <counts> is the number of viable
+		//   Assignments of <this> in which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  restores each Assignment removed by the most recent successful filter of <this>
+		//   that has not been undone, updating <counts> so that its elements remain accurate
+		void undo(std::vector<long long>& counts) override;
+
+		// [Checkpoint Adopter]
+		// REQUIRES: <removed> is either empty or has the same size as the survivors of <this> and
+		//   holds none of them; <removedCounts> has one element for each variable of the Assignments
+		//   of <this>, each the number of the Assignments of <removed> in which the variable is TRUE,
+		//   or is empty along with <removed>
+		// MODIFIES: <this>
+		// EFFECTS:  records a checkpoint above those of <this>, as if the most recent successful
+		//   filter had removed the ranks of <removed>, so that undoing it puts them back without
+		//   changing the survivors of <this> now; checkpoints are thus adopted oldest first
+		void adopt(RankSet&& removed, std::vector<long long>&& removedCounts);
+
+		// [Memory Releaser]
+		// MODIFIES: <this>
+		// EFFECTS:  repacks the survivors of <this>, and each of its checkpoints, into the smallest
+		//   containers for each chunk, and returns null
+		std::unique_ptr<AssignmentStore> compact() override;
+
+		// [Kind Accessor]
+		// EFFECTS:  returns Storage_e::Ranked
+		Storage_e kind() const override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new RankedStore holding the same viable Assignments as <this>
+		std::unique_ptr<AssignmentStore> clone() const override;
+
+	private:
+		/*
+			A Checkpoint records a successful filter: the ranks that it cleared from the
+			survivors, and the amount by which it lowered the count of each variable.
+		*/
+		struct Checkpoint {
+			RankSet removed;
+			std::vector<long long> removedCounts;
+		};
+
+		RankSet survivors;
+		size_t live;
+		int categories;
+		int itemsPer;
+		std::vector<Checkpoint> history;
+
+		// [Removal Marker]
+		// REQUIRES: the same as <probe()>; <marks> is either null or holds no ranks and has the
+		//   same size as <survivors>
+		// MODIFIES: <marks>, <removedCounts>
+		// EFFECTS:  the same as <probe()>, except that it also adds to <marks> the rank of each
+		//   viable Assignment for which <clue> evaluates to FALSE, if <marks> is not null
+		size_t mark(const Expression& clue, RankSet* marks, std::vector<long long>& removedCounts) const;
+};
+
+#endif
\ No newline at end of file
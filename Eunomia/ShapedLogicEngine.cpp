@@ -0,0 +1,643 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for AssignmentStore, variableIndex(), permutationsCrossSize(), consistentClues(), orderBySelectivity(), encodeRank(), survivorSlices(), enumerateSurvivorSlices()
+#include "BitSet.h"												// for BitSet
+#include "Engine.h"												// for Engine
+#include "Expression.h"											// for Expression
+#include "PermutationTable.h"									// for PermutationTable
+#include "ProjectionMemo.h"										// for ProjectionMemo
+#include "ShapedLogicEngine.h"									// for ShapedLogicEngine
+#include "Utility.h"											// for VarStatus_e, ProbeResult, StatusReport
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for find, min, move, remove_if
+#include <array>												// for array
+#include <bit>													// for countr_zero
+#include <cassert>												// for assert
+#include <cstdint>												// for uint64_t
+#include <memory>												// for unique_ptr, make_unique, shared_ptr
+#include <numeric>												// for iota
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::uint64_t;
+using std::array; using std::vector;
+using std::find; using std::min; using std::move; using std::remove_if;
+using std::countr_zero;
+using std::unique_ptr; using std::make_unique; using std::shared_ptr;
+using std::iota;
+
+// REQUIRES: <Categories> and <Items> are both at least 2
+// EFFECTS:  returns the layout used by <getVariables()> for <Categories> Categories of <Items>
+//   items each as a table: numbering each pair of Categories ~(catA, catB)~ with ~catA~ less than
+//   ~catB~ in lexicographic order, the entry for item ~itemA~ of ~catA~ and item ~itemB~ of ~catB~
+//   is at index ~(pair * Items + itemA) * Items + itemB~
+template <int Categories, int Items>
+constexpr array<int, Categories * (Categories - 1) / 2 * Items * Items> pairLayout();
+
+// the layout of each shape, computed by the compiler
+template <int Categories, int Items>
+constexpr auto kPairLayout = pairLayout<Categories, Items>();
+
+
+// walk the pairs of Categories in the same order as <ShapedLogicEngine::makeRow()>
+template <int Categories, int Items>
+constexpr array<int, Categories * (Categories - 1) / 2 * Items * Items> pairLayout() {
+	array<int, Categories * (Categories - 1) / 2 * Items * Items> layout{};
+
+	int pair = 0;
+	for (int catA = 0; catA < Categories; ++catA) {
+		for (int catB = catA + 1; catB < Categories; ++catB) {
+			for (int itemA = 0; itemA < Items; ++itemA) {
+				for (int itemB = 0; itemB < Items; ++itemB) {
+					layout[(pair * Items + itemA) * Items + itemB] = variableIndex(catA, itemA, catB, itemB, Categories, Items);
+				}
+			}
+			++pair;
+		}
+	}
+	return layout;
+}
+
+// constructor; nothing is generated until the first clue arrives
+template <int Categories, int Items>
+ShapedLogicEngine<Categories, Items>::ShapedLogicEngine()
+	: rows{}, ranks{}, peak{ 0 }, counts{}, statuses{},
+	unknowns{ kVariables }, changes{}, batch{}, history{} {
+
+	statuses.fill(VarStatus_e::Unknown);
+}
+
+// return the status worked out after the last consistent clue
+template <int Categories, int Items>
+VarStatus_e ShapedLogicEngine<Categories, Items>::getStatus(int varIndex) const {
+	assert(varIndex >= 0 && varIndex < kVariables);
+	return statuses[varIndex];
+}
+
+// solved once no variable is unknown
+template <int Categories, int Items>
+bool ShapedLogicEngine<Categories, Items>::solved() const {
+	return (unknowns == 0);
+}
+
+// every possible solution remains until the first clue
+template <int Categories, int Items>
+size_t ShapedLogicEngine<Categories, Items>::countSurvivors() const {
+	if (numRows() == 0) {
+		return permutationsCrossSize(Categories - 1, Items);
+	}
+	return numRows();
+}
+
+// mark the rows for which <clue> is FALSE, then erase them unless that would be every one
+// of them; as in a LogicEngine, a clue that the statuses alone already contradict is
+// rejected without marking anything
+template <int Categories, int Items>
+bool ShapedLogicEngine<Categories, Items>::evaluateClue(const Expression& clue) {
+	if (numRows() == 0) {
+		return evaluateClues(vector<const Expression*>{ &clue }).front();
+	}
+	if (clue.evaluate(vector<VarStatus_e>(statuses.cbegin(), statuses.cend())) == VarStatus_e::False) {
+		return false;
+	}
+
+	size_t total = numRows();
+	BitSet shouldRemove{ total };
+	array<long long, kVariables> removedCounts{};
+
+	ProjectionMemo memo{ clue, total };
+	size_t totalToRemove = mark([&](size_t, const Row_t& row) { return !memo.evaluate(Assignment{ kVariables, row.data() }); },
+		&shouldRemove, removedCounts);
+	if (totalToRemove == total) {									// would remove everything, indicating logical inconsistency
+		return false;
+	}
+	erase(move(shouldRemove), totalToRemove, removedCounts);
+	watchSurvivors();
+	refreshStatuses();
+	return true;
+}
+
+// work out the statuses that each clue would change from the counts that it would leave, as
+// a LogicEngine does, one clue per task of the WorkerPool; a clue that the statuses alone
+// already settle needs no marking, since it either erases nothing or erases everything;
+// before the first clue there are no rows to mark, so the clues are evaluated on copies of
+// <this> instead
+template <int Categories, int Items>
+vector<ProbeResult> ShapedLogicEngine<Categories, Items>::probeClues(const vector<const Expression*>& clues) const {
+	if (numRows() == 0) {
+		return Engine::probeClues(clues);
+	}
+
+	size_t total = numRows();
+	vector<VarStatus_e> known(statuses.cbegin(), statuses.cend());
+	vector<ProbeResult> results(clues.size());
+	WorkerPool::getInstance().run(clues.size(), [&](size_t k) {
+		auto& result = results[k];
+		VarStatus_e settled = clues[k]->evaluate(known);
+		if (settled != VarStatus_e::Unknown) {
+			result.consistent = (settled == VarStatus_e::True);
+			result.survivors = (result.consistent ? total : 0);
+			return;
+		}
+
+		array<long long, kVariables> removedCounts{};
+		ProjectionMemo memo{ *clues[k], total };
+		size_t removed = mark([&](size_t, const Row_t& row) { return !memo.evaluate(Assignment{ kVariables, row.data() }); },
+			nullptr, removedCounts);
+
+		result.consistent = (removed < total);
+		result.survivors = (result.consistent ? total - removed : 0);
+		if (!result.consistent || removed == 0) {
+			return;
+		}
+
+		long long allCount = static_cast<long long>(result.survivors);
+		for (int v = 0; v < kVariables; ++v) {
+			if (statuses[v] != VarStatus_e::Unknown) {
+				continue;
+			}
+
+			long long count = counts[v] - removedCounts[v];
+			if (count == 0) {
+				result.changes.push_back(StatusReport{ v, VarStatus_e::False });
+			}
+			else if (count == allCount) {
+				result.changes.push_back(StatusReport{ v, VarStatus_e::True });
+			}
+		}
+	});
+	return results;
+}
+
+// the same generate-and-filter scheme as a LogicEngine, except that the generation pass
+// already yields the prefix counts needed to find an inconsistent clue; a copy of each
+// clue of the batch that was kept is held on to, since nothing else can undo it; once
+// there are rows, the batch is fused as a DenseStore fuses it: each group of up to
+// <kFusedClues> clues is evaluated against every row at once, recording a mask of the
+// clues that each row fails, and the rows that each consistent clue fails are then
+// erased in turn, with the masks kept in step with the rows
+template <int Categories, int Items>
+vector<bool> ShapedLogicEngine<Categories, Items>::evaluateClues(const vector<const Expression*>& clues) {
+	if (numRows() > 0) {
+		auto& pool = WorkerPool::getInstance();
+		vector<bool> results;
+		results.reserve(clues.size());
+
+		for (size_t first = 0; first < clues.size(); first += AssignmentStore::kFusedClues) {
+			size_t numClues = min(AssignmentStore::kFusedClues, clues.size() - first);
+			size_t total = numRows();
+			size_t numShards = (total + AssignmentStore::kShardSize - 1) / AssignmentStore::kShardSize;
+			vector<uint64_t> failures(total, 0);
+			vector<ProjectionMemo> memos;
+			memos.reserve(numClues);
+			for (size_t k = 0; k < numClues; ++k) {
+				memos.emplace_back(*clues[first + k], total);
+			}
+			pool.run(numShards, [&](size_t shard) {
+				size_t last = min((shard + 1) * AssignmentStore::kShardSize, total);
+				for (size_t i = shard * AssignmentStore::kShardSize; i < last; ++i) {
+					Row_t row = rowAt(i);
+					Assignment view{ kVariables, row.data() };
+					for (size_t k = 0; k < numClues; ++k) {
+						if (!memos[k].evaluate(view)) {
+							failures[i] |= uint64_t{ 1 } << k;
+						}
+					}
+				}
+			});
+
+			uint64_t consistent = consistentClues(failures, numClues);
+			for (size_t k = 0; k < numClues; ++k) {
+				uint64_t bit = uint64_t{ 1 } << k;
+				results.push_back((consistent & bit) != 0);
+				if ((consistent & bit) == 0) {
+					continue;
+				}
+
+				BitSet shouldRemove{ numRows() };
+				array<long long, kVariables> removedCounts{};
+				size_t totalToRemove = mark([&](size_t i, const Row_t&) { return (failures[i] & bit) != 0; }, &shouldRemove, removedCounts);
+				if (totalToRemove > 0) {
+					failures.erase(remove_if(failures.begin(), failures.end(), [bit](uint64_t mask) { return (mask & bit) != 0; }),
+						failures.end());
+				}
+				erase(move(shouldRemove), totalToRemove, removedCounts);
+			}
+		}
+		watchSurvivors();
+		refreshStatuses();
+		return results;
+	}
+
+	vector<bool> results(clues.size(), true);
+	vector<const Expression*> applied{ clues };
+	vector<size_t> origins(clues.size());							// origins[k] = index in <clues> of applied[k]
+	iota(origins.begin(), origins.end(), 0);
+
+	while (!applied.empty()) {
+		generate(orderBySelectivity(Categories, Items, applied));
+		if (numRows() > 0) {
+			peak = numRows();
+			refreshStatuses();
+			for (auto clue : applied) {
+				batch.push_back(shared_ptr<const Expression>{ clue->clone() });
+			}
+			return results;
+		}
+
+		auto prefixes = generate(applied);							// nothing survives either way; only the culprit depends on the order
+		auto culprit = find(prefixes.cbegin(), prefixes.cend(), size_t{ 0 }) - prefixes.cbegin();
+		results[origins[culprit]] = false;
+		applied.erase(applied.begin() + culprit);
+		origins.erase(origins.begin() + culprit);
+	}
+	return results;
+}
+
+// hand over the recorded changes, leaving none behind
+template <int Categories, int Items>
+vector<int> ShapedLogicEngine<Categories, Items>::takeChanges() {
+	vector<int> taken;
+	taken.swap(changes);
+	return taken;
+}
+
+// the clues of the first batch plus the checkpoints
+template <int Categories, int Items>
+size_t ShapedLogicEngine<Categories, Items>::undoableClues() const {
+	return batch.size() + history.size();
+}
+
+// merge the erased rows of each checkpoint back into place, most recent first, exactly as a
+// DenseStore does, decoding them unless the rows are held by rank; only if that is not enough
+// is the first batch cut short, and the rows generated again from whatever is left of it
+template <int Categories, int Items>
+void ShapedLogicEngine<Categories, Items>::undoClues(size_t count) {
+	assert(count <= undoableClues());
+	if (count == 0) {
+		return;
+	}
+
+	const auto& table = PermutationTable::of(Items);
+	size_t filtered = history.size();
+	for (size_t k = 0; k < count && k < filtered; ++k) {
+		const auto& checkpoint = history.back();
+		if (!checkpoint.erased.empty()) {
+			if (ranks.empty()) {
+				merge(rows, checkpoint, [&table](size_t rank) { return decodeRow(table, rank); });
+			}
+			else {
+				merge(ranks, checkpoint, [](size_t rank) { return rank; });
+			}
+
+			for (int v = 0; v < kVariables; ++v) {
+				counts[v] += checkpoint.removedCounts[v];
+			}
+		}
+		history.pop_back();
+	}
+	if (numRows() > 0) {
+		watchSurvivors();
+	}
+
+	if (count > filtered) {
+		batch.resize(batch.size() - (count - filtered));
+		vector<Row_t>{}.swap(rows);
+		vector<size_t>{}.swap(ranks);
+		peak = 0;
+		counts.fill(0);
+		if (!batch.empty()) {
+			vector<const Expression*> clues;
+			for (const auto& clue : batch) {
+				clues.push_back(clue.get());
+			}
+			generate(orderBySelectivity(Categories, Items, clues));
+			peak = numRows();
+		}
+	}
+	recomputeStatuses();
+}
+
+// copy <this> into a new ShapedLogicEngine
+template <int Categories, int Items>
+unique_ptr<Engine> ShapedLogicEngine<Categories, Items>::clone() const {
+	return make_unique<ShapedLogicEngine>(*this);
+}
+
+// for each group, read the item of every other Category out of its block's permutation,
+// then set the variable of every pair of Categories from the layout table
+template <int Categories, int Items>
+typename ShapedLogicEngine<Categories, Items>::Row_t ShapedLogicEngine<Categories, Items>::makeRow(
+	const PermutationTable& table, const array<size_t, Categories - 1>& perms) {
+
+	Row_t row{};
+	array<int, Categories> members{};
+	for (int group = 0; group < Items; ++group) {
+		members[0] = group;
+		for (int cat = 1; cat < Categories; ++cat) {
+			members[cat] = table[perms[cat - 1]][group];
+		}
+
+		int pair = 0;
+		for (int catA = 0; catA < Categories; ++catA) {
+			for (int catB = catA + 1; catB < Categories; ++catB) {
+				int var = kPairLayout<Categories, Items>[(pair * Items + members[catA]) * Items + members[catB]];
+				row[var / 64] |= uint64_t{ 1 } << (var % 64);
+				++pair;
+			}
+		}
+	}
+	return row;
+}
+
+// peel one digit off of <rank> per block, least significant (i.e. last block) first, as
+// <unrankPermutationsCross()> does
+template <int Categories, int Items>
+typename ShapedLogicEngine<Categories, Items>::Row_t ShapedLogicEngine<Categories, Items>::decodeRow(
+	const PermutationTable& table, size_t rank) {
+
+	array<size_t, Categories - 1> perms{};
+	for (int b = Categories - 2; b >= 0; --b) {
+		perms[b] = rank % table.count();
+		rank /= table.count();
+	}
+	return makeRow(table, perms);
+}
+
+// the rank is read out of the row as <encodeRank()> reads it out of an Assignment
+template <int Categories, int Items>
+size_t ShapedLogicEngine<Categories, Items>::encodeRow(const Row_t& row) {
+	return encodeRank(Assignment{ kVariables, row.data() }, Categories, Items);
+}
+
+// the rows are held either as rows or by rank, never both at once
+template <int Categories, int Items>
+size_t ShapedLogicEngine<Categories, Items>::numRows() const {
+	return rows.size() + ranks.size();
+}
+
+// a row held by rank is built afresh
+template <int Categories, int Items>
+typename ShapedLogicEngine<Categories, Items>::Row_t ShapedLogicEngine<Categories, Items>::rowAt(size_t i) const {
+	assert(i < numRows());
+	if (ranks.empty()) {
+		return rows[i];
+	}
+	return decodeRow(PermutationTable::of(Items), ranks[i]);
+}
+
+// peel off the lowest set bit of each word in turn
+template <int Categories, int Items>
+void ShapedLogicEngine<Categories, Items>::countRow(const Row_t& row, array<long long, kVariables>& tally) {
+	for (int w = 0; w < kWords; ++w) {
+		for (uint64_t word = row[w]; word != 0; word &= word - 1) {
+			++tally[w * 64 + countr_zero(word)];
+		}
+	}
+}
+
+// the possible solutions are enumerated slice by slice on the WorkerPool as they are for an
+// AssignmentStore, pruning every branch of the walk that a clue already rules out and stepping
+// through the last block in minimal-change order; each slice copies its survivors into rows
+// and counts of its own, which are joined in order of slice, and so in order of rank, once all
+// of them have finished
+template <int Categories, int Items>
+vector<size_t> ShapedLogicEngine<Categories, Items>::generate(const vector<const Expression*>& clues) {
+	assert(numRows() == 0);
+
+	size_t slices = survivorSlices(Categories, Items);
+	vector<vector<Row_t>> sliceRows(slices);
+	vector<array<long long, kVariables>> sliceCounts(slices, array<long long, kVariables>{});
+	auto prefixes = enumerateSurvivorSlices(Categories, Items, clues,
+		[&sliceRows, &sliceCounts](size_t slice, size_t, const Assignment& assign) {
+			Row_t row;
+			for (int w = 0; w < kWords; ++w) {
+				row[w] = assign.getWord(w);
+			}
+			sliceRows[slice].push_back(row);
+			countRow(row, sliceCounts[slice]);
+		}
+	);
+
+	size_t kept = 0;
+	for (const auto& part : sliceRows) {
+		kept += part.size();
+	}
+	rows.reserve(kept);
+	for (size_t slice = 0; slice < slices; ++slice) {
+		rows.insert(rows.end(), sliceRows[slice].cbegin(), sliceRows[slice].cend());
+		vector<Row_t>{}.swap(sliceRows[slice]);
+		for (int v = 0; v < kVariables; ++v) {
+			counts[v] += sliceCounts[slice][v];
+		}
+	}
+	return prefixes;
+}
+
+// test each remaining row, each shard of rows in a task of the WorkerPool with count deltas
+// of its own, which are added up once all are done
+template <int Categories, int Items>
+template <typename Predicate>
+size_t ShapedLogicEngine<Categories, Items>::mark(Predicate fails, BitSet* marks,
+	array<long long, kVariables>& removedCounts) const {
+
+	auto& pool = WorkerPool::getInstance();
+	size_t total = numRows();
+	size_t numShards = (total + AssignmentStore::kShardSize - 1) / AssignmentStore::kShardSize;
+	vector<size_t> shardRemoved(numShards, 0);
+	vector<array<long long, kVariables>> shardDeltas(numShards);
+
+	pool.run(numShards, [&](size_t shard) {
+		auto& deltas = shardDeltas[shard];
+		deltas.fill(0);
+		size_t last = min((shard + 1) * AssignmentStore::kShardSize, total);
+		for (size_t i = shard * AssignmentStore::kShardSize; i < last; ++i) {
+			Row_t row = rowAt(i);
+			if (fails(i, row)) {
+				if (marks) {
+					marks->set(i);
+				}
+				++shardRemoved[shard];
+				countRow(row, deltas);
+			}
+		}
+	});
+
+	size_t removed = 0;
+	for (size_t shard = 0; shard < numShards; ++shard) {
+		removed += shardRemoved[shard];
+		for (int v = 0; v < kVariables; ++v) {
+			removedCounts[v] += shardDeltas[shard][v];
+		}
+	}
+	return removed;
+}
+
+// the ranks of the erased rows are kept as a checkpoint exactly as those of the Assignments of
+// a DenseStore are; rows held by rank are already ranks
+template <int Categories, int Items>
+void ShapedLogicEngine<Categories, Items>::erase(BitSet&& shouldRemove, size_t totalToRemove,
+	const array<long long, kVariables>& removedCounts) {
+
+	assert(totalToRemove < numRows());
+	Checkpoint checkpoint{ BitSet{}, {}, removedCounts };
+	if (totalToRemove == 0) {
+		history.push_back(move(checkpoint));
+		return;
+	}
+	for (int v = 0; v < kVariables; ++v) {
+		counts[v] -= removedCounts[v];
+	}
+
+	checkpoint.erased.reserve(totalToRemove);
+	if (ranks.empty()) {
+		sweep(rows, shouldRemove, [](const Row_t& row) { return encodeRow(row); }, checkpoint.erased);
+	}
+	else {
+		sweep(ranks, shouldRemove, [](size_t rank) { return rank; }, checkpoint.erased);
+	}
+	checkpoint.erasedAt = move(shouldRemove);
+	history.push_back(move(checkpoint));
+}
+
+// each shard of <held> is swept by a task of the WorkerPool, which slides the elements that it
+// keeps to the front of the shard and ranks those that it removes into a list of its own; the
+// shards are then slid together and their lists appended in order
+template <int Categories, int Items>
+template <typename Held, typename Ranker>
+void ShapedLogicEngine<Categories, Items>::sweep(vector<Held>& held, const BitSet& shouldRemove, Ranker rankOf,
+	vector<size_t>& erased) {
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numHeld = held.size();
+	size_t numShards = (numHeld + AssignmentStore::kShardSize - 1) / AssignmentStore::kShardSize;
+	vector<vector<size_t>> shardErased(numShards);
+	vector<size_t> shardKept(numShards);
+	pool.run(numShards, [&](size_t shard) {
+		auto& mine = shardErased[shard];
+		size_t first = shard * AssignmentStore::kShardSize;
+		size_t last = min(first + AssignmentStore::kShardSize, numHeld);
+		size_t kept = first;
+		for (size_t i = first; i < last; ++i) {
+			if (shouldRemove.test(i)) {
+				mine.push_back(rankOf(held[i]));
+			}
+			else {
+				held[kept++] = held[i];
+			}
+		}
+		shardKept[shard] = kept - first;
+	});
+
+	auto kept = held.begin();
+	for (size_t shard = 0; shard < numShards; ++shard) {
+		auto first = held.begin() + shard * AssignmentStore::kShardSize;
+		kept = (first == kept ? kept + shardKept[shard] : move(first, first + shardKept[shard], kept));
+		erased.insert(erased.end(), shardErased[shard].cbegin(), shardErased[shard].cend());
+		vector<size_t>{}.swap(shardErased[shard]);
+	}
+	held.erase(kept, held.end());
+}
+
+// walk the positions held just before the checkpoint, taking each from the erased ranks or
+// from <held> as the checkpoint says
+template <int Categories, int Items>
+template <typename Held, typename Decoder>
+void ShapedLogicEngine<Categories, Items>::merge(vector<Held>& held, const Checkpoint& checkpoint, Decoder fromRank) {
+	size_t total = held.size() + checkpoint.erased.size();
+	vector<Held> merged;
+	merged.reserve(total);
+	auto kept = held.cbegin();
+	auto erased = checkpoint.erased.cbegin();
+	for (size_t i = 0; i < total; ++i) {
+		merged.push_back(checkpoint.erasedAt.test(i) ? fromRank(*erased++) : *kept++);
+	}
+	held = move(merged);
+}
+
+// compact once the rows have fallen to 1/<kCompactFactor> of their peak, which starts out at
+// the rows first generated, as a LogicEngine does; a rank is a single word, so rows of more than one word are swapped for their ranks
+// (which, in order of position, are in order of rank), and otherwise the spare room is
+// given back
+template <int Categories, int Items>
+void ShapedLogicEngine<Categories, Items>::watchSurvivors() {
+	assert(numRows() > 0);
+
+	size_t live = numRows();
+	if (live > peak) {
+		peak = live;
+		return;
+	}
+	if (live * AssignmentStore::kCompactFactor > peak) {
+		return;
+	}
+
+	if (sizeof(size_t) < sizeof(Row_t) && ranks.empty()) {
+		ranks.reserve(rows.size());
+		for (const auto& row : rows) {
+			ranks.push_back(encodeRow(row));
+		}
+		vector<Row_t>{}.swap(rows);
+	}
+	rows.shrink_to_fit();
+	ranks.shrink_to_fit();
+	peak = live;
+}
+
+// only the unknown variables can change, and each does so when its count reaches either 0
+// or the number of remaining rows
+template <int Categories, int Items>
+void ShapedLogicEngine<Categories, Items>::refreshStatuses() {
+	assert(numRows() > 0);
+
+	long long allCount = static_cast<long long>(numRows());
+	for (int v = 0; v < kVariables; ++v) {
+		if (statuses[v] != VarStatus_e::Unknown) {
+			continue;
+		}
+
+		if (counts[v] == 0) {
+			statuses[v] = VarStatus_e::False;
+		}
+		else if (counts[v] == allCount) {
+			statuses[v] = VarStatus_e::True;
+		}
+		else {
+			continue;
+		}
+		changes.push_back(v);
+		--unknowns;
+	}
+}
+
+// undoing a clue can make a known variable unknown again, so every variable is looked at;
+// without any rows, nothing is known
+template <int Categories, int Items>
+void ShapedLogicEngine<Categories, Items>::recomputeStatuses() {
+	long long allCount = static_cast<long long>(numRows());
+	for (int v = 0; v < kVariables; ++v) {
+		auto status = VarStatus_e::Unknown;
+		if (allCount > 0 && counts[v] == 0) {
+			status = VarStatus_e::False;
+		}
+		else if (allCount > 0 && counts[v] == allCount) {
+			status = VarStatus_e::True;
+		}
+
+		if (status == statuses[v]) {
+			continue;
+		}
+		if (statuses[v] == VarStatus_e::Unknown) {
+			--unknowns;
+		}
+		else if (status == VarStatus_e::Unknown) {
+			++unknowns;
+		}
+		statuses[v] = status;
+		changes.push_back(v);
+	}
+}
+
+// the shapes that <makeEngine()> dispatches to
+template class ShapedLogicEngine<3, 4>;
+template class ShapedLogicEngine<4, 4>;
+template class ShapedLogicEngine<4, 5>;
\ No newline at end of file
@@ -0,0 +1,244 @@
+#ifndef EUNOMIA_SHAPED_LOGIC_ENGINE
+#define EUNOMIA_SHAPED_LOGIC_ENGINE
+
+#include <array>												// for array
+#include <cstdint>												// for uint64_t
+#include <memory>												// for unique_ptr, shared_ptr
+#include <vector>												// for vector
+#include "BitSet.h"												// for BitSet (because it's a template parameter)
+#include "Engine.h"												// for Engine
+#include "PermutationTable.h"									// for PermutationTable
+#include "Utility.h"											// for VarStatus_e, ProbeResult
+
+class Expression;
+
+/*
+	A ShapedLogicEngine is a kind of Engine that works exactly as a Dense LogicEngine does, but only for
+	Puzzles of a single shape fixed at compile time: <Categories> Categories of <Items> items each. Because
+	every size is a constant, each viable Assignment is a fixed-size row of 64-bit words, all of them held
+	back to back with no per-Assignment bookkeeping; the layout of the variables is a table computed by the
+	compiler, from which a row is built straight from its rank; and the loops over the words and variables
+	of an Assignment have constant bounds, so the compiler can unroll them.
+
+	Like a LogicEngine, a ShapedLogicEngine generates no Assignments until the first clue (or batch of
+	clues) arrives, and then generates only those for which that clue is TRUE, walking the possible
+	solutions exactly as an AssignmentStore does, so that a branch of the walk that a clue already rules
+	out is never built and the last block is stepped through in minimal-change order; and like a
+	LogicEngine, it works out the statuses once per clue and keeps a running count of the variables still
+	"unknown." Clues are undone as a Dense LogicEngine undoes them: each successful filter keeps the ranks
+	of the rows that it erased, from which undoing it builds them again, and the first batch keeps a copy
+	of each of its consistent clues to generate the rows again from. Clues are probed as a LogicEngine
+	probes them, by marking the rows that a clue would erase without erasing any of them, and a batch of
+	clues is evaluated against each row in one pass, as a DenseStore does it.
+
+	A ShapedLogicEngine also compacts itself when a LogicEngine would: each time its rows fall to one in
+	<AssignmentStore::kCompactFactor> of the most there have been since they were generated or last
+	compacted, it gives back the room held for the rest, and, if a rank takes less room than a row, it
+	keeps only the rank of each row from then on and builds the row from it whenever it is needed, just
+	as its checkpoints already do. Generating the rows again starts over with the rows themselves.
+
+	ShapedLogicEngines exist only for the most common shapes of Puzzle that can be enumerated, which are
+	3x4, 4x4, and 4x5; <makeEngine()> picks the matching one whenever it is handed one of those shapes.
+*/
+
+template <int Categories, int Items>
+class ShapedLogicEngine : public Engine {
+	public:
+		static constexpr int kVariables = Items * Items * Categories * (Categories - 1) / 2;
+		static constexpr int kWords = (kVariables + 63) / 64;
+
+		// [Constructor]
+		// EFFECTS:  constructs <this> with no clues evaluated
+		ShapedLogicEngine();
+
+		// [Status Accessor]
+		// REQUIRES: <varIndex> is non-negative and less than <kVariables>
+		// EFFECTS:  returns the status of the <varIndex>th variable based on the logic
+		//   peformed thus far
+		VarStatus_e getStatus(int varIndex) const override;
+
+		// [Solved Checker]
+		// EFFECTS:  returns TRUE if the status of every variable is either "guaranteed to
+		//   be true" or "guaranteed to be false," and returns FALSE otherwise
+		bool solved() const override;
+
+		// [Survivor Counter]
+		// EFFECTS:  returns the number of possible solutions that remain
+		size_t countSurvivors() const override;
+
+		// [Clue Evaluator]
+		// REQUIRES: each variable that forms part of <clue> is less than <kVariables>
+		// MODIFIES: <this>
+		// EFFECTS:  eliminates possible Assignments that don't result in a TRUE evaluation
+		//   for <clue> and updates the statuses of variables accordingly; if <clue> was an
+		//   inconsistent clue, returns FALSE and makes no changes whatsoever; returns TRUE
+		//   otherwise
+		bool evaluateClue(const Expression& clue) override;
+
+		// [Batch Clue Evaluator]
+		// REQUIRES: each variable that forms part of each of <clues> is less than <kVariables>
+		// MODIFIES: <this>
+		// EFFECTS:  evaluates each of <clues> in order exactly as <evaluateClue()> would, and returns
+		//   a list with one element per clue that is TRUE if and only if that clue was consistent;
+		//   if no clue has yet been evaluated by <this>, all of <clues> are applied while the
+		//   Assignments are generated, those that look the most selective first, and otherwise they
+		//   are filtered as one batch; the statuses are worked out once, after the last clue, so
+		//   changes are recorded in order of index
+		std::vector<bool> evaluateClues(const std::vector<const Expression*>& clues) override;
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of each of <clues> is less than <kVariables>
+		// EFFECTS:  returns a list with one element per clue describing what <evaluateClue()> would
+		//   do if it were handed that clue next, without changing <this>; the clues are weighed
+		//   independently of each other, in parallel on the WorkerPool, each against the same rows
+		std::vector<ProbeResult> probeClues(const std::vector<const Expression*>& clues) const override;
+
+		// [Change Collector]
+		// MODIFIES: <this>
+		// EFFECTS:  returns the index of each variable whose status has changed since <this> was
+		//   constructed or since the last call to <takeChanges()>, in the order in which they
+		//   changed, and forgets them
+		std::vector<int> takeChanges() override;
+
+		// [Undo Depth Accessor]
+		// EFFECTS:  returns the number of consistent clues evaluated by <this> that have not been undone
+		size_t undoableClues() const override;
+
+		// [Clue Undoer]
+		// REQUIRES: <count> is no greater than <undoableClues()>
+		// MODIFIES: <this>
+		// EFFECTS:  returns <this> to the state it was in before the last <count> consistent clues
+		//   that have not been undone were evaluated, recording each variable whose status changes;
+		//   undoing a clue of the first batch generates the rows again from the rest of that batch
+		void undoClues(size_t count) override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new ShapedLogicEngine that is an independent copy of <this>
+		std::unique_ptr<Engine> clone() const override;
+
+	private:
+		using Row_t = std::array<std::uint64_t, kWords>;
+
+		/*
+			A Checkpoint records a clue filtered after the first batch: which of the rows held
+			just before it were erased, the ranks of the erased rows in their original order,
+			and the amount by which it lowered the count of each variable.
+		*/
+		struct Checkpoint {
+			BitSet erasedAt;
+			std::vector<size_t> erased;
+			std::array<long long, kVariables> removedCounts;
+		};
+
+		std::vector<Row_t> rows;
+		std::vector<size_t> ranks;								// the ranks of the rows instead, once compacted
+		size_t peak;											// the most rows since they were generated or last compacted
+		std::array<long long, kVariables> counts;
+		std::array<VarStatus_e, kVariables> statuses;
+		int unknowns;
+		std::vector<int> changes;
+		std::vector<std::shared_ptr<const Expression>> batch;
+		std::vector<Checkpoint> history;
+
+		// [Row Builder]
+		// REQUIRES: each element of <perms> is less than <table.count()>, <table> is the
+		//   PermutationTable for <Items> items
+		// EFFECTS:  returns the row of the possible solution whose ~b~th block is the
+		//   <perms[b]>th permutation of <table>
+		static Row_t makeRow(const PermutationTable& table, const std::array<size_t, Categories - 1>& perms);
+
+		// [Rank Codecs]
+		// REQUIRES: <rank> is less than the number of possible solutions, <table> is the
+		//   PermutationTable for <Items> items; <row> is the row of a possible solution
+		// EFFECTS:  returns the row of the possible solution with rank <rank>, or returns the
+		//   rank of the possible solution whose row is <row>
+		static Row_t decodeRow(const PermutationTable& table, size_t rank);
+		static size_t encodeRow(const Row_t& row);
+
+		// [Row Accessors]
+		// REQUIRES: <i> is less than <numRows()>
+		// EFFECTS:  returns the number of rows that remain, whether held as rows or by rank, which
+		//   is 0 only if none have been generated, or returns the <i>th of them
+		size_t numRows() const;
+		Row_t rowAt(size_t i) const;
+
+		// [Row Counter]
+		// MODIFIES: <tally>
+		// EFFECTS:  adds 1 to the element of <tally> of each variable that is TRUE in <row>
+		static void countRow(const Row_t& row, std::array<long long, kVariables>& tally);
+
+		// [Generator]
+		// REQUIRES: no Assignments have been generated yet
+		// MODIFIES: <this>
+		// EFFECTS:  generates the possible solutions through <enumerateSurvivorSlices()>, keeping
+		//   in order of rank each one for which every one of <clues> evaluates to TRUE and
+		//   counting its TRUE variables; returns a list with one element per clue, the ~k~th of
+		//   which is the number of possible solutions for which each of the first ~k+1~ of
+		//   <clues> evaluates to TRUE
+		std::vector<size_t> generate(const std::vector<const Expression*>& clues);
+
+		// [Removal Marker]
+		// REQUIRES: <marks> is either null or has one clear bit for each of the <numRows()> rows
+		// MODIFIES: <marks>, <removedCounts>
+		// EFFECTS:  returns the number of positions ~i~ for which <fails(i, rowAt(i))> is TRUE and
+		//   adds to each element of <removedCounts> the number of those rows in which the
+		//   corresponding variable is TRUE, setting the bit of <marks> at each of those positions
+		//   if <marks> is not null
+		template <typename Predicate>
+		size_t mark(Predicate fails, BitSet* marks, std::array<long long, kVariables>& removedCounts) const;
+
+		// [Eraser]
+		// REQUIRES: <shouldRemove> has one bit for each of the <numRows()> rows, of which
+		//   <totalToRemove> are set, fewer than all of them; <removedCounts> is as returned by
+		//   <mark()> for <shouldRemove>
+		// MODIFIES: <this>
+		// EFFECTS:  erases the rows marked in <shouldRemove>, lowering <counts> accordingly, and
+		//   keeps a checkpoint of them
+		void erase(BitSet&& shouldRemove, size_t totalToRemove, const std::array<long long, kVariables>& removedCounts);
+
+		// [Sweeper]
+		// REQUIRES: <shouldRemove> has one bit for each element of <held>
+		// MODIFIES: <held>, <erased>
+		// EFFECTS:  removes each element of <held> marked in <shouldRemove>, keeping the rest in
+		//   order, and appends <rankOf()> of each removed element to <erased>, in order
+		template <typename Held, typename Ranker>
+		static void sweep(std::vector<Held>& held, const BitSet& shouldRemove, Ranker rankOf, std::vector<size_t>& erased);
+
+		// [Merger]
+		// REQUIRES: <checkpoint> is the most recent Checkpoint of <this>, recorded when <held> held
+		//   what it holds now along with the erased rows
+		// MODIFIES: <held>
+		// EFFECTS:  puts <fromRank()> of each rank erased by <checkpoint> back into <held> where
+		//   it stood before it was erased
+		template <typename Held, typename Decoder>
+		static void merge(std::vector<Held>& held, const Checkpoint& checkpoint, Decoder fromRank);
+
+		// [Survivor Watcher]
+		// REQUIRES: <numRows()> is positive, and the rows have just been filtered or undone
+		// MODIFIES: <this>
+		// EFFECTS:  once the rows have fallen to no more than a small fraction of <peak>, gives back
+		//   the room held for those erased, holds each row by rank from then on if a rank takes
+		//   less room than a row, and lowers <peak> to them; otherwise raises <peak> to them if
+		//   they exceed it
+		void watchSurvivors();
+
+		// [Status Refresher]
+		// REQUIRES: <numRows()> is positive, <counts> is accurate for the rows
+		// MODIFIES: <this>
+		// EFFECTS:  updates the status of each variable whose status is still "unknown" from its
+		//   count, appending the index of each one that changes to <changes>
+		void refreshStatuses();
+
+		// [Status Recomputer]
+		// REQUIRES: <counts> is accurate for the rows
+		// MODIFIES: <this>
+		// EFFECTS:  works out the status of every variable afresh from its count, or as "unknown"
+		//   if there are no rows, appending the index of each one that changes to <changes>
+		void recomputeStatuses();
+};
+
+extern template class ShapedLogicEngine<3, 4>;
+extern template class ShapedLogicEngine<4, 4>;
+extern template class ShapedLogicEngine<4, 5>;
+
+#endif
\ No newline at end of file
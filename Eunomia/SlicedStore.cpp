@@ -0,0 +1,267 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for decodeRank(), encodeRank(), variableIndex(), permutationsCrossSize(), enumerateSurvivors(), enumerateSurvivorSlices()
+#include "BitSet.h"												// for BitSet
+#include "Expression.h"											// for Expression
+#include "RankSet.h"											// for RankSet
+#include "RankedStore.h"										// for RankedStore
+#include "SlicedStore.h"										// for SlicedStore
+#include "Utility.h"											// for variablesNeeded(), Storage_e
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for min
+#include <cassert>												// for assert
+#include <memory>												// for unique_ptr, make_unique
+#include <numeric>												// for iota
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::vector;
+using std::min;
+using std::unique_ptr; using std::make_unique;
+using std::move;
+using std::iota;
+
+// the fewest words of each column worth handing to one task of the WorkerPool when filling the
+// columns, the fewest words in all worth handing to one when tallying them, and the fewest
+// possible solutions worth handing to one when reading their ranks out of the columns
+constexpr size_t kFillGrain = 64;
+constexpr size_t kTallyGrain = 4096;
+constexpr size_t kRankGrain = 1024;
+
+
+// constructor; the ~i~th possible solution sets bit ~i~ of each of its TRUE
+// variables' columns
+SlicedStore::SlicedStore(size_t numCategories, size_t itemsPerCategory)
+	: categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+
+	size_t total = permutationsCrossSize(numCategories - 1, itemsPerCategory);
+	size_t numVars = variablesNeeded(numCategories, itemsPerCategory);
+	columns.assign(numVars, BitSet{ total });
+	survivors = BitSet{ total, true };
+	live = total;
+
+	enumerateSurvivors(numCategories, itemsPerCategory, vector<const Expression*>{},
+		[this](size_t rank, const Assignment& assign) {
+			auto end = assign.trueEnd();
+			for (auto begin = assign.trueBegin(); begin != end; ++begin) {
+				columns[*begin].set(rank);
+			}
+		}
+	);
+}
+
+// constructor with an initial batch of clues; the surviving ranks are gathered first, a
+// slice at a time in parallel, so that the columns can be sized to fit them exactly, then
+// the ~i~th survivor sets bit ~i~; each task of the WorkerPool fills a whole number of words
+// of every column, so no two tasks ever write to the same word
+SlicedStore::SlicedStore(size_t numCategories, size_t itemsPerCategory, const vector<const Expression*>& clues)
+	: categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+
+	vector<vector<size_t>> sliceRanks(survivorSlices(numCategories, itemsPerCategory));
+	enumerateSurvivorSlices(numCategories, itemsPerCategory, clues,
+		[&sliceRanks](size_t slice, size_t rank, const Assignment&) {
+			sliceRanks[slice].push_back(rank);
+		}
+	);
+
+	vector<size_t> ranks;
+	for (auto& part : sliceRanks) {
+		ranks.insert(ranks.end(), part.cbegin(), part.cend());
+		vector<size_t>{}.swap(part);
+	}
+
+	size_t numVars = variablesNeeded(numCategories, itemsPerCategory);
+	columns.assign(numVars, BitSet{ ranks.size() });
+	survivors = BitSet{ ranks.size(), true };
+	live = ranks.size();
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numRanks = ranks.size();
+	size_t numWords = survivors.wordCount();
+	size_t tasks = pool.tasksFor(numWords, kFillGrain);
+	pool.run(tasks, [&](size_t task) {
+		vector<int> scratch;
+		size_t last = min(numWords * (task + 1) / tasks * BitSet::kWordBits, numRanks);
+		for (size_t i = numWords * task / tasks * BitSet::kWordBits; i < last; ++i) {
+			auto assign = decodeRank(ranks[i], numCategories, itemsPerCategory, scratch);
+			auto end = assign.trueEnd();
+			for (auto begin = assign.trueBegin(); begin != end; ++begin) {
+				columns[*begin].set(i);
+			}
+		}
+	});
+}
+
+// return the number of surviving Assignments
+size_t SlicedStore::size() const {
+	return live;
+}
+
+// a variable is TRUE in as many viable Assignments as there are bits set in
+// both its column and <survivors>; the columns are split among the tasks of the
+// WorkerPool, and no two tasks ever count the same variable
+void SlicedStore::tally(vector<long long>& counts) const {
+	auto& pool = WorkerPool::getInstance();
+	size_t numVars = columns.size();
+	size_t tasks = pool.tasksFor(numVars * survivors.wordCount(), kTallyGrain);
+	pool.run(tasks, [&](size_t task) {
+		size_t last = numVars * (task + 1) / tasks;
+		for (size_t v = numVars * task / tasks; v < last; ++v) {
+			counts[v] += static_cast<long long>(BitSet::countAnd(columns[v], survivors));
+		}
+	});
+}
+
+// evaluate <clue> column-wise and AND the result into a copy of <survivors>;
+// if nothing would survive, do nothing and return FALSE; otherwise adopt the
+// new survivors and recount each variable from its column, the columns split
+// among the tasks of the WorkerPool as in <tally()>; the evaluation itself is
+// already a word at a time, so it is not sharded; the cleared survivors and the
+// drop in each count are kept as a checkpoint
+bool SlicedStore::filter(const Expression& clue, vector<long long>& counts) {
+	BitSet kept = clue.evaluate(columns);
+	kept &= survivors;
+
+	size_t keptCount = kept.count();
+	if (keptCount == 0) {												// would remove everything, indicating logical inconsistency
+		return false;
+	}
+	if (keptCount == live) {											// nothing removed, so nothing to recount
+		history.push_back(Checkpoint{ BitSet{}, {} });
+		return true;
+	}
+
+	BitSet cleared{ survivors };
+	cleared.andNot(kept);
+	survivors = move(kept);
+	live = keptCount;
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numVars = columns.size();
+	vector<long long> removedCounts(numVars);
+	size_t tasks = pool.tasksFor(numVars * survivors.wordCount(), kTallyGrain);
+	pool.run(tasks, [&](size_t task) {
+		size_t last = numVars * (task + 1) / tasks;
+		for (size_t v = numVars * task / tasks; v < last; ++v) {
+			auto count = static_cast<long long>(BitSet::countAnd(columns[v], survivors));
+			removedCounts[v] = counts[v] - count;
+			counts[v] = count;
+		}
+	});
+	history.push_back(Checkpoint{ move(cleared), move(removedCounts) });
+	return true;
+}
+
+// evaluate <clue> column-wise as <filter()> does, but keep only the survivors that it would
+// clear, and count each variable from its column among those; the columns are split among
+// the tasks of the WorkerPool as in <tally()>
+size_t SlicedStore::probe(const Expression& clue, vector<long long>& removedCounts) const {
+	BitSet cleared{ survivors };
+	cleared.andNot(clue.evaluate(columns));
+
+	size_t removed = cleared.count();
+	if (removed == 0) {
+		return 0;
+	}
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numVars = columns.size();
+	size_t tasks = pool.tasksFor(numVars * cleared.wordCount(), kTallyGrain);
+	pool.run(tasks, [&](size_t task) {
+		size_t last = numVars * (task + 1) / tasks;
+		for (size_t v = numVars * task / tasks; v < last; ++v) {
+			removedCounts[v] += static_cast<long long>(BitSet::countAnd(columns[v], cleared));
+		}
+	});
+	return removed;
+}
+
+// return the number of checkpoints
+size_t SlicedStore::checkpoints() const {
+	return history.size();
+}
+
+// set the cleared survivors again and add back their counts
+void SlicedStore::undo(vector<long long>& counts) {
+	assert(!history.empty());
+
+	auto& checkpoint = history.back();
+	if (checkpoint.removed.size() > 0) {
+		survivors |= checkpoint.removed;
+		live += checkpoint.removed.count();
+
+		size_t numVars = counts.size();
+		for (size_t v = 0; v < numVars; ++v) {
+			counts[v] += checkpoint.removedCounts[v];
+		}
+	}
+	history.pop_back();
+}
+
+// the ~i~th bit of every column and BitSet is the ~i~th possible solution numbered, and those
+// are numbered in order of rank, which is the cheapest order in which to add them to a RankSet;
+// every possible solution is numbered only if none was rejected at construction, in which case
+// each is numbered by its rank, and otherwise the rank of each is read out of the columns, the
+// positions split among the tasks of the WorkerPool; the checkpoints are adopted oldest first,
+// each keeping its counts as they are
+unique_ptr<AssignmentStore> SlicedStore::compact() {
+	size_t total = permutationsCrossSize(categories - 1, itemsPer);
+	size_t numPositions = survivors.size();
+	vector<size_t> ranks(numPositions);
+	if (numPositions == total) {
+		iota(ranks.begin(), ranks.end(), 0);
+	}
+	else {
+		auto& pool = WorkerPool::getInstance();
+		size_t tasks = pool.tasksFor(numPositions, kRankGrain);
+		pool.run(tasks, [&](size_t task) {
+			Assignment assign{ columns.size() };
+			size_t last = numPositions * (task + 1) / tasks;
+			for (size_t i = numPositions * task / tasks; i < last; ++i) {
+				for (int cat = 1; cat < categories; ++cat) {
+					for (int group = 0; group < itemsPer; ++group) {
+						for (int item = 0; item < itemsPer; ++item) {
+							int var = variableIndex(0, group, cat, item, categories, itemsPer);
+							if (columns[var].test(i)) {
+								assign.setTrue(var);
+							}
+							else {
+								assign.setFalse(var);
+							}
+						}
+					}
+				}
+				ranks[i] = encodeRank(assign, categories, itemsPer);
+			}
+		});
+	}
+
+	auto rankAll = [&ranks, total](const BitSet& positions) {
+		RankSet ranked{ total };
+		for (size_t i = positions.findNext(0); i < positions.size(); i = positions.findNext(i + 1)) {
+			ranked.set(ranks[i]);
+		}
+		return ranked;
+	};
+	auto ranked = make_unique<RankedStore>(categories, itemsPer, rankAll(survivors));
+	for (auto& checkpoint : history) {
+		ranked->adopt(checkpoint.removed.size() > 0 ? rankAll(checkpoint.removed) : RankSet{}, move(checkpoint.removedCounts));
+	}
+	ranked->compact();
+	return ranked;
+}
+
+// a SlicedStore
+Storage_e SlicedStore::kind() const {
+	return Storage_e::Sliced;
+}
+
+// copy <this> into a new SlicedStore
+unique_ptr<AssignmentStore> SlicedStore::clone() const {
+	return make_unique<SlicedStore>(*this);
+}
\ No newline at end of file
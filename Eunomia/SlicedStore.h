@@ -0,0 +1,112 @@
+#ifndef EUNOMIA_SLICED_STORE
+#define EUNOMIA_SLICED_STORE
+
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "AssignmentStore.h"									// for AssignmentStore
+#include "BitSet.h"												// for BitSet (because it's a template parameter)
+
+class Expression;
+
+/*
+	A SlicedStore is a kind of AssignmentStore that lays its Assignments out column-major: rather than one
+	object per Assignment, it keeps one BitSet per variable, whose ~i~th bit is the assigned value of that
+	variable in the ~i~th possible solution. A separate survivor BitSet marks which of the possible
+	solutions remain viable; eliminated Assignments are simply cleared from it. A SlicedStore constructed
+	with an initial batch of clues numbers only the possible solutions that satisfy those clues, so its
+	columns are only as long as the number of such survivors.
+
+	A clue is evaluated by the column evaluator of the clue, which combines whole columns with word-wide
+	Boolean operators and thus evaluates 64 Assignments per operation. The number of viable Assignments
+	in which a variable is TRUE is the population count of that variable's column ANDed with the survivors.
+	Each successful filter keeps a BitSet of the survivors it cleared, so undoing it is a single word-wide
+	OR into the survivors. The columns stay as long as they ever were, so compacting a SlicedStore hands
+	back a RankedStore holding the ranks of its survivors and of its checkpoints instead, each rank read
+	out of the columns that pair Category 0 with the others.
+*/
+
+class SlicedStore : public AssignmentStore {
+	public:
+		// [Constructors]
+		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, each variable that
+		//   forms part of each of <clues> is a variable of a Puzzle with those dimensions
+		// EFFECTS:  constructs <this> holding every possible solution, or only those for which
+		//   every one of <clues> evaluates to TRUE
+		SlicedStore(size_t numCategories, size_t itemsPerCategory);
+		SlicedStore(size_t numCategories, size_t itemsPerCategory, const std::vector<const Expression*>& clues);
+
+		// [Size Accessor]
+		// EFFECTS:  returns the number of Assignments that remain viable in <this>
+		size_t size() const override;
+
+		// [Count Tallier]
+		// REQUIRES: <counts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <counts>
+		// EFFECTS:  adds to each element of <counts> the number of viable Assignments in <this>
+		//   in which the corresponding variable is TRUE
+		void tally(std::vector<long long>& counts) const override;
+
+		// [Clue Filter]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  removes each viable Assignment for which <clue> evaluates to FALSE, updating
+		//   <counts> so that its elements remain accurate, and returns TRUE; if every viable
+		//   Assignment would be removed, makes no changes whatsoever and returns FALSE
+		bool filter(const Expression& clue, std::vector<long long>& counts) override;
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, <removedCounts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <removedCounts>
+		// EFFECTS:  returns the number of viable Assignments for which <clue> evaluates to FALSE and
+		//   adds to each element of <removedCounts> the number of those in which the corresponding
+		//   variable is TRUE, without changing <this>
+		size_t probe(const Expression& clue, std::vector<long long>& removedCounts) const override;
+
+		// [Checkpoint Accessor]
+		// EFFECTS:  returns the number of successful filters of <this> that have not been undone
+		size_t checkpoints() const override;
+
+		// [Filter Undoer]
+		// REQUIRES: <checkpoints()> is positive, each element of <counts> is the number of viable
+		//   Assignments of <this> in which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  restores each Assignment removed by the most recent successful filter of <this>
+		//   that has not been undone, updating <counts> so that its elements remain accurate
+		void undo(std::vector<long long>& counts) override;
+
+		// [Memory Releaser]
+		// MODIFIES: <this>
+		// EFFECTS:  returns a new RankedStore holding the same viable Assignments and checkpoints
+		//   as <this>, each by rank, which is to take the place of <this>
+		std::unique_ptr<AssignmentStore> compact() override;
+
+		// [Kind Accessor]
+		// EFFECTS:  returns Storage_e::Sliced
+		Storage_e kind() const override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new SlicedStore holding the same viable Assignments as <this>
+		std::unique_ptr<AssignmentStore> clone() const override;
+
+	private:
+		/*
+			A Checkpoint records a successful filter: the survivors that it cleared, and the
+			amount by which it lowered the count of each variable.
+		*/
+		struct Checkpoint {
+			BitSet removed;
+			std::vector<long long> removedCounts;
+		};
+
+		std::vector<BitSet> columns;
+		BitSet survivors;
+		size_t live;
+		int categories;
+		int itemsPer;
+		std::vector<Checkpoint> history;
+};
+
+#endif
\ No newline at end of file
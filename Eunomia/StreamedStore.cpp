@@ -0,0 +1,380 @@
+#include "Assignment.h"											// for Assignment
+#include "AssignmentStore.h"									// for permutationsCrossSize(), decodeRank(), enumerateSurvivors()
+#include "Expression.h"											// for Expression
+#include "ProjectionMemo.h"										// for ProjectionMemo
+#include "StreamedStore.h"										// for StreamedStore
+#include "Utility.h"											// for Storage_e
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for min, max
+#include <atomic>												// for atomic
+#include <cassert>												// for assert
+#include <filesystem>											// for path, temp_directory_path, create_directories, remove, remove_all, copy_file, exists
+#include <fstream>												// for ifstream, ofstream
+#include <functional>											// for cref
+#include <future>												// for future, async, launch
+#include <memory>												// for unique_ptr, make_unique
+#include <random>												// for random_device
+#include <stdexcept>											// for runtime_error
+#include <string>												// for string, to_string
+#include <system_error>											// for error_code
+#include <utility>												// for move
+#include <vector>												// for vector
+
+using std::vector;
+using std::min; using std::max;
+using std::atomic;
+using std::ifstream; using std::ofstream;
+using std::cref;
+using std::future; using std::async; using std::launch;
+using std::unique_ptr; using std::make_unique;
+using std::random_device;
+using std::runtime_error;
+using std::string; using std::to_string;
+using std::error_code;
+using std::move;
+namespace fs = std::filesystem;
+
+// REQUIRES: <rank> fits in <width> bytes, <width> is positive
+// MODIFIES: <bytes>
+// EFFECTS:  appends the <width>-byte little-endian encoding of <rank> to <bytes>
+void encodeRank(size_t rank, size_t width, vector<unsigned char>& bytes);
+
+// REQUIRES: <bytes> points at <width> readable bytes
+// EFFECTS:  returns the rank whose <width>-byte little-endian encoding begins at <bytes>
+size_t readRank(const unsigned char* bytes, size_t width);
+
+// MODIFIES: disk
+// EFFECTS:  creates and returns a new, empty directory under the system's temporary directory
+//   whose name is not used by any other StreamedStore
+fs::path makeSpillDirectory();
+
+
+// write the low byte first
+void encodeRank(size_t rank, size_t width, vector<unsigned char>& bytes) {
+	for (size_t b = 0; b < width; ++b) {
+		bytes.push_back(static_cast<unsigned char>(rank >> (8 * b)));
+	}
+}
+
+// read the high byte first, shifting each lower byte in below it
+size_t readRank(const unsigned char* bytes, size_t width) {
+	size_t rank = 0;
+	for (size_t b = width; b > 0; --b) {
+		rank = (rank << 8) | bytes[b - 1];
+	}
+	return rank;
+}
+
+// name the directory after a per-process random token and a per-process counter
+fs::path makeSpillDirectory() {
+	static const auto token = random_device{}();
+	static atomic<unsigned> counter{ 0 };
+
+	auto dir = fs::temp_directory_path() / ("eunomia-" + to_string(token) + "-" + to_string(counter++));
+	fs::create_directories(dir);
+	return dir;
+}
+
+// constructor; the whole rank space is split into implicit segments, each of which holds
+// as many ranks as fit in a third of <memoryCap>
+StreamedStore::StreamedStore(size_t numCategories, size_t itemsPerCategory, size_t memoryCap)
+	: categories{ static_cast<int>(numCategories) }, itemsPer{ static_cast<int>(itemsPerCategory) },
+	width{ 1 }, segmentRanks{ 1 }, directory{ makeSpillDirectory() }, live{ 0 }, nextFile{ 0 } {
+
+	assert(numCategories >= 2);
+	assert(itemsPerCategory >= 2);
+	assert(memoryCap > 0);
+
+	size_t total = permutationsCrossSize(categories - 1, itemsPer);
+	while (width < sizeof(size_t) && ((total - 1) >> (8 * width)) != 0) {
+		++width;
+	}
+	segmentRanks = max(size_t{ 1 }, memoryCap / (3 * width));
+
+	for (size_t first = 0; first < total; first += segmentRanks) {
+		segments.push_back(Segment{ fs::path{}, min(segmentRanks, total - first), first });
+	}
+	live = total;
+}
+
+// constructor with an initial batch of clues; the segments are laid out as for the whole rank
+// space and then discarded, and the survivors are encoded as they are enumerated, flushing a
+// segment to disk each time one fills up
+StreamedStore::StreamedStore(size_t numCategories, size_t itemsPerCategory, size_t memoryCap,
+	const vector<const Expression*>& clues)
+	: StreamedStore{ numCategories, itemsPerCategory, memoryCap } {
+
+	segments.clear();
+	live = 0;
+
+	vector<unsigned char> pending;
+	size_t pendingCount = 0;
+	enumerateSurvivors(categories, itemsPer, clues,
+		[&](size_t rank, const Assignment&) {
+			encodeRank(rank, width, pending);
+			if (++pendingCount == segmentRanks) {
+				segments.push_back(Segment{ store(pending), pendingCount, 0 });
+				pending.clear();
+				pendingCount = 0;
+			}
+			++live;
+		}
+	);
+	if (pendingCount > 0) {
+		segments.push_back(Segment{ store(pending), pendingCount, 0 });
+	}
+}
+
+// copy constructor; every file, whether viable now or only in a checkpoint, is copied into
+// a fresh directory under the same name, once however many segments and checkpoints name it
+StreamedStore::StreamedStore(const StreamedStore& other)
+	: categories{ other.categories }, itemsPer{ other.itemsPer }, width{ other.width },
+	segmentRanks{ other.segmentRanks }, directory{ makeSpillDirectory() }, segments{ other.segments },
+	live{ other.live }, nextFile{ other.nextFile }, history{ other.history } {
+
+	auto relocate = [this](fs::path& file) {
+		if (!file.empty()) {
+			auto copied = directory / file.filename();
+			if (!fs::exists(copied)) {
+				fs::copy_file(file, copied);
+			}
+			file = copied;
+		}
+	};
+
+	for (auto& segment : segments) {
+		relocate(segment.file);
+	}
+	for (auto& checkpoint : history) {
+		for (auto& segment : checkpoint.segments) {
+			relocate(segment.file);
+		}
+		for (auto& file : checkpoint.written) {
+			relocate(file);
+		}
+	}
+}
+
+// remove the whole directory, ignoring any failure to do so
+StreamedStore::~StreamedStore() {
+	error_code ignored;
+	fs::remove_all(directory, ignored);
+}
+
+// return the number of surviving ranks
+size_t StreamedStore::size() const {
+	return live;
+}
+
+// decode each surviving rank and count its TRUE variables
+void StreamedStore::tally(vector<long long>& counts) const {
+	vector<int> scratch;
+	scan([&](size_t idx, const vector<unsigned char>& bytes) {
+		const auto& segment = segments[idx];
+		for (size_t i = 0; i < segment.count; ++i) {
+			auto assign = decodeRank(rankAt(segment, bytes, i), categories, itemsPer, scratch);
+			auto end = assign.trueEnd();
+			for (auto begin = assign.trueBegin(); begin != end; ++begin) {
+				++counts[*begin];
+			}
+		}
+	});
+}
+
+// sift each segment, keeping its survivors in a fresh buffer and totalling the TRUE variables
+// of the others separately; segments that changed are written anew, but nothing is committed
+// (and the new files are deleted) unless something survives; the segments that are replaced
+// stay on disk, named by the checkpoint that is kept
+bool StreamedStore::filter(const Expression& clue, vector<long long>& counts) {
+	size_t numVars = counts.size();
+	vector<long long> removedCounts(numVars, 0);
+	size_t removed = 0;
+
+	vector<Segment> survivors;
+	vector<fs::path> written;
+	vector<unsigned char> kept;
+	ProjectionMemo memo{ clue, live };
+	scan([&](size_t idx, const vector<unsigned char>& bytes) {
+		const auto& segment = segments[idx];
+		kept.clear();
+		size_t keptCount = segment.count - sift(memo, segment, bytes, &kept, removedCounts);
+		removed += segment.count - keptCount;
+
+		if (keptCount == segment.count) {						// untouched, so no need to rewrite
+			survivors.push_back(segment);
+			return;
+		}
+		if (keptCount > 0) {
+			written.push_back(store(kept));
+			survivors.push_back(Segment{ written.back(), keptCount, 0 });
+		}
+	});
+
+	if (removed == live) {										// would remove everything, indicating logical inconsistency
+		for (const auto& file : written) {
+			fs::remove(file);
+		}
+		return false;
+	}
+
+	for (size_t v = 0; v < numVars; ++v) {
+		counts[v] -= removedCounts[v];
+	}
+	history.push_back(Checkpoint{ move(segments), move(written), removed, move(removedCounts) });
+	segments = move(survivors);
+	live -= removed;
+	return true;
+}
+
+// sift each segment without keeping anything
+size_t StreamedStore::probe(const Expression& clue, vector<long long>& removedCounts) const {
+	size_t removed = 0;
+	ProjectionMemo memo{ clue, live };
+	scan([&](size_t idx, const vector<unsigned char>& bytes) {
+		removed += sift(memo, segments[idx], bytes, nullptr, removedCounts);
+	});
+	return removed;
+}
+
+// return the number of checkpoints
+size_t StreamedStore::checkpoints() const {
+	return history.size();
+}
+
+// return to the segments that the last filter replaced, removing the files it wrote
+void StreamedStore::undo(vector<long long>& counts) {
+	assert(!history.empty());
+
+	auto& checkpoint = history.back();
+	for (const auto& file : checkpoint.written) {
+		if (!fs::remove(file)) {
+			throw runtime_error{ "Could not remove segment '" + file.string() + "'" };
+		}
+	}
+
+	size_t numVars = counts.size();
+	for (size_t v = 0; v < numVars; ++v) {
+		counts[v] += checkpoint.removedCounts[v];
+	}
+	segments = move(checkpoint.segments);
+	live += checkpoint.removed;
+	history.pop_back();
+}
+
+// a StreamedStore
+Storage_e StreamedStore::kind() const {
+	return Storage_e::Streamed;
+}
+
+// copy <this> into a new StreamedStore
+unique_ptr<AssignmentStore> StreamedStore::clone() const {
+	return make_unique<StreamedStore>(*this);
+}
+
+// read the whole file in one go
+vector<unsigned char> StreamedStore::load(const Segment& segment) const {
+	vector<unsigned char> bytes;
+	if (segment.file.empty()) {
+		return bytes;
+	}
+
+	bytes.resize(segment.count * width);
+	ifstream is{ segment.file, std::ios::binary };
+	if (!is.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+		throw runtime_error{ "Could not read segment '" + segment.file.string() + "'" };
+	}
+	return bytes;
+}
+
+// name each file after a running count, so that no two files of <this> ever collide
+fs::path StreamedStore::store(const vector<unsigned char>& bytes) {
+	auto file = directory / ("segment-" + to_string(nextFile++) + ".bin");
+	ofstream os{ file, std::ios::binary };
+	if (!os.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())) {
+		throw runtime_error{ "Could not write segment '" + file.string() + "'" };
+	}
+	return file;
+}
+
+// an implicit segment counts up from its first rank; otherwise decode the <index>th entry
+size_t StreamedStore::rankAt(const Segment& segment, const vector<unsigned char>& bytes, size_t index) const {
+	assert(index < segment.count);
+
+	if (segment.file.empty()) {
+		return segment.first + index;
+	}
+	return readRank(bytes.data() + index * width, width);
+}
+
+// split the segment into shards for the WorkerPool, each shard encoding its own survivors and
+// totalling its own removals, and join the shards in order, so that no more is ever held than
+// the survivors of the segment
+size_t StreamedStore::sift(const ProjectionMemo& memo, const Segment& segment, const vector<unsigned char>& bytes,
+	vector<unsigned char>* kept, vector<long long>& removedCounts) const {
+
+	auto& pool = WorkerPool::getInstance();
+	size_t numVars = removedCounts.size();
+	size_t numShards = (segment.count + kShardSize - 1) / kShardSize;
+	vector<vector<unsigned char>> shardKept(numShards);
+	vector<size_t> shardRemoved(numShards, 0);
+	vector<vector<long long>> shardCounts(numShards);				// left empty by a shard that removes nothing
+
+	pool.run(numShards, [&](size_t shard) {
+		vector<int> scratch;
+		size_t last = min((shard + 1) * kShardSize, segment.count);
+		for (size_t i = shard * kShardSize; i < last; ++i) {
+			size_t rank = rankAt(segment, bytes, i);
+			auto assign = decodeRank(rank, categories, itemsPer, scratch);
+			if (memo.evaluate(assign)) {
+				if (kept) {
+					encodeRank(rank, width, shardKept[shard]);
+				}
+			}
+			else {												// FALSE evaluation, so remove this rank
+				++shardRemoved[shard];
+				auto& shardCount = shardCounts[shard];
+				if (shardCount.empty()) {
+					shardCount.assign(numVars, 0);
+				}
+				auto end = assign.trueEnd();
+				for (auto begin = assign.trueBegin(); begin != end; ++begin) {
+					++shardCount[*begin];
+				}
+			}
+		}
+	});
+
+	size_t removed = 0;
+	for (size_t shard = 0; shard < numShards; ++shard) {
+		removed += shardRemoved[shard];
+		if (!shardCounts[shard].empty()) {
+			for (size_t v = 0; v < numVars; ++v) {
+				removedCounts[v] += shardCounts[shard][v];
+			}
+		}
+		if (kept) {
+			kept->insert(kept->end(), shardKept[shard].cbegin(), shardKept[shard].cend());
+			vector<unsigned char>{}.swap(shardKept[shard]);
+		}
+	}
+	return removed;
+}
+
+// start reading the first segment, then on each step collect the segment that was read
+// ahead, start reading the one after it, and visit the collected one in the meantime
+template <typename Visitor>
+void StreamedStore::scan(Visitor visit) const {
+	size_t numSegments = segments.size();
+	if (numSegments == 0) {
+		return;
+	}
+
+	future<vector<unsigned char>> ahead = async(launch::async, &StreamedStore::load, this, cref(segments[0]));
+	for (size_t idx = 0; idx < numSegments; ++idx) {
+		auto bytes = ahead.get();
+		if (idx + 1 < numSegments) {
+			ahead = async(launch::async, &StreamedStore::load, this, cref(segments[idx + 1]));
+		}
+		visit(idx, bytes);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#ifndef EUNOMIA_STREAMED_STORE
+#define EUNOMIA_STREAMED_STORE
+
+#include <filesystem>											// for path
+#include <memory>												// for unique_ptr
+#include <vector>												// for vector
+#include "AssignmentStore.h"									// for AssignmentStore
+
+class Expression;
+class ProjectionMemo;
+
+/*
+	A StreamedStore is a kind of AssignmentStore that keeps its viable Assignments on disk rather than in
+	memory, so that it can handle Puzzles whose possible solutions do not fit in RAM. As in a RankedStore,
+	each possible solution is identified by its rank, from which its Assignment can be decoded on demand;
+	the ranks of the viable Assignments are written in a fixed-width little-endian encoding, using only as
+	many bytes per rank as the largest rank needs, and split into segment files in a private directory
+	that is removed along with the StreamedStore.
+
+	Every operation is a single sequential pass over the segments. While one segment is processed, the next
+	is read ahead on a separate thread. A clue is evaluated by decoding and evaluating every rank of each
+	segment; a segment from which nothing is removed is left as it is, a segment from which everything is
+	removed is dropped, and any other segment is rewritten with only its survivors. Until the first clue,
+	the segments are implicit ranges of consecutive ranks and occupy no disk space at all; a StreamedStore
+	constructed with an initial batch of clues instead writes out only the ranks that survive them. A
+	segment that a filter replaces is not removed from disk until the StreamedStore is, so that the filter
+	can be undone by returning to the segments it replaced and removing the ones it wrote.
+
+	The memory cap bounds the encoded ranks held in memory at once, which is at most three segments: the
+	one being processed, the one being read ahead, and the survivors of the one being processed.
+*/
+
+class StreamedStore : public AssignmentStore {
+	public:
+		// [Constructors]
+		// REQUIRES: <numCategories> and <itemsPerCategory> are both at least 2, <memoryCap> is positive,
+		//   each variable that forms part of each of <clues> is a variable of a Puzzle with those
+		//   dimensions
+		// EFFECTS:  constructs <this> holding every possible solution, or only those for which every
+		//   one of <clues> evaluates to TRUE; throws a runtime_error if a segment cannot be written
+		StreamedStore(size_t numCategories, size_t itemsPerCategory, size_t memoryCap);
+		StreamedStore(size_t numCategories, size_t itemsPerCategory, size_t memoryCap,
+			const std::vector<const Expression*>& clues);
+
+		// [Copy Constructor]
+		// EFFECTS:  makes <this> an independent copy of <other>, with its own copy of each segment
+		StreamedStore(const StreamedStore& other);
+		StreamedStore& operator=(const StreamedStore& other) = delete;
+
+		// [Destructor]
+		// EFFECTS:  removes every segment of <this> from disk
+		~StreamedStore() override;
+
+		// [Size Accessor]
+		// EFFECTS:  returns the number of Assignments that remain viable in <this>
+		size_t size() const override;
+
+		// [Count Tallier]
+		// REQUIRES: <counts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <counts>
+		// EFFECTS:  adds to each element of <counts> the number of viable Assignments in <this>
+		//   in which the corresponding variable is TRUE
+		void tally(std::vector<long long>& counts) const override;
+
+		// [Clue Filter]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, each element of <counts> is the number of viable Assignments of <this> in
+		//   which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  removes each viable Assignment for which <clue> evaluates to FALSE, updating
+		//   <counts> so that its elements remain accurate, and returns TRUE; if every viable
+		//   Assignment would be removed, makes no changes whatsoever and returns FALSE; throws
+		//   a runtime_error if a segment cannot be read or written
+		bool filter(const Expression& clue, std::vector<long long>& counts) override;
+
+		// [Clue Prober]
+		// REQUIRES: each variable that forms part of <clue> is a variable of the Assignments of
+		//   <this>, <removedCounts> has one element for each variable of the Assignments of <this>
+		// MODIFIES: <removedCounts>
+		// EFFECTS:  returns the number of viable Assignments for which <clue> evaluates to FALSE and
+		//   adds to each element of <removedCounts> the number of those in which the corresponding
+		//   variable is TRUE, without changing <this>; throws a runtime_error
+		//   if a segment cannot be read
+		size_t probe(const Expression& clue, std::vector<long long>& removedCounts) const override;
+
+		// [Checkpoint Accessor]
+		// EFFECTS:  returns the number of successful filters of <this> that have not been undone
+		size_t checkpoints() const override;
+
+		// [Filter Undoer]
+		// REQUIRES: <checkpoints()> is positive, each element of <counts> is the number of viable
+		//   Assignments of <this> in which the corresponding variable is TRUE
+		// MODIFIES: <this>, <counts>
+		// EFFECTS:  restores each Assignment removed by the most recent successful filter of <this>
+		//   that has not been undone, updating <counts> so that its elements remain accurate;
+		//   throws a runtime_error if a segment written by that filter cannot be removed
+		void undo(std::vector<long long>& counts) override;
+
+		// [Kind Accessor]
+		// EFFECTS:  returns Storage_e::Streamed
+		Storage_e kind() const override;
+
+		// [Cloner]
+		// EFFECTS:  returns a new StreamedStore holding the same viable Assignments as <this>
+		std::unique_ptr<AssignmentStore> clone() const override;
+
+	private:
+		/*
+			A Segment is a run of ranks of viable Assignments, either held in a file or, if
+			it has no file, implicitly consisting of the <count> consecutive ranks starting
+			with <first>.
+		*/
+		struct Segment {
+			std::filesystem::path file;
+			size_t count;
+			size_t first;
+		};
+
+		/*
+			A Checkpoint records a successful filter: the segments that were viable just before
+			it, the files that it wrote, the number of ranks that it removed, and the amount by
+			which it lowered the count of each variable.
+		*/
+		struct Checkpoint {
+			std::vector<Segment> segments;
+			std::vector<std::filesystem::path> written;
+			size_t removed;
+			std::vector<long long> removedCounts;
+		};
+
+		int categories;
+		int itemsPer;
+		size_t width;
+		size_t segmentRanks;
+		std::filesystem::path directory;
+		std::vector<Segment> segments;
+		size_t live;
+		size_t nextFile;
+		std::vector<Checkpoint> history;
+
+		// [Segment Reader]
+		// EFFECTS:  returns the encoded ranks of <segment>, which are empty if <segment> has no
+		//   file; throws a runtime_error if the file cannot be read
+		std::vector<unsigned char> load(const Segment& segment) const;
+
+		// [Segment Writer]
+		// MODIFIES: <this>, disk
+		// EFFECTS:  writes <bytes> to a new file in <directory> and returns its path; throws a
+		//   runtime_error if the file cannot be written
+		std::filesystem::path store(const std::vector<unsigned char>& bytes);
+
+		// [Rank Accessor]
+		// REQUIRES: <bytes> are the encoded ranks of <segment>, <index> is less than <segment.count>
+		// EFFECTS:  returns the <index>th rank of <segment>
+		size_t rankAt(const Segment& segment, const std::vector<unsigned char>& bytes, size_t index) const;
+
+		// [Segment Sifter]
+		// REQUIRES: <bytes> are the encoded ranks of <segment>, <removedCounts> has one element for
+		//   each variable of the Assignments of <this>
+		// MODIFIES: <kept>, <removedCounts>
+		// EFFECTS:  returns the number of ranks of <segment> for which the clue of <memo> evaluates to FALSE and
+		//   adds to each element of <removedCounts> the number of those in which the corresponding
+		//   variable is TRUE; if <kept> is not null, also appends to it the encoding of each of the
+		//   other ranks, in order
+		size_t sift(const ProjectionMemo& memo, const Segment& segment, const std::vector<unsigned char>& bytes,
+			std::vector<unsigned char>* kept, std::vector<long long>& removedCounts) const;
+
+		// [Segment Scanner]
+		// EFFECTS:  calls <visit> with the index and encoded ranks of each segment of <this> in
+		//   order, reading each segment ahead while the one before it is visited
+		template <typename Visitor>
+		void scan(Visitor visit) const;
+};
+
+#endif
\ No newline at end of file
@@ -52,6 +52,7 @@ void SummaryView::loadVarMap(size_t categories, size_t itemsPerCategory) {
 // constructor
 SummaryView::SummaryView(const string& name, const string& puzzleName, size_t categories, size_t itemsPerCategory)
 	: View{ name, puzzleName }, items(categories, vector<string>(itemsPerCategory, kDefaultItemStr)),
+	joined(variablesNeeded(categories, itemsPerCategory), false), stale{ false },
 	itemsPerCategory{ itemsPerCategory } {
 
 	int nodesNeeded = static_cast<int>(categories * itemsPerCategory);				// each item gets its own Node
@@ -82,8 +83,13 @@ bool hasOnlyOneItem(const vector<string>& vec) {
 	return (count == 1);
 }
 
-// print the table of groups to <eout>
+// print the table of groups to <eout>, forming the groups again first if any
+// of them has lost a member
 void SummaryView::display() const {
+	if (stale) {
+		regroup();
+	}
+
 	// calculate number of categories
 	const size_t categories = disjointSet.size() / itemsPerCategory;
 
@@ -168,7 +174,7 @@ void SummaryView::display() const {
 
 // put the two Nodes with indices <node1Idx> and <node2Idx> into the same group
 // (i.e. make them have the same representative)
-void SummaryView::joinNodes(int node1Idx, int node2Idx) {
+void SummaryView::joinNodes(int node1Idx, int node2Idx) const {
 	auto repr1Idx = findRepr(node1Idx);												// find representatives
 	auto repr2Idx = findRepr(node2Idx);
 
@@ -187,9 +193,37 @@ void SummaryView::joinNodes(int node1Idx, int node2Idx) {
 	}
 }
 
-// remember the new status
+// every item starts in a group of its own, exactly as at construction, and then
+// the two items of each variable still marked "true" are joined
+void SummaryView::regroup() const {
+	int num = static_cast<int>(disjointSet.size());
+	for (int i = 0; i < num; ++i) {
+		disjointSet[i] = Node_t{ i, 0 };
+	}
+
+	int numVars = static_cast<int>(joined.size());
+	for (int v = 0; v < numVars; ++v) {
+		if (joined[v]) {
+			const auto& items = varMap.at(v);
+			int item1Idx = items.item1Cat * itemsPerCategory + items.item1ItemIdx;
+			int item2Idx = items.item2Cat * itemsPerCategory + items.item2ItemIdx;
+			joinNodes(item1Idx, item2Idx);
+		}
+	}
+	stale = false;
+}
+
+// remember the new status; a newly "true" variable joins its two items straight
+// away, unless the groups are going to be formed again anyway, and a variable that
+// is no longer "true" means that they must be
 void SummaryView::recordStatus(int varIndex, VarStatus_e status) {
-	if (status == VarStatus_e::True) {
+	bool wasJoined = joined[varIndex];
+	joined[varIndex] = (status == VarStatus_e::True);
+
+	if (wasJoined && !joined[varIndex]) {
+		stale = true;
+	}
+	else if (!wasJoined && joined[varIndex] && !stale) {
 		auto items = varMap[varIndex];
 		int item1Idx = items.item1Cat * itemsPerCategory + items.item1ItemIdx;
 		int item2Idx = items.item2Cat * itemsPerCategory + items.item2ItemIdx;
@@ -11,8 +11,8 @@ enum class VarStatus_e;
 /*
 	A SummaryView is a type of View that displays data to the user as a table of groups, with each
 	group occupying a single row and each column representing a different category. Groups are formed
-	as items' intersection statuses are reported as "true"; once such as status is thusly reported, it
-	cannot be undone. In other words: it is not possible to break up a group once it has been formed.
+	as items' intersection statuses are reported as "true," and are broken up again if such a status is
+	later reported as anything else, as happens when a clue is undone.
 
 	Groups are formed transitively as items' intersections are marked as "true." For example, if the
 	status of the "ItemA/ItemB" interseciton is marked as "true," then those two items are said to
@@ -21,11 +21,12 @@ enum class VarStatus_e;
 	ItemD would join the group as well, resulting in a group of four items: ItemA, ItemB, ItemC, and
 	ItemD. If an item is not in any group, then it will not be listed at all in the display.
 
-	Because of the way in which groups are formed, it is not possible to "unform" a group. That means
-	that once the intersection of two items is marked as "true," it cannot be unmarked (i.e. marked as
-	"false" or "unknown"). However, because SummaryViews are only concerned with what is a group and
-	not what isn't, an intersection of items marked as "false" or "unknown" can later be marked as
-	"true" without any issue.
+	Because of the way in which groups are formed, a group cannot be "unformed" piece by piece. Instead,
+	the SummaryView remembers which intersections are marked as "true," and once any of them is unmarked
+	(i.e. marked as "false" or "unknown"), the groups are formed again from scratch out of those that are
+	still marked, the next time the SummaryView is displayed. Because SummaryViews are only concerned with
+	what is a group and not what isn't, an intersection of items marked as "false" or "unknown" can later
+	be marked as "true" without any issue.
 
 	When displaying, SummaryViews assume that no two items of the same group are from the same category.
 	If this is the case (because of user error), which item is displayed is not concretely defined.
@@ -49,9 +50,8 @@ class SummaryView : public View {
 	protected:
 		// [Reporting Helpers]
 		// REQUIRES: <varIndex> and <category> are non-negative, <varIndex> is valid based on
-		//   the items that have been already reported, the variable with <varIndex> has not
-		//   already had its status updated, updating the status of <varIndex> does not cause
-		//   a group to have more than one item of a single category
+		//   the items that have been already reported, updating the status of <varIndex> does
+		//   not cause a group to have more than one item of a single category
 		// MODIFIES: <this>
 		// EFFECTS:  remembers the information reported (either a new <status> or an <item>)
 		//   to be printed later
@@ -65,6 +65,8 @@ class SummaryView : public View {
 		std::unordered_map<int, Var_t> varMap;					// maps variable indices to the two items that variable represents
 		std::vector<std::vector<std::string>> items;
 		mutable std::vector<Node_t> disjointSet;				// mutable because might get updated by findRepr() via "path compression"
+		std::vector<bool> joined;								// TRUE for each variable last reported as "true"
+		mutable bool stale;										// TRUE if <disjointSet> still joins a variable no longer in <joined>
 		size_t itemsPerCategory;
 
 		// REQUIRES: <varMap> is empty, both <categories> and <itemsPerCategory> are at least 2
@@ -85,7 +87,12 @@ class SummaryView : public View {
 		// EFFECTS:  updates the representative indices of <node1Idx> and <node2Idx>, as well
 		//   as all the Nodes in their groups, to be the same, deciding on the new representative
 		//   by weighing the ranks
-		void joinNodes(int node1Idx, int node2Idx);
+		void joinNodes(int node1Idx, int node2Idx) const;
+
+		// MODIFIES: elements of <disjointSet>, <stale>
+		// EFFECTS:  puts every Node of <disjointSet> back into a group of its own, then joins the
+		//   two items of each variable in <joined>
+		void regroup() const;
 };
 
 #endif
\ No newline at end of file
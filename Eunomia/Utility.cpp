@@ -14,6 +14,12 @@ const char kImpliesSymbol = '>';
 const char kXorSymbol = '^';
 const char kIffSymbol = '=';
 
+const size_t kStreamMemoryCap = size_t{ 64 } << 20;				// 64 MiB
+
+const PuzzleId_t kNoPuzzle = 0;									// the Model numbers open Puzzles from 1
+
+const size_t kUncounted = static_cast<size_t>(-1);				// no count of possible solutions is this large
+
 
 // return the number of variables needed to fully represent a logic puzzle with
 // the given dimensions
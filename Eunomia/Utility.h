@@ -4,12 +4,52 @@
 #include <exception>											// for exception
 #include <iosfwd>												// for istream
 #include <string>												// for string, because aliasing this is hard
+#include <vector>												// for vector
 
 
 enum class Operator_e { And, Or, Implies, Xor, Iff };
 
 enum class VarStatus_e { False, True, Unknown };
 
+enum class Storage_e { Dense, Sliced, Ranked, Streamed };
+
+using PuzzleId_t = size_t;
+
+/*
+	A StatusReport pairs the index of a variable with its status, so that the statuses of many
+	variables can be reported together.
+*/
+struct StatusReport {
+	int varIndex;
+	VarStatus_e status;
+};
+
+/*
+	A ProbeResult describes what evaluating a single hypothetical clue would do without doing it: whether
+	the clue would be consistent, how many possible solutions would survive it (or <kUncounted> if they are
+	not enumerated), and the new status of each variable whose status it would change. An inconsistent
+	clue changes nothing, so it reports no survivors and no changes.
+*/
+struct ProbeResult {
+	bool consistent;
+	size_t survivors;
+	std::vector<StatusReport> changes;
+};
+
+/*
+	An ExpressionNode is one node of an Expression laid out flat, as a list in which each operator comes
+	after both of its operands: either a variable, possibly negated, or a Boolean operator, possibly
+	negated, joining the two nodes at the given indices of the list.
+*/
+struct ExpressionNode {
+	bool isVariable;
+	bool negated;
+	int varIndex;												// meaningful only for a variable
+	Operator_e op;												// meaningful only for an operator
+	size_t left;												// meaningful only for an operator
+	size_t right;												// meaningful only for an operator
+};
+
 extern const char kNotSymbol;
 extern const char kAndSymbol;
 extern const char kOrSymbol;
@@ -17,6 +57,12 @@ extern const char kImpliesSymbol;
 extern const char kXorSymbol;
 extern const char kIffSymbol;
 
+extern const size_t kStreamMemoryCap;
+
+extern const PuzzleId_t kNoPuzzle;
+
+extern const size_t kUncounted;
+
 // REQUIRES: <categories> and <itemsPerCategory> are both at least 2
 // EFFECTS:  returns the number of variables required to fully represent a logic puzzle
 //   that has <categories> Categories of <itemsPerCategory> items each;
@@ -1,13 +1,15 @@
-#include "Utility.h"											// for VarStatus_e
+#include "Utility.h"											// for VarStatus_e, PuzzleId_t, StatusReport, kNoPuzzle
 #include "View.h"												// for View
+#include <span>													// for span
 #include <string>												// for string
 
+using std::span;
 using std::string;
 
 
 // constructor
 View::View(const string& name, const string& puzzleName)
-	: name{ name }, puzzleName{ puzzleName } {}
+	: name{ name }, puzzleName{ puzzleName }, subscription{ kNoPuzzle } {}
 
 // destructor
 View::~View() {}
@@ -38,8 +40,42 @@ void View::reportItem(const string& puzzle, int category, int item, const string
 	recordItem(category, item, itemStr);
 }
 
+// remember the Puzzle id
+void View::subscribe(PuzzleId_t puzzle) {
+	subscription = puzzle;
+}
+
+// return the Puzzle id that <this> is subscribed to
+PuzzleId_t View::getSubscription() const {
+	return subscription;
+}
+
+// if <puzzle> matches <subscription>, forward the whole batch to the protected helper;
+// else, ignore
+void View::reportStatuses(PuzzleId_t puzzle, span<const StatusReport> reports) {
+	if (puzzle != subscription) {
+		return;
+	}
+	recordStatuses(reports);
+}
+
+// if <puzzle> matches <subscription>, forward to protected helper; else, ignore
+void View::reportItem(PuzzleId_t puzzle, int category, int item, const string& itemStr) {
+	if (puzzle != subscription) {
+		return;
+	}
+	recordItem(category, item, itemStr);
+}
+
 // by default, ignore the information (derived classes can override)
 void View::recordStatus(int, VarStatus_e) {}
 
 // by default, ignore the information (derived classes can override)
-void View::recordItem(int, int, const string&) {}
\ No newline at end of file
+void View::recordItem(int, int, const string&) {}
+
+// by default, record the statuses one at a time (derived classes can override)
+void View::recordStatuses(span<const StatusReport> reports) {
+	for (const auto& report : reports) {
+		recordStatus(report.varIndex, report.status);
+	}
+}
\ No newline at end of file
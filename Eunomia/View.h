@@ -1,9 +1,9 @@
 #ifndef EUNOMIA_VIEW
 #define EUNOMIA_VIEW
 
+#include <span>													// for span
 #include <string>												// for string
-
-enum class VarStatus_e;
+#include "Utility.h"											// for VarStatus_e, PuzzleId_t, StatusReport
 
 /*
 	A View is an abstract interface for displaying data to the user via the console in a specific way.
@@ -16,6 +16,12 @@ enum class VarStatus_e;
 	default, all View's ignore both pieces of information, but derived classes can (and should) implement
 	custom handlers for remembering them. (The handlers are conveniently provided as virtual functions).
 
+	Information can also be reported by the compact id that the Model gives each open Puzzle, in which
+	case a View attends only to the id to which it has been subscribed; the Model subscribes each View to
+	the id of the Puzzle whose name it was constructed with. Comparing ids rather than names makes this
+	the cheap path, and it also takes the statuses of many variables at once, as a span of StatusReports.
+	Derived classes that can handle such a batch better than one status at a time can override its handler.
+
 	When a View displays, it prints the information that it has remembered to the standard output
 	stream in a way defined by the specific derived class.
 */
@@ -46,6 +52,22 @@ class View {
 		void reportStatus(const std::string& puzzle, int varIndex, VarStatus_e status);
 		void reportItem(const std::string& puzzle, int category, int item, const std::string& itemStr);
 
+		// [Subscription Accessors]
+		// MODIFIES: <this>
+		// EFFECTS:  subscribes <this> to the Puzzle id <puzzle>, or returns the Puzzle id to
+		//   which <this> is subscribed, which is <kNoPuzzle> until <subscribe()> is called
+		void subscribe(PuzzleId_t puzzle);
+		PuzzleId_t getSubscription() const;
+
+		// [Subscribed Reporting Interface]
+		// REQUIRES: the same as for the Reporting Interface, for each of <reports>
+		// MODIFIES: <this>
+		// EFFECTS:  if <puzzle> is the Puzzle id to which <this> is subscribed, handles each of
+		//   <reports> (in order) or the <item> exactly as the Reporting Interface would have for
+		//   the matching Puzzle name; otherwise, the information is ignored
+		void reportStatuses(PuzzleId_t puzzle, std::span<const StatusReport> reports);
+		void reportItem(PuzzleId_t puzzle, int category, int item, const std::string& itemStr);
+
 		// [Printer]
 		// MODIFIES: standard output
 		// EFFECTS:  prints <this> to the standard output stream based on the manner of the
@@ -62,9 +84,17 @@ class View {
 		virtual void recordStatus(int varIndex, VarStatus_e status);
 		virtual void recordItem(int category, int item, const std::string& itemStr);
 
+		// [Batched Reporting Helper]
+		// REQUIRES: the same as for <recordStatus()>, for each of <reports>
+		// MODIFIES: <this>
+		// EFFECTS:  the same as calling <recordStatus()> with each of <reports> in order, which
+		//   is exactly what it does by default
+		virtual void recordStatuses(std::span<const StatusReport> reports);
+
 	private:
 		std::string name;
 		std::string puzzleName;
+		PuzzleId_t subscription;
 };
 
 #endif
\ No newline at end of file
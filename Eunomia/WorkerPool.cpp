@@ -0,0 +1,138 @@
+#include "WorkerPool.h"											// for WorkerPool
+#include <algorithm>											// for max, min
+#include <atomic>												// for atomic
+#include <condition_variable>									// for condition_variable
+#include <exception>											// for exception_ptr, current_exception, rethrow_exception
+#include <functional>											// for function
+#include <mutex>												// for mutex, lock_guard, unique_lock
+#include <thread>												// for thread
+#include <vector>												// for vector
+
+using std::max; using std::min;
+using std::exception_ptr; using std::current_exception; using std::rethrow_exception;
+using std::function;
+using std::mutex; using std::lock_guard; using std::unique_lock;
+using std::thread;
+
+// TRUE on a thread while it is running a task, so that nested batches run inline
+thread_local bool inTask = false;
+
+
+// constructor; the thread that starts a batch always helps, so it needs no worker of its own
+WorkerPool::WorkerPool()
+	: job{ nullptr }, jobSize{ 0 }, nextTask{ 0 }, generation{ 0 }, pendingWorkers{ 0 },
+	failure{ nullptr }, stopping{ false } {
+
+	size_t hardware = max(thread::hardware_concurrency(), 1u);
+	workers.reserve(hardware - 1);
+	for (size_t i = 1; i < hardware; ++i) {
+		workers.emplace_back(&WorkerPool::work, this);
+	}
+}
+
+// return function-static Singleton instance
+WorkerPool& WorkerPool::getInstance() {
+	static WorkerPool pool{};
+	return pool;
+}
+
+// tell every worker to stop, then wait for them
+WorkerPool::~WorkerPool() {
+	{
+		lock_guard<mutex> lock{ stateGuard };
+		stopping = true;
+	}
+	wake.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+// the workers plus the starting thread
+size_t WorkerPool::threadCount() const {
+	return workers.size() + 1;
+}
+
+// no more than four tasks per thread, and no task smaller than <grain> unless there is
+// only one task anyway
+size_t WorkerPool::tasksFor(size_t items, size_t grain) const {
+	size_t byGrain = (items + grain - 1) / grain;
+	return max(size_t{ 1 }, min(byGrain, 4 * threadCount()));
+}
+
+// publish the batch, help run it, then wait for every worker to check back in; tiny or
+// nested batches are not worth (or not safe) handing out
+void WorkerPool::run(size_t tasks, const function<void(size_t)>& task) {
+	if (tasks <= 1 || inTask || workers.empty()) {
+		for (size_t i = 0; i < tasks; ++i) {
+			task(i);
+		}
+		return;
+	}
+
+	lock_guard<mutex> batch{ batchGuard };
+	{
+		lock_guard<mutex> lock{ stateGuard };
+		job = &task;
+		jobSize = tasks;
+		nextTask = 0;
+		failure = nullptr;
+		pendingWorkers = workers.size();
+		++generation;
+	}
+	wake.notify_all();
+
+	drain();
+
+	exception_ptr thrown;
+	{
+		unique_lock<mutex> lock{ stateGuard };
+		finished.wait(lock, [this]() { return pendingWorkers == 0; });
+		job = nullptr;
+		thrown = failure;
+	}
+	if (thrown) {
+		rethrow_exception(thrown);
+	}
+}
+
+// sleep until the generation changes, then join in
+void WorkerPool::work() {
+	size_t seen = 0;
+	while (true) {
+		{
+			unique_lock<mutex> lock{ stateGuard };
+			wake.wait(lock, [this, seen]() { return stopping || generation != seen; });
+			if (stopping) {
+				return;
+			}
+			seen = generation;
+		}
+
+		drain();
+
+		lock_guard<mutex> lock{ stateGuard };
+		if (--pendingWorkers == 0) {
+			finished.notify_one();
+		}
+	}
+}
+
+// claim task numbers until they run out; after a failure, push the counter past the end
+// so that nobody claims anything else
+void WorkerPool::drain() {
+	inTask = true;
+	for (size_t i = nextTask++; i < jobSize; i = nextTask++) {
+		try {
+			(*job)(i);
+		}
+		catch (...) {
+			lock_guard<mutex> lock{ stateGuard };
+			if (!failure) {
+				failure = current_exception();
+			}
+			nextTask = jobSize;
+		}
+	}
+	inTask = false;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef EUNOMIA_WORKER_POOL
+#define EUNOMIA_WORKER_POOL
+
+#include <atomic>												// for atomic
+#include <condition_variable>									// for condition_variable
+#include <exception>											// for exception_ptr
+#include <functional>											// for function
+#include <mutex>												// for mutex
+#include <thread>												// for thread
+#include <vector>												// for vector
+
+/*
+	The WorkerPool is a Singleton class that owns a fixed set of worker threads, one fewer than the number
+	of hardware threads, for the lifetime of the process. It runs batches of independent tasks numbered 0
+	through one less than the size of the batch. Each task is claimed and run by exactly one thread, the
+	thread that started the batch included, and starting a batch returns only once every one of its tasks
+	has finished. Tasks are claimed in increasing order, so handing out more tasks than there are threads
+	balances uneven work.
+
+	If a task throws, the tasks that have not yet been claimed are skipped, and the first exception thrown
+	is rethrown to the thread that started the batch once the batch has finished. Batches started by
+	different threads at once run one after the other. A batch started from within a task of another batch
+	is run entirely on the thread that started it, so tasks are free to call code that uses the WorkerPool.
+*/
+
+class WorkerPool {
+	public:
+		// [Singleton Accessor]
+		// EFFECTS:  returns a reference to the Singleton instance of the WorkerPool class,
+		//   starting its worker threads the first time that it is called
+		static WorkerPool& getInstance();
+
+		// [Destructor]
+		// EFFECTS:  stops and joins every worker thread
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool& other) = delete;
+		WorkerPool& operator=(const WorkerPool& other) = delete;
+
+		// [Size Accessor]
+		// EFFECTS:  returns the number of threads that run the tasks of a batch, counting the
+		//   thread that starts the batch
+		size_t threadCount() const;
+
+		// [Batch Sizer]
+		// REQUIRES: <grain> is positive
+		// EFFECTS:  returns the number of tasks into which work on <items> items is best split so
+		//   that each task has at least about <grain> items and every thread has a few tasks to
+		//   claim; the result is at least 1
+		size_t tasksFor(size_t items, size_t grain) const;
+
+		// [Batch Runner]
+		// MODIFIES: whatever <task> modifies
+		// EFFECTS:  calls <task> once with each number from 0 through <tasks> - 1, spread over the
+		//   threads of <this>, and returns once every call has returned; rethrows the first
+		//   exception thrown by any call, in which case some numbers may never have been passed
+		void run(size_t tasks, const std::function<void(size_t)>& task);
+
+	private:
+		std::vector<std::thread> workers;
+		std::mutex batchGuard;
+		std::mutex stateGuard;
+		std::condition_variable wake;
+		std::condition_variable finished;
+
+		const std::function<void(size_t)>* job;
+		size_t jobSize;
+		std::atomic<size_t> nextTask;
+		size_t generation;
+		size_t pendingWorkers;
+		std::exception_ptr failure;
+		bool stopping;
+
+		// [Constructor]
+		WorkerPool();
+
+		// MODIFIES: <this>
+		// EFFECTS:  waits for each new batch and helps to run it until <this> is destroyed
+		void work();
+
+		// MODIFIES: <this>, whatever the current job modifies
+		// EFFECTS:  claims and runs tasks of the current batch until there are none left
+		void drain();
+};
+
+#endif
\ No newline at end of file